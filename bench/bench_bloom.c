@@ -0,0 +1,56 @@
+#include <silk/bloom.h>
+#include <silk/memory.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_KEYS          10000000
+#define BENCH_BITS_PER_KEY  10
+
+/*******************************************************
+ * @brief get the nanoseconds per key since begin
+ * @param begin clock of begin
+ * @return nanoseconds per key
+ *******************************************************/
+static double bench_ns(clock_t begin)
+{
+    double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    return seconds / BENCH_KEYS * 1e9;
+}
+
+int main(void)
+{
+    // the first half is added, the second half is queried to count false positives
+    uint64_t* keys = silk_alloc(sizeof(uint64_t) * BENCH_KEYS * 2);
+    if (keys == NULL)
+        return 1;
+    for (size_t i = 0; i < (size_t)BENCH_KEYS * 2; i++)
+        keys[i] = i * 0x9E3779B97F4A7C15ull + 7;
+
+    silk_bloom_t bloom = silk_bloom_new(BENCH_KEYS, BENCH_BITS_PER_KEY);
+    if (bloom == NULL)
+    {
+        silk_free(keys);
+        return 1;
+    }
+
+    printf("%d keys, %d bits per key\n", BENCH_KEYS, BENCH_BITS_PER_KEY);
+
+    clock_t begin = clock();
+    silk_bloom_add_bulk(bloom, keys, sizeof(uint64_t), BENCH_KEYS);
+    printf("add bulk       %8.1f ns/key\n", bench_ns(begin));
+
+    size_t found = 0;
+    begin = clock();
+    for (size_t i = 0; i < BENCH_KEYS; i++)
+        found += silk_bloom_contains(bloom, &keys[BENCH_KEYS + i], sizeof(uint64_t));
+    printf("contains       %8.1f ns/key  false positives %.2f%%\n", bench_ns(begin), 100.0 * found / BENCH_KEYS);
+
+    begin = clock();
+    found = silk_bloom_contains_bulk(bloom, keys + BENCH_KEYS, sizeof(uint64_t), BENCH_KEYS, NULL);
+    printf("contains bulk  %8.1f ns/key  false positives %.2f%%\n", bench_ns(begin), 100.0 * found / BENCH_KEYS);
+
+    silk_bloom_delete(bloom);
+    silk_free(keys);
+    return 0;
+}
\ No newline at end of file
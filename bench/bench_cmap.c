@@ -0,0 +1,141 @@
+#include <silk/cmap.h>
+
+#include <stdio.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <time.h>
+#endif
+
+#define BENCH_KEYS          (1 << 20)
+#define BENCH_OPERATIONS    (1 << 22)
+#define BENCH_MAX_THREADS   64
+
+struct BenchTask
+{
+    silk_cmap_t cmap;
+    uint64_t seed;
+    size_t operations;
+    uint64_t found;
+};
+
+/*******************************************************
+ * @brief get the wall time
+ * @return the time in seconds
+ *******************************************************/
+static double bench_now(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+/*******************************************************
+ * @brief work of each thread, 90% get and 10% put of
+ *        random keys
+ * @param task the task
+ *******************************************************/
+static void bench_work(struct BenchTask* task)
+{
+    uint64_t x = task->seed;
+    for (size_t i = 0; i < task->operations; i++)
+    {
+        // xorshift
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        uint64_t key = x % BENCH_KEYS;
+        uint64_t value = i;
+        if (x % 10 == 0)
+            silk_cmap_put(task->cmap, &key, &value);
+        else
+            task->found += silk_cmap_get(task->cmap, &key, &value);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI bench_thread(LPVOID data)
+{
+    bench_work(data);
+    return 0;
+}
+#else
+static void* bench_thread(void* data)
+{
+    bench_work(data);
+    return NULL;
+}
+#endif
+
+/*******************************************************
+ * @brief run the operations by threads
+ * @param cmap the map
+ * @param count count of threads
+ * @return the rate of operations, in millions per second
+ *******************************************************/
+static double bench_run(silk_cmap_t cmap, size_t count)
+{
+    struct BenchTask tasks[BENCH_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE threads[BENCH_MAX_THREADS];
+#else
+    pthread_t threads[BENCH_MAX_THREADS];
+#endif
+
+    double begin = bench_now();
+    for (size_t i = 0; i < count; i++)
+    {
+        tasks[i].cmap = cmap;
+        tasks[i].seed = 0x9e3779b97f4a7c15ull * (i + 1);
+        tasks[i].operations = BENCH_OPERATIONS / count;
+        tasks[i].found = 0;
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, bench_thread, &tasks[i], 0, NULL);
+#else
+        pthread_create(&threads[i], NULL, bench_thread, &tasks[i]);
+#endif
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+    return BENCH_OPERATIONS / (bench_now() - begin) / 1e6;
+}
+
+int main(void)
+{
+    // a single shard is the same as a global lock
+    silk_cmap_t global = silk_cmap_new(sizeof(uint64_t), sizeof(uint64_t), 1);
+    silk_cmap_t sharded = silk_cmap_new(sizeof(uint64_t), sizeof(uint64_t), 0);
+    if (global == NULL || sharded == NULL)
+        return 1;
+
+    for (uint64_t key = 0; key < BENCH_KEYS; key += 2)
+    {
+        silk_cmap_put(global, &key, &key);
+        silk_cmap_put(sharded, &key, &key);
+    }
+
+    printf("%d keys, %d operations, 90%% get and 10%% put\n", BENCH_KEYS, BENCH_OPERATIONS);
+    printf("threads  global lock (M ops/s)  64 shards (M ops/s)\n");
+    for (size_t count = 1; count <= BENCH_MAX_THREADS; count *= 2)
+        printf("%7zu  %22.2f  %19.2f\n", count, bench_run(global, count), bench_run(sharded, count));
+
+    silk_cmap_delete(sharded);
+    silk_cmap_delete(global);
+    return 0;
+}
\ No newline at end of file
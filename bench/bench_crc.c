@@ -0,0 +1,40 @@
+#include <silk/cpu.h>
+#include <silk/crc.h>
+#include <silk/memory.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_SIZE      (1 << 24)
+#define BENCH_ROUNDS    20
+
+int main(void)
+{
+    uint8_t* data = silk_alloc(BENCH_SIZE);
+    if (data == NULL)
+        return 1;
+    for (size_t i = 0; i < BENCH_SIZE; i++)
+        data[i] = (uint8_t)(i * 7);
+
+    printf("%d bytes, %d rounds\n", BENCH_SIZE, BENCH_ROUNDS);
+
+    // each path is forced by limiting the features, those not supported by the cpu fall back
+    const char* names[] = {"tables", "sse4.2", "sse4.2+pclmul"};
+    uint32_t features[] = {0, SILK_CPU_SSE42, SILK_CPU_SSE42 | SILK_CPU_PCLMUL};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+
+        uint32_t crc = 0;
+        clock_t begin = clock();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            crc = silk_crc32c(data, BENCH_SIZE, crc);
+        double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+        printf("%-14s %8.2f GB/s  (crc %08x)\n", names[f], (double)BENCH_SIZE * BENCH_ROUNDS / seconds / 1e9, crc);
+
+        silk_cpu_set_features(old);
+    }
+
+    silk_free(data);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <silk/cpu.h>
+#include <silk/hash.h>
+#include <silk/memory.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_KEYS      (1 << 20)
+#define BENCH_ROUNDS    20
+#define BENCH_MAX_LEN   16
+
+int main(void)
+{
+    uint8_t* keys = silk_alloc((size_t)BENCH_KEYS * BENCH_MAX_LEN);
+    uint32_t* out = silk_alloc(sizeof(uint32_t) * BENCH_KEYS);
+    if (keys == NULL || out == NULL)
+        return 1;
+    for (size_t i = 0; i < (size_t)BENCH_KEYS * BENCH_MAX_LEN; i++)
+        keys[i] = (uint8_t)(i * 7);
+
+    printf("%d keys, %d rounds\n", BENCH_KEYS, BENCH_ROUNDS);
+
+    // each path is forced by limiting the features, those not supported by the cpu fall back
+    const char* names[] = {"scalar", "sse4.1", "avx2"};
+    uint32_t features[] = {0, SILK_CPU_SSE2 | SILK_CPU_SSE41, UINT32_MAX};
+    size_t lens[] = {4, 8, 16};
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++)
+    {
+        for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+        {
+            uint32_t old = silk_cpu_set_features(features[f]);
+
+            uint32_t sum = 0;
+            clock_t begin = clock();
+            for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+            {
+                silk_hash_murmur3_32_batch(keys, lens[l], BENCH_KEYS, r, out);
+                sum += out[r];
+            }
+            double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            printf("%2zu bytes %-8s %8.1f M keys/s  (checksum %08x)\n", lens[l], names[f], (double)BENCH_KEYS * BENCH_ROUNDS / seconds / 1e6, sum);
+
+            silk_cpu_set_features(old);
+        }
+    }
+
+    silk_free(out);
+    silk_free(keys);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <silk/hash.h>
+#include <silk/hashring.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_SHARDS    1000
+#define BENCH_REPLICAS  160
+#define BENCH_LOOKUPS   10000000
+
+/*******************************************************
+ * @brief print the rate of lookups
+ * @param name name of the method
+ * @param begin clock of begin
+ * @param sum sum of shards, keeps lookups from being
+ *            optimized away
+ *******************************************************/
+static void bench_report(const char* name, clock_t begin, uint64_t sum)
+{
+    double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    printf("%-10s %8.2f M lookups/s  (checksum %llu)\n", name, BENCH_LOOKUPS / seconds / 1e6, (unsigned long long)sum);
+}
+
+int main(void)
+{
+    silk_hashring_t ring = silk_hashring_new(BENCH_REPLICAS);
+    if (ring == NULL)
+        return 1;
+    for (uint32_t shard = 0; shard < BENCH_SHARDS; shard++)
+        silk_hashring_add(ring, shard);
+
+    printf("%d shards, %d lookups\n", BENCH_SHARDS, BENCH_LOOKUPS);
+
+    // the baseline, which remaps almost all keys when shards changes
+    uint64_t sum = 0;
+    clock_t begin = clock();
+    for (uint32_t k = 0; k < BENCH_LOOKUPS; k++)
+        sum += silk_hash_murmur3_32(&k, sizeof(k), 0) % BENCH_SHARDS;
+    bench_report("modulo", begin, sum);
+
+    sum = 0;
+    begin = clock();
+    for (uint32_t k = 0; k < BENCH_LOOKUPS; k++)
+        sum += silk_hashring_get(ring, &k, sizeof(k));
+    bench_report("hashring", begin, sum);
+
+    sum = 0;
+    begin = clock();
+    for (uint64_t k = 0; k < BENCH_LOOKUPS; k++)
+        sum += silk_hash_jump(silk_hash_wyhash(&k, sizeof(k), 0), BENCH_SHARDS);
+    bench_report("jump", begin, sum);
+
+    silk_hashring_delete(ring);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <silk/map.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_LIVE      (1 << 18)
+#define BENCH_CHURN     (1 << 22)
+#define BENCH_LOOKUPS   (1 << 22)
+
+/*******************************************************
+ * @brief get the rate since begin
+ * @param begin clock of begin
+ * @param count count of operations
+ * @return millions of operations per second
+ *******************************************************/
+static double bench_rate(clock_t begin, size_t count)
+{
+    double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    return count / seconds / 1e6;
+}
+
+/*******************************************************
+ * @brief run the churn and lookups with an engine
+ * @note  it keeps a sliding window of live keys, each
+ *        step inserts a new key and erases the oldest, so
+ *        inserts and erases are 1:1
+ * @param name name of the engine
+ * @param engine the engine
+ *******************************************************/
+static void bench_engine(const char* name, int engine)
+{
+    silk_map_t map = silk_map_new_engine(sizeof(uint64_t), sizeof(uint64_t), engine);
+    if (map == NULL)
+        return;
+
+    uint64_t key;
+    for (key = 0; key < BENCH_LIVE; key++)
+        silk_map_put(map, &key, &key);
+
+    clock_t begin = clock();
+    for (uint64_t i = 0; i < BENCH_CHURN; i++, key++)
+    {
+        uint64_t old = key - BENCH_LIVE;
+        silk_map_erase(map, &old);
+        silk_map_put(map, &key, &key);
+    }
+    double churn = bench_rate(begin, BENCH_CHURN);
+
+    // hit the live keys, and miss the erased ones
+    uint64_t sum = 0;
+    begin = clock();
+    for (uint64_t i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        uint64_t k = key - 1 - i % BENCH_LIVE;
+        sum += silk_map_get(map, &k, NULL);
+    }
+    double hit = bench_rate(begin, BENCH_LOOKUPS);
+
+    begin = clock();
+    for (uint64_t i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        uint64_t k = key - BENCH_LIVE - 1 - i % BENCH_CHURN;
+        sum += silk_map_get(map, &k, NULL);
+    }
+    double miss = bench_rate(begin, BENCH_LOOKUPS);
+
+    silk_map_probe_stats_t stats;
+    silk_map_probe_stats(map, &stats);
+    printf("%-11s %8.2f %8.2f %8.2f %10.2f %10.2f %6zu  (checksum %llu)\n",
+           name, churn, hit, miss, stats.hit, stats.miss, stats.max, (unsigned long long)sum);
+
+    silk_map_delete(map);
+}
+
+int main(void)
+{
+    printf("%d live keys, %d churn steps, %d lookups\n", BENCH_LIVE, BENCH_CHURN, BENCH_LOOKUPS);
+    printf("%-11s %8s %8s %8s %10s %10s %6s\n", "engine", "churn/s", "hit/s", "miss/s", "probe hit", "probe miss", "max");
+    printf("%-11s %8s %8s %8s\n", "", "(M)", "(M)", "(M)");
+
+    bench_engine("linear", SILK_MAP_ENGINE_LINEAR);
+    bench_engine("robin hood", SILK_MAP_ENGINE_ROBIN_HOOD);
+    return 0;
+}
\ No newline at end of file
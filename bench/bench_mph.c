@@ -0,0 +1,84 @@
+#include <silk/mph.h>
+#include <silk/memory.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_MAX_KEYS  10000000
+#define BENCH_LOOKUPS   10000000
+
+/*******************************************************
+ * @brief get the seconds since begin
+ * @param begin clock of begin
+ * @return seconds
+ *******************************************************/
+static double bench_seconds(clock_t begin)
+{
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+/*******************************************************
+ * @brief build a minimal perfect hash of count keys and
+ *        print its size, build time and lookup time
+ * @param values values of the keys
+ * @param keys buffer of keys
+ * @param count count of keys
+ * @return whether it succeeds
+ *******************************************************/
+static bool bench_mph(const uint64_t* values, silk_mph_key_t* keys, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        keys[i].data = &values[i];
+        keys[i].len = sizeof(uint64_t);
+    }
+
+    clock_t begin = clock();
+    silk_mph_t mph = silk_mph_build(keys, count);
+    double build = bench_seconds(begin);
+    if (mph == NULL)
+        return false;
+
+    // walk the keys with a stride so the lookups are not sequential
+    size_t misses = 0;
+    size_t index = 0;
+    begin = clock();
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        misses += silk_mph_get(mph, &values[index], sizeof(uint64_t)) >= count;
+        index += 7919;
+        if (index >= count)
+            index %= count;
+    }
+    double lookup = bench_seconds(begin) / BENCH_LOOKUPS * 1e9;
+
+    double bits = (double)silk_mph_serialized_size(mph) * 8 / count;
+    printf("%10zu  %8.2f  %9.3f  %9.1f\n", count, bits, build, lookup);
+
+    silk_mph_delete(mph);
+    return misses == 0;
+}
+
+int main(void)
+{
+    uint64_t* values = silk_alloc(sizeof(uint64_t) * BENCH_MAX_KEYS);
+    silk_mph_key_t* keys = silk_alloc(sizeof(silk_mph_key_t) * BENCH_MAX_KEYS);
+    if (values == NULL || keys == NULL)
+    {
+        silk_free(values);
+        silk_free(keys);
+        return 1;
+    }
+    for (size_t i = 0; i < BENCH_MAX_KEYS; i++)
+        values[i] = i * 0x9E3779B97F4A7C15ull + 7;
+
+    printf("      keys  bits/key  build (s)  get (ns)\n");
+    const size_t counts[] = {1000, 1000000, BENCH_MAX_KEYS};
+    bool ok = true;
+    for (size_t i = 0; ok && i < sizeof(counts) / sizeof(counts[0]); i++)
+        ok = bench_mph(values, keys, counts[i]);
+
+    silk_free(values);
+    silk_free(keys);
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef SILK_BLOOM_H
+#define SILK_BLOOM_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkBloom* silk_bloom_t;
+
+/*******************************************************
+ * @brief create a blocked bloom filter
+ * @note  all bits of a key are in one 64-byte block, so
+ *        a query touches one cache line, the bits are
+ *        derived from one wyhash value by double hashing,
+ *        10 bits per key gives about 1% false positives
+ * @param capacity the expected count of keys
+ * @param bits_per_key bits of memory for each key
+ * @return the bloom filter
+ *******************************************************/
+silk_bloom_t silk_bloom_new(size_t capacity, size_t bits_per_key);
+
+/*******************************************************
+ * @brief delete a bloom filter
+ * @param bloom the bloom filter to be deleted
+ *******************************************************/
+void silk_bloom_delete(silk_bloom_t bloom);
+
+/*******************************************************
+ * @brief clear a bloom filter
+ * @param bloom the bloom filter to be cleared
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_clear(silk_bloom_t bloom);
+
+/*******************************************************
+ * @brief add a key into a bloom filter
+ * @param bloom the bloom filter
+ * @param data the key
+ * @param len length of the key
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_add(silk_bloom_t bloom, const void* data, size_t len);
+
+/*******************************************************
+ * @brief determine whether a key may be in a bloom filter
+ * @param bloom the bloom filter
+ * @param data the key
+ * @param len length of the key
+ * @return false if the key is surely not added,
+ *         true if it is probably added
+ *******************************************************/
+bool silk_bloom_contains(silk_bloom_t bloom, const void* data, size_t len);
+
+/*******************************************************
+ * @brief add many keys with the same length into a bloom
+ *        filter, blocks are prefetched ahead
+ * @param bloom the bloom filter
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_add_bulk(silk_bloom_t bloom, const void* keys, size_t key_len, size_t count);
+
+/*******************************************************
+ * @brief query many keys with the same length in a bloom
+ *        filter, blocks are prefetched ahead
+ * @param bloom the bloom filter
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @param results return whether each key may be in the
+ *                filter, could be NULL
+ * @return count of the keys which may be in the filter
+ *******************************************************/
+size_t silk_bloom_contains_bulk(silk_bloom_t bloom, const void* keys, size_t key_len, size_t count, bool* results);
+
+/*******************************************************
+ * @brief get the size of a serialized bloom filter
+ * @param bloom the bloom filter
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_bloom_serialized_size(silk_bloom_t bloom);
+
+/*******************************************************
+ * @brief serialize a bloom filter, all values are little
+ *        endian, the blocks start at offset 64
+ * @param bloom the bloom filter
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_bloom_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_bloom_serialize(silk_bloom_t bloom, void* buffer, size_t size);
+
+/*******************************************************
+ * @brief create a bloom filter from serialized data, the
+ *        data is copied
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the bloom filter, or NULL if data is invalid
+ *******************************************************/
+silk_bloom_t silk_bloom_deserialize(const void* data, size_t size);
+
+/*******************************************************
+ * @brief create a read-only bloom filter on serialized
+ *        data, such as a mmap'd file, the blocks are used
+ *        in place on little endian cpus if data is 8
+ *        bytes aligned, otherwise they are copied
+ * @note  data must be kept until the filter is deleted
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the bloom filter, or NULL if data is invalid
+ *******************************************************/
+silk_bloom_t silk_bloom_view(const void* data, size_t size);
+
+#endif // SILK_BLOOM_H
\ No newline at end of file
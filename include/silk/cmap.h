@@ -0,0 +1,106 @@
+#ifndef SILK_CMAP_H
+#define SILK_CMAP_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkCmap* silk_cmap_t;
+
+/*******************************************************
+ * @brief callback of silk_cmap_compute_if_absent, it is
+ *        called with the shard locked, so it must not
+ *        access the same map
+ * @param key the key
+ * @param value return the value to be inserted
+ * @param data the data passed to silk_cmap_compute_if_absent
+ * @return whether to insert the value
+ *******************************************************/
+typedef bool (*silk_cmap_compute_t)(const void* key, void* value, void* data);
+
+/*******************************************************
+ * @brief create a concurrent hash map, which could be
+ *        accessed by many threads
+ * @note  keys are distributed into shards by hash, each
+ *        shard is a silk_map_t guarded by a read-write
+ *        lock, so threads accessing different shards do
+ *        not block each other, and readers of the same
+ *        shard do not block each other
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @param shards count of shards, rounded up to power of 2,
+ *               0 to use the default 64, it should be
+ *               several times the count of threads
+ * @return the map
+ *******************************************************/
+silk_cmap_t silk_cmap_new(size_t key_size, size_t value_size, size_t shards);
+
+/*******************************************************
+ * @brief delete a concurrent hash map, no thread may be
+ *        accessing it
+ * @param cmap the map to be deleted
+ *******************************************************/
+void silk_cmap_delete(silk_cmap_t cmap);
+
+/*******************************************************
+ * @brief clear a concurrent hash map, shard by shard
+ * @param cmap the map to be cleared
+ *******************************************************/
+void silk_cmap_clear(silk_cmap_t cmap);
+
+/*******************************************************
+ * @brief get the count of entries of a concurrent hash
+ *        map, shards are counted one by one, so it is not
+ *        a snapshot while other threads are modifying it
+ * @param cmap the map
+ * @return the count of entries
+ *******************************************************/
+size_t silk_cmap_length(silk_cmap_t cmap);
+
+/*******************************************************
+ * @brief insert an entry into a concurrent hash map, the
+ *        value is replaced if the key is already in it
+ * @param cmap the map
+ * @param key the key
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_cmap_put(silk_cmap_t cmap, const void* key, const void* value);
+
+/*******************************************************
+ * @brief get a copy of the value of a key
+ * @param cmap the map
+ * @param key the key
+ * @param value return the value, nullable
+ * @return whether the key is in the map
+ *******************************************************/
+bool silk_cmap_get(silk_cmap_t cmap, const void* key, void* value);
+
+/*******************************************************
+ * @brief remove an entry from a concurrent hash map
+ * @param cmap the map
+ * @param key the key
+ * @return whether it is removed, false if the key is not
+ *         in the map
+ *******************************************************/
+bool silk_cmap_erase(silk_cmap_t cmap, const void* key);
+
+/*******************************************************
+ * @brief get the value of a key, insert the value by
+ *        compute if the key is not in the map, compute is
+ *        called at most once among all threads for a key
+ *        until it is erased
+ * @note  compute is called with the shard of the key
+ *        write locked, it must not access the same map,
+ *        or it deadlocks
+ * @param cmap the map
+ * @param key the key
+ * @param compute the callback to compute the value
+ * @param data the data passed to compute
+ * @param value return the value, either found or
+ *              computed, not nullable
+ * @return whether the key is in the map after all, false
+ *         if compute declines or it fails
+ *******************************************************/
+bool silk_cmap_compute_if_absent(silk_cmap_t cmap, const void* key, silk_cmap_compute_t compute, void* data, void* value);
+
+#endif // SILK_CMAP_H
\ No newline at end of file
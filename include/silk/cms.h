@@ -0,0 +1,87 @@
+#ifndef SILK_CMS_H
+#define SILK_CMS_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkCms* silk_cms_t;
+
+/*******************************************************
+ * @brief a heavy hitter of silk_cms_top
+ *******************************************************/
+typedef struct SilkCmsItem
+{
+    const void* data;       // the key, valid until the sketch is changed
+    size_t len;             // length of the key
+    uint32_t count;         // estimated count of the key
+} silk_cms_item_t;
+
+/*******************************************************
+ * @brief create a count-min sketch
+ * @note  a key is counted in one counter of each row, the
+ *        estimate is the minimum of them, it is never less
+ *        than the real count, and exceeds it by at most
+ *        e / width * total with probability 1 - e^-depth,
+ *        counters saturate at UINT32_MAX
+ *        see: https://en.wikipedia.org/wiki/Count%E2%80%93min_sketch
+ * @param width count of counters of each row, rounded up
+ *              to power of 2
+ * @param depth count of rows, 1 to 16
+ * @param topk count of heavy hitters to be tracked, 0
+ *             to disable, they are scanned linearly so it
+ *             should be small
+ * @return the sketch
+ *******************************************************/
+silk_cms_t silk_cms_new(size_t width, size_t depth, size_t topk);
+
+/*******************************************************
+ * @brief delete a count-min sketch
+ * @param cms the sketch to be deleted
+ *******************************************************/
+void silk_cms_delete(silk_cms_t cms);
+
+/*******************************************************
+ * @brief clear a count-min sketch, and the heavy hitters
+ * @param cms the sketch to be cleared
+ *******************************************************/
+void silk_cms_clear(silk_cms_t cms);
+
+/*******************************************************
+ * @brief add occurrences of a key into a count-min sketch
+ *        by conservative update, only the counters which
+ *        are less than the new estimate are raised
+ * @param cms the sketch
+ * @param data the key
+ * @param len length of the key
+ * @param count count of occurrences
+ * @return the estimated count of the key after adding
+ *******************************************************/
+uint32_t silk_cms_add(silk_cms_t cms, const void* data, size_t len, uint32_t count);
+
+/*******************************************************
+ * @brief estimate the count of a key
+ * @param cms the sketch
+ * @param data the key
+ * @param len length of the key
+ * @return the estimated count, not less than the real one
+ *******************************************************/
+uint32_t silk_cms_estimate(silk_cms_t cms, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the total count of all added occurrences
+ * @param cms the sketch
+ * @return the total count
+ *******************************************************/
+uint64_t silk_cms_total(silk_cms_t cms);
+
+/*******************************************************
+ * @brief get the heavy hitters, the keys with the largest
+ *        estimated counts, sorted by count descending
+ * @param cms the sketch
+ * @param items return the heavy hitters
+ * @param count max count of items
+ * @return count of items returned
+ *******************************************************/
+size_t silk_cms_top(silk_cms_t cms, silk_cms_item_t* items, size_t count);
+
+#endif // SILK_CMS_H
\ No newline at end of file
@@ -0,0 +1,121 @@
+#ifndef SILK_CODEC_H
+#define SILK_CODEC_H
+
+#include "common.h"
+#include "string.h"
+
+/*******************************************************
+ * @brief get length of base64 text of data
+ * @param len length of the data
+ * @return length of the text, with padding
+ *******************************************************/
+size_t silk_base64_encode_length(size_t len);
+
+/*******************************************************
+ * @brief get max length of data decoded from base64 text
+ * @param len length of the text
+ * @return max length of the data
+ *******************************************************/
+size_t silk_base64_decode_length(size_t len);
+
+/*******************************************************
+ * @brief encode data to base64 text, RFC 4648 alphabet
+ *        with padding
+ * @param dst the buffer of text, at least 
+ *            silk_base64_encode_length(len) bytes, no '\0'
+ *            is written
+ * @param src the data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_base64_encode(char* dst, const void* src, size_t len);
+
+/*******************************************************
+ * @brief decode base64 text to data, padding is optional
+ *        and whitespace is not allowed
+ * @param dst the buffer of data, at least 
+ *            silk_base64_decode_length(len) bytes
+ * @param src the text
+ * @param len length of the text
+ * @return length of the data, or SILK_INVALID_INDEX if 
+ *         the text is invalid
+ *******************************************************/
+size_t silk_base64_decode(void* dst, const char* src, size_t len);
+
+/*******************************************************
+ * @brief encode data to base64 text and append it into 
+ *        a string
+ * @param str the string
+ * @param src the data
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_base64_encode_string(silk_string_t str, const void* src, size_t len);
+
+/*******************************************************
+ * @brief decode base64 text and append the data into a
+ *        string, the string is not changed if it fails
+ * @param str the string
+ * @param src the text
+ * @param len length of the text
+ * @return whether it is successful
+ *******************************************************/
+bool silk_base64_decode_string(silk_string_t str, const char* src, size_t len);
+
+/*******************************************************
+ * @brief get length of hex text of data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_hex_encode_length(size_t len);
+
+/*******************************************************
+ * @brief get max length of data decoded from hex text
+ * @param len length of the text
+ * @return max length of the data
+ *******************************************************/
+size_t silk_hex_decode_length(size_t len);
+
+/*******************************************************
+ * @brief encode data to lowercase hex text
+ * @param dst the buffer of text, at least 
+ *            silk_hex_encode_length(len) bytes, no '\0'
+ *            is written
+ * @param src the data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_hex_encode(char* dst, const void* src, size_t len);
+
+/*******************************************************
+ * @brief decode hex text to data, both cases are accepted
+ * @param dst the buffer of data, at least 
+ *            silk_hex_decode_length(len) bytes
+ * @param src the text
+ * @param len length of the text
+ * @return length of the data, or SILK_INVALID_INDEX if 
+ *         the text is invalid
+ *******************************************************/
+size_t silk_hex_decode(void* dst, const char* src, size_t len);
+
+/*******************************************************
+ * @brief encode data to hex text and append it into
+ *        a string
+ * @param str the string
+ * @param src the data
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hex_encode_string(silk_string_t str, const void* src, size_t len);
+
+/*******************************************************
+ * @brief decode hex text and append the data into a
+ *        string, the string is not changed if it fails
+ * @param str the string
+ * @param src the text
+ * @param len length of the text
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hex_decode_string(silk_string_t str, const char* src, size_t len);
+
+#endif // SILK_CODEC_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef SILK_CPU_H
+#define SILK_CPU_H
+
+#include "common.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define SILK_CPU_X86
+#endif
+
+/*******************************************************
+ * @brief enable instruction sets for a single function,
+ *        so it could use intrinsics without compiling
+ *        the whole library with -mavx2 etc
+ * @param FEATURES the instruction sets, like "avx2"
+ *******************************************************/
+#if defined(SILK_CPU_X86) && defined(__GNUC__)
+    #define SILK_TARGET(FEATURES) __attribute__((target(FEATURES)))
+#else
+    #define SILK_TARGET(FEATURES)
+#endif
+
+#define SILK_CPU_SSE2       (1u << 0)
+#define SILK_CPU_SSSE3      (1u << 1)
+#define SILK_CPU_SSE41      (1u << 2)
+#define SILK_CPU_SSE42      (1u << 3)
+#define SILK_CPU_PCLMUL     (1u << 4)
+#define SILK_CPU_AVX2       (1u << 5)
+
+/*******************************************************
+ * @brief get the instruction sets supported by the cpu,
+ *        detected once at the first call
+ * @return the features, bits of SILK_CPU_*
+ *******************************************************/
+uint32_t silk_cpu_features(void);
+
+/*******************************************************
+ * @brief determine whether the cpu supports all features
+ * @param features bits of SILK_CPU_*
+ * @return whether all features are supported
+ *******************************************************/
+bool silk_cpu_supports(uint32_t features);
+
+/*******************************************************
+ * @brief set the instruction sets used by the library
+ * @note  only features detected on the cpu are kept,
+ *        it is used to fall back to slower code paths,
+ *        the features are process-wide and written
+ *        without synchronization, so it is not
+ *        thread-safe, it must not be called while other
+ *        threads use the library
+ * @param features bits of SILK_CPU_*
+ * @return the old features
+ *******************************************************/
+uint32_t silk_cpu_set_features(uint32_t features);
+
+#endif // SILK_CPU_H
\ No newline at end of file
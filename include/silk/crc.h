@@ -0,0 +1,20 @@
+#ifndef SILK_CRC_H
+#define SILK_CRC_H
+
+#include "common.h"
+
+/*******************************************************
+ * @brief calculate the CRC-32C (Castagnoli) checksum,
+ *        it uses the SSE4.2 crc32 instruction if the cpu
+ *        supports it, otherwise slicing-by-8 tables
+ * @note  data could be checksummed piece by piece, pass
+ *        the result of the previous pieces as crc, the
+ *        result is the same as checksumming them at once
+ * @param data the data
+ * @param len length of the data
+ * @param crc the checksum of the previous data, or 0
+ * @return the checksum
+ *******************************************************/
+uint32_t silk_crc32c(const void* data, size_t len, uint32_t crc);
+
+#endif // SILK_CRC_H
\ No newline at end of file
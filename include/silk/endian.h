@@ -1,8 +1,15 @@
 #ifndef SILK_ENDIAN_H
 #define SILK_ENDIAN_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/*******************************************************
+ * @brief determine whether the cpu is little endian
+ * @return whether the cpu is little endian
+ *******************************************************/
+bool silk_endian_is_little(void);
+
 /*******************************************************
  * @brief read little-endian uint16_t value from data
  * @param data the data
@@ -1,14 +1,168 @@
-#ifndef SILK_LIST_H
-#define SILK_LIST_H
+#ifndef SILK_HASH_H
+#define SILK_HASH_H
 
 #include "common.h"
 
+/*******************************************************
+ * @brief state to calculate a hash value incrementally,
+ *        it could be placed on stack, one state is used
+ *        by one hash function from init to final
+ *******************************************************/
+typedef struct SilkHashState
+{
+    uint64_t value[3];      // intermediate hash values
+    size_t length;          // count of bytes fed
+    size_t pending;         // count of bytes not consumed yet
+    uint8_t buffer[64];     // bytes not consumed yet
+} silk_hash_state_t;
+
 /*******************************************************
  * @brief calculate the hash value by MurmurHash
  *        see: https://en.wikipedia.org/wiki/MurmurHash
- * @param element_size the size of an element
- * @return the list
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @return the hash value
  *******************************************************/
 uint32_t silk_hash_murmur3_32(const void* data, size_t len, uint32_t seed);
 
-#endif // SILK_LIST_H
\ No newline at end of file
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of many keys with
+ *        the same length, keys are hashed in parallel in
+ *        SIMD lanes, 8 keys with AVX2 or 4 with SSE4.1,
+ *        the hash values are the same as calculated by
+ *        silk_hash_murmur3_32 one by one
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @param seed seed of hash
+ * @param out return the hash values, count of them
+ *******************************************************/
+void silk_hash_murmur3_32_batch(const void* keys, size_t key_len, size_t count, uint32_t seed, uint32_t* out);
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of one key with
+ *        many seeds, seeds are hashed in parallel in SIMD
+ *        lanes, 8 seeds with AVX2 or 4 with SSE4.1, the
+ *        hash values are the same as calculated by
+ *        silk_hash_murmur3_32 one by one
+ * @param data the data
+ * @param len length of the data
+ * @param seeds the seeds
+ * @param count count of the seeds
+ * @param out return the hash values, count of them
+ *******************************************************/
+void silk_hash_murmur3_32_seeds(const void* data, size_t len, const uint32_t* seeds, size_t count, uint32_t* out);
+
+/*******************************************************
+ * @brief init a state to calculate MurmurHash3 x86_32
+ *        incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_murmur3_32_init(silk_hash_state_t* state, uint32_t seed);
+
+/*******************************************************
+ * @brief feed data into a MurmurHash3 x86_32 state
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_murmur3_32_update(silk_hash_state_t* state, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the hash value of a MurmurHash3 x86_32 state,
+ *        the state is not changed
+ * @param state the state
+ * @return the hash value
+ *******************************************************/
+uint32_t silk_hash_murmur3_32_final(const silk_hash_state_t* state);
+
+/*******************************************************
+ * @brief calculate the 128 bits hash value by MurmurHash3
+ *        x64 variant, same as MurmurHash3_x64_128
+ *        see: https://github.com/aappleby/smhasher
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @param hash return the hash value, the lower 64 bits
+ *             in hash[0] and the upper in hash[1]
+ *******************************************************/
+void silk_hash_murmur3_128(const void* data, size_t len, uint32_t seed, uint64_t hash[2]);
+
+/*******************************************************
+ * @brief init a state to calculate MurmurHash3 x64_128
+ *        incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_murmur3_128_init(silk_hash_state_t* state, uint32_t seed);
+
+/*******************************************************
+ * @brief feed data into a MurmurHash3 x64_128 state
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_murmur3_128_update(silk_hash_state_t* state, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the hash value of a MurmurHash3 x64_128 state,
+ *        the state is not changed
+ * @param state the state
+ * @param hash return the hash value, the lower 64 bits
+ *             in hash[0] and the upper in hash[1]
+ *******************************************************/
+void silk_hash_murmur3_128_final(const silk_hash_state_t* state, uint64_t hash[2]);
+
+/*******************************************************
+ * @brief calculate the 64 bits hash value by wyhash
+ *        final4 with the default secret
+ *        see: https://github.com/wangyi-fudan/wyhash
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @return the hash value
+ *******************************************************/
+uint64_t silk_hash_wyhash(const void* data, size_t len, uint64_t seed);
+
+/*******************************************************
+ * @brief init a state to calculate wyhash incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_wyhash_init(silk_hash_state_t* state, uint64_t seed);
+
+/*******************************************************
+ * @brief feed data into a wyhash state
+ * @note  a full block is kept until more data comes, the
+ *        last bytes of data are hashed differently, the
+ *        last 16 consumed bytes are kept before the
+ *        pending bytes for the same reason
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_wyhash_update(silk_hash_state_t* state, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the hash value of a wyhash state, the state
+ *        is not changed
+ * @param state the state
+ * @return the hash value
+ *******************************************************/
+uint64_t silk_hash_wyhash_final(const silk_hash_state_t* state);
+
+/*******************************************************
+ * @brief map a key to a bucket by jump consistent hash,
+ *        when buckets grows to buckets + 1, only about
+ *        1 / (buckets + 1) of keys move, all to the new
+ *        bucket, it needs no memory and runs in O(log n)
+ *        see: https://arxiv.org/abs/1406.2294
+ * @param key the key, should be a hash value
+ * @param buckets count of buckets, must be positive
+ * @return the bucket, in [0, buckets)
+ *******************************************************/
+uint32_t silk_hash_jump(uint64_t key, uint32_t buckets);
+
+#endif // SILK_HASH_H
\ No newline at end of file
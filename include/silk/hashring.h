@@ -0,0 +1,82 @@
+#ifndef SILK_HASHRING_H
+#define SILK_HASHRING_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkHashring* silk_hashring_t;
+
+/*******************************************************
+ * @brief create a consistent hashing ring
+ * @note  each shard is placed on the ring as many virtual
+ *        nodes, a key belongs to the first node clockwise
+ *        from its hash, so adding or removing a shard only
+ *        moves the keys of that shard, lookup is a binary
+ *        search over the sorted nodes
+ *        see: https://en.wikipedia.org/wiki/Consistent_hashing
+ * @param replicas count of virtual nodes of each shard,
+ *                 more nodes balance keys better, about
+ *                 100 to 200 is usual
+ * @return the ring
+ *******************************************************/
+silk_hashring_t silk_hashring_new(size_t replicas);
+
+/*******************************************************
+ * @brief delete a consistent hashing ring
+ * @param ring the ring to be deleted
+ *******************************************************/
+void silk_hashring_delete(silk_hashring_t ring);
+
+/*******************************************************
+ * @brief remove all shards of a consistent hashing ring
+ * @param ring the ring to be cleared
+ *******************************************************/
+void silk_hashring_clear(silk_hashring_t ring);
+
+/*******************************************************
+ * @brief get the count of shards in a ring
+ * @param ring the ring
+ * @return the count of shards
+ *******************************************************/
+size_t silk_hashring_length(silk_hashring_t ring);
+
+/*******************************************************
+ * @brief add a shard into a ring
+ * @param ring the ring
+ * @param shard id of the shard
+ * @return whether it is successful, false if the shard
+ *         is already in the ring
+ *******************************************************/
+bool silk_hashring_add(silk_hashring_t ring, uint32_t shard);
+
+/*******************************************************
+ * @brief remove a shard from a ring, its keys move to
+ *        the other shards
+ * @param ring the ring
+ * @param shard id of the shard
+ * @return whether it is successful, false if the shard
+ *         is not in the ring
+ *******************************************************/
+bool silk_hashring_remove(silk_hashring_t ring, uint32_t shard);
+
+/*******************************************************
+ * @brief find the shard of a key
+ * @param ring the ring
+ * @param data the key
+ * @param len length of the key
+ * @return id of the shard, or SILK_INVALID_INDEX if the
+ *         ring is empty
+ *******************************************************/
+size_t silk_hashring_get(silk_hashring_t ring, const void* data, size_t len);
+
+/*******************************************************
+ * @brief find the shard of a hash value
+ * @param ring the ring
+ * @param hash the hash value, silk_hashring_get uses
+ *             silk_hash_murmur3_32 with seed 0
+ * @return id of the shard, or SILK_INVALID_INDEX if the
+ *         ring is empty
+ *******************************************************/
+size_t silk_hashring_get_hash(silk_hashring_t ring, uint32_t hash);
+
+#endif // SILK_HASHRING_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef SILK_HLL_H
+#define SILK_HLL_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkHll* silk_hll_t;
+
+/*******************************************************
+ * @brief create a HyperLogLog sketch
+ * @note  it estimates the count of distinct keys with
+ *        2^precision registers, the standard error is
+ *        about 1.04 / sqrt(2^precision), 0.81% for 14,
+ *        it stays sparse until the sorted register list
+ *        would take more memory than the dense registers
+ *        see: https://arxiv.org/abs/1702.01284
+ * @param precision count of index bits, 4 to 18
+ * @return the sketch
+ *******************************************************/
+silk_hll_t silk_hll_new(uint32_t precision);
+
+/*******************************************************
+ * @brief delete a HyperLogLog sketch
+ * @param hll the sketch to be deleted
+ *******************************************************/
+void silk_hll_delete(silk_hll_t hll);
+
+/*******************************************************
+ * @brief clear a HyperLogLog sketch, it becomes sparse
+ * @param hll the sketch to be cleared
+ *******************************************************/
+void silk_hll_clear(silk_hll_t hll);
+
+/*******************************************************
+ * @brief add a key into a HyperLogLog sketch
+ * @param hll the sketch
+ * @param data the key
+ * @param len length of the key
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_add(silk_hll_t hll, const void* data, size_t len);
+
+/*******************************************************
+ * @brief add a key by its 64 bits hash value, such as
+ *        silk_hash_wyhash, into a HyperLogLog sketch
+ * @param hll the sketch
+ * @param hash the hash value of the key
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_add_hash(silk_hll_t hll, uint64_t hash);
+
+/*******************************************************
+ * @brief estimate the count of distinct keys
+ * @param hll the sketch
+ * @return the estimated count
+ *******************************************************/
+uint64_t silk_hll_count(silk_hll_t hll);
+
+/*******************************************************
+ * @brief merge a sketch into another, the result is the
+ *        sketch of the union of the keys, registers are
+ *        merged by SIMD max
+ * @param hll the sketch to be merged into
+ * @param other the other sketch, not changed
+ * @return whether it is successful, false if precisions
+ *         are different
+ *******************************************************/
+bool silk_hll_merge(silk_hll_t hll, silk_hll_t other);
+
+/*******************************************************
+ * @brief get the size of a serialized sketch
+ * @param hll the sketch
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_hll_serialized_size(silk_hll_t hll);
+
+/*******************************************************
+ * @brief serialize a sketch, all values are little endian
+ * @param hll the sketch
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_hll_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_serialize(silk_hll_t hll, void* buffer, size_t size);
+
+/*******************************************************
+ * @brief create a sketch from serialized data
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the sketch, or NULL if data is invalid
+ *******************************************************/
+silk_hll_t silk_hll_deserialize(const void* data, size_t size);
+
+#endif // SILK_HLL_H
\ No newline at end of file
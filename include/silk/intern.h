@@ -0,0 +1,90 @@
+#ifndef SILK_INTERN_H
+#define SILK_INTERN_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkIntern* silk_intern_t;
+
+/*******************************************************
+ * @brief create a string intern pool
+ * @note  every distinct string is stored once, interned
+ *        strings are never moved until the pool is
+ *        cleared or deleted, so both the returned index
+ *        and the pointer from silk_intern_get can be used
+ *        as a handle, equal handles means equal strings
+ * @return the intern pool
+ *******************************************************/
+silk_intern_t silk_intern_new(void);
+
+/*******************************************************
+ * @brief delete a string intern pool
+ * @param intern the intern pool to be deleted
+ *******************************************************/
+void silk_intern_delete(silk_intern_t intern);
+
+/*******************************************************
+ * @brief clear a string intern pool
+ * @note  all handles got before become invalid
+ * @param intern the intern pool to be cleared
+ *******************************************************/
+void silk_intern_clear(silk_intern_t intern);
+
+/*******************************************************
+ * @brief get the count of distinct strings in a pool
+ * @param intern the intern pool
+ * @return the count of strings
+ *******************************************************/
+size_t silk_intern_length(silk_intern_t intern);
+
+/*******************************************************
+ * @brief intern a string, store it if it is new
+ * @param intern the intern pool
+ * @param data the string data, could contain '\0'
+ * @param len the length of the string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_put(silk_intern_t intern, const void* data, size_t len);
+
+/*******************************************************
+ * @brief intern a c-style string, store it if it is new
+ * @param intern the intern pool
+ * @param cstr the c-style string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_puts(silk_intern_t intern, const char* cstr);
+
+/*******************************************************
+ * @brief find an interned string without storing it
+ * @param intern the intern pool
+ * @param data the string data, could contain '\0'
+ * @param len the length of the string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_find(silk_intern_t intern, const void* data, size_t len);
+
+/*******************************************************
+ * @brief find an interned c-style string without storing it
+ * @param intern the intern pool
+ * @param cstr the c-style string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_finds(silk_intern_t intern, const char* cstr);
+
+/*******************************************************
+ * @brief get an interned string by handle
+ * @param intern the intern pool
+ * @param handle the handle of the string
+ * @return the stable c-style string, or NULL
+ *******************************************************/
+const char* silk_intern_get(silk_intern_t intern, size_t handle);
+
+/*******************************************************
+ * @brief get length of an interned string by handle
+ * @param intern the intern pool
+ * @param handle the handle of the string
+ * @return the length of the string
+ *******************************************************/
+size_t silk_intern_string_length(silk_intern_t intern, size_t handle);
+
+#endif // SILK_INTERN_H
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef SILK_LRU_H
+#define SILK_LRU_H
+
+#include "common.h"
+#include "memory.h"
+
+// least recently used, a hit moves the entry to the front
+#define SILK_LRU_POLICY_LRU     0
+
+// CLOCK, a hit only marks the entry, a marked entry gets a second chance when it is to be evicted
+#define SILK_LRU_POLICY_CLOCK   1
+
+typedef struct SilkLru* silk_lru_t;
+
+/*******************************************************
+ * @brief counters of silk_lru_stats
+ *******************************************************/
+typedef struct SilkLruStats
+{
+    uint64_t hits;          // count of silk_lru_get which found the key
+    uint64_t misses;        // count of silk_lru_get which did not find the key
+    uint64_t evictions;     // count of entries evicted for the budget
+} silk_lru_stats_t;
+
+/*******************************************************
+ * @brief get the bytes an entry takes from the budget
+ * @note  besides the key and the value, it charges the
+ *        node of the entry and a slot of the index at its
+ *        max load of 3/4, the allocator overhead and the
+ *        spare slots of the index after it grows are not
+ *        counted
+ * @param key_size size of the key
+ * @param size size of the value
+ * @return the bytes of the entry
+ *******************************************************/
+size_t silk_lru_entry_bytes(size_t key_size, size_t size);
+
+/*******************************************************
+ * @brief create a cache with a byte budget
+ * @note  each entry takes silk_lru_entry_bytes from the
+ *        budget, entries are evicted by the policy until a
+ *        new one fits, get and put are O(1)
+ * @param key_size size of each key
+ * @param budget max bytes of all entries
+ * @param policy SILK_LRU_POLICY_LRU or SILK_LRU_POLICY_CLOCK
+ * @return the cache
+ *******************************************************/
+silk_lru_t silk_lru_new(size_t key_size, size_t budget, int policy);
+
+/*******************************************************
+ * @brief delete a cache
+ * @param lru the cache to be deleted
+ *******************************************************/
+void silk_lru_delete(silk_lru_t lru);
+
+/*******************************************************
+ * @brief remove all entries of a cache, the counters are
+ *        kept
+ * @param lru the cache to be cleared
+ *******************************************************/
+void silk_lru_clear(silk_lru_t lru);
+
+/*******************************************************
+ * @brief get the count of entries of a cache
+ * @param lru the cache
+ * @return the count of entries
+ *******************************************************/
+size_t silk_lru_length(silk_lru_t lru);
+
+/*******************************************************
+ * @brief get the bytes of all entries of a cache
+ * @param lru the cache
+ * @return the bytes taken from the budget
+ *******************************************************/
+size_t silk_lru_bytes(silk_lru_t lru);
+
+/*******************************************************
+ * @brief put a copy of a value into a cache, the old
+ *        value of the key is replaced
+ * @param lru the cache
+ * @param key the key
+ * @param value the value
+ * @param size size of the value
+ * @return whether it is successful, false if the entry
+ *         is larger than the whole budget, the cache is
+ *         not changed if it fails
+ *******************************************************/
+bool silk_lru_put(silk_lru_t lru, const void* key, const void* value, size_t size);
+
+/*******************************************************
+ * @brief get the value of a key, and count a hit or miss
+ * @param lru the cache
+ * @param key the key
+ * @param size return size of the value, nullable
+ * @return the value, or NULL if it is not cached, it is
+ *         valid until the cache is modified
+ *******************************************************/
+const void* silk_lru_get(silk_lru_t lru, const void* key, size_t* size);
+
+/*******************************************************
+ * @brief remove an entry from a cache, it is not counted
+ *        as an eviction
+ * @param lru the cache
+ * @param key the key
+ * @return whether it is removed, false if it is not cached
+ *******************************************************/
+bool silk_lru_erase(silk_lru_t lru, const void* key);
+
+/*******************************************************
+ * @brief get the counters of a cache
+ * @param lru the cache
+ * @param stats return the counters
+ *******************************************************/
+void silk_lru_stats(silk_lru_t lru, silk_lru_stats_t* stats);
+
+#endif // SILK_LRU_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+#ifndef SILK_MAP_H
+#define SILK_MAP_H
+
+#include "common.h"
+#include "memory.h"
+
+// linear probing, a removed slot is marked as deleted until rehashing
+#define SILK_MAP_ENGINE_LINEAR      0
+
+// robin hood hashing, a removed slot is filled by shifting the following entries back
+#define SILK_MAP_ENGINE_ROBIN_HOOD  1
+
+typedef struct SilkMap* silk_map_t;
+
+/*******************************************************
+ * @brief result of silk_map_probe_stats
+ *******************************************************/
+typedef struct SilkMapProbeStats
+{
+    double hit;             // average count of slots probed to find an entry
+    double miss;            // average count of slots probed to miss a key, over all home slots
+    size_t max;             // max count of slots probed to find an entry
+} silk_map_probe_stats_t;
+
+/*******************************************************
+ * @brief callback of silk_map_foreach
+ * @param data the data passed to silk_map_foreach
+ * @param key the key, must not be modified
+ * @param value the value, could be modified
+ *******************************************************/
+typedef void (*silk_map_visit_t)(void* data, const void* key, void* value);
+
+/*******************************************************
+ * @brief create a hash map
+ * @note  keys are compared and hashed byte by byte, it is
+ *        open addressing with linear probing, keys and
+ *        values are stored in the slots
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @return the map
+ *******************************************************/
+silk_map_t silk_map_new(size_t key_size, size_t value_size);
+
+/*******************************************************
+ * @brief create a hash map with an engine
+ * @note  SILK_MAP_ENGINE_ROBIN_HOOD keeps entries ordered
+ *        by their home slots, a lookup stops as soon as
+ *        it meets an entry closer to its home, and erasing
+ *        leaves no deleted slot, so probes stay short
+ *        under heavy insert and erase churn
+ *        see: https://en.wikipedia.org/wiki/Hash_table#Robin_Hood_hashing
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @param engine SILK_MAP_ENGINE_LINEAR or SILK_MAP_ENGINE_ROBIN_HOOD
+ * @return the map
+ *******************************************************/
+silk_map_t silk_map_new_engine(size_t key_size, size_t value_size, int engine);
+
+/*******************************************************
+ * @brief delete a hash map
+ * @param map the map to be deleted
+ *******************************************************/
+void silk_map_delete(silk_map_t map);
+
+/*******************************************************
+ * @brief clear a hash map, the capacity is kept
+ * @param map the map to be cleared
+ *******************************************************/
+void silk_map_clear(silk_map_t map);
+
+/*******************************************************
+ * @brief get the count of entries of a hash map
+ * @param map the map
+ * @return the count of entries
+ *******************************************************/
+size_t silk_map_length(silk_map_t map);
+
+/*******************************************************
+ * @brief reserve enough memory of a hash map
+ * @param map the map
+ * @param count the count of entries could be held
+ *              without rehashing
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_reserve(silk_map_t map, size_t count);
+
+/*******************************************************
+ * @brief insert an entry into a hash map, the value is
+ *        replaced if the key is already in the map
+ * @param map the map
+ * @param key the key
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_put(silk_map_t map, const void* key, const void* value);
+
+/*******************************************************
+ * @brief get the value of a key
+ * @param map the map
+ * @param key the key
+ * @param value return the value, nullable
+ * @return whether the key is in the map
+ *******************************************************/
+bool silk_map_get(silk_map_t map, const void* key, void* value);
+
+/*******************************************************
+ * @brief find the value of a key in place
+ * @param map the map
+ * @param key the key
+ * @return the value, or NULL if the key is not in the
+ *         map, it is valid until the map is modified
+ *******************************************************/
+void* silk_map_find(silk_map_t map, const void* key);
+
+/*******************************************************
+ * @brief find the value of a key in place, insert the key
+ *        if it is not in the map
+ * @param map the map
+ * @param key the key
+ * @param inserted return whether the key is inserted,
+ *                 the value is uninitialized if so, nullable
+ * @return the value, or NULL if it fails, it is valid
+ *         until the map is modified
+ *******************************************************/
+void* silk_map_emplace(silk_map_t map, const void* key, bool* inserted);
+
+/*******************************************************
+ * @brief remove an entry from a hash map
+ * @param map the map
+ * @param key the key
+ * @return whether it is removed, false if the key is not
+ *         in the map
+ *******************************************************/
+bool silk_map_erase(silk_map_t map, const void* key);
+
+/*******************************************************
+ * @brief invoke callback for every entries
+ * @param map the map
+ * @param callback the callback function
+ * @param data the data passed to callback
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_foreach(silk_map_t map, silk_map_visit_t callback, void* data);
+
+/*******************************************************
+ * @brief measure the probe lengths of a hash map, it
+ *        walks all slots
+ * @param map the map
+ * @param stats return the probe lengths
+ *******************************************************/
+void silk_map_probe_stats(silk_map_t map, silk_map_probe_stats_t* stats);
+
+#endif // SILK_MAP_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef SILK_MATCHER_H
+#define SILK_MATCHER_H
+
+#include "common.h"
+#include "memory.h"
+#include "string.h"
+
+typedef struct SilkMatcher* silk_matcher_t;
+
+/*******************************************************
+ * @brief pointer to match callback function
+ * @param pattern the id of the matched pattern
+ * @param offset the offset of the match in data
+ * @param userdata a user data
+ * @return whether to continue matching
+ *******************************************************/
+typedef bool (*silk_matcher_callback_t)(size_t pattern, size_t offset, void* userdata);
+
+/*******************************************************
+ * @brief create a multi-pattern matcher
+ * @note  patterns are compiled into an Aho-Corasick
+ *        automaton, all matches are found in one pass
+ *        see: https://en.wikipedia.org/wiki/Aho%E2%80%93Corasick_algorithm
+ * @return the matcher
+ *******************************************************/
+silk_matcher_t silk_matcher_new(void);
+
+/*******************************************************
+ * @brief delete a matcher
+ * @param matcher the matcher to be deleted
+ *******************************************************/
+void silk_matcher_delete(silk_matcher_t matcher);
+
+/*******************************************************
+ * @brief remove all patterns of a matcher
+ * @param matcher the matcher to be cleared
+ *******************************************************/
+void silk_matcher_clear(silk_matcher_t matcher);
+
+/*******************************************************
+ * @brief get count of patterns in a matcher
+ * @param matcher the matcher
+ * @return the count of patterns
+ *******************************************************/
+size_t silk_matcher_length(silk_matcher_t matcher);
+
+/*******************************************************
+ * @brief add a pattern into a matcher
+ * @param matcher the matcher
+ * @param data the pattern, could contain '\0'
+ * @param len length of the pattern, must not be 0
+ * @return the id of the pattern, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_add(silk_matcher_t matcher, const void* data, size_t len);
+
+/*******************************************************
+ * @brief add a c-style string pattern into a matcher
+ * @param matcher the matcher
+ * @param cstr the pattern
+ * @return the id of the pattern, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_adds(silk_matcher_t matcher, const char* cstr);
+
+/*******************************************************
+ * @brief compile the patterns into the automaton
+ * @note  it is called by silk_matcher_match if patterns
+ *        are added after the last compiling
+ * @param matcher the matcher
+ * @return whether it is successful
+ *******************************************************/
+bool silk_matcher_compile(silk_matcher_t matcher);
+
+/*******************************************************
+ * @brief find all patterns in data, overlapped matches
+ *        are all reported, ordered by their end
+ * @param matcher the matcher
+ * @param data the data
+ * @param len length of the data
+ * @param callback called for each match, could be NULL
+ * @param userdata the user data passed to callback
+ * @return count of reported matches, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_match(silk_matcher_t matcher, const void* data, size_t len, silk_matcher_callback_t callback, void* userdata);
+
+/*******************************************************
+ * @brief find all patterns in a string
+ * @param matcher the matcher
+ * @param str the string
+ * @param callback called for each match, could be NULL
+ * @param userdata the user data passed to callback
+ * @return count of reported matches, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_match_string(silk_matcher_t matcher, silk_string_t str, silk_matcher_callback_t callback, void* userdata);
+
+#endif // SILK_MATCHER_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef SILK_MPH_H
+#define SILK_MPH_H
+
+#include "common.h"
+#include "memory.h"
+
+typedef struct SilkMph* silk_mph_t;
+
+/*******************************************************
+ * @brief a key of silk_mph_build
+ *******************************************************/
+typedef struct SilkMphKey
+{
+    const void* data;       // the key
+    size_t len;             // length of the key
+} silk_mph_key_t;
+
+/*******************************************************
+ * @brief build a minimal perfect hash function of keys,
+ *        it maps the keys to distinct indexes in
+ *        [0, count), so a table of count entries needs no
+ *        collision handling, it takes about 3.3 bits per key
+ *        for large key sets, more for small ones
+ * @note  keys are placed into buckets, each bucket gets a
+ *        pilot value which moves its keys to free slots,
+ *        a lookup reads the pilot, and the remap table
+ *        for about 1% of keys
+ *        see: https://arxiv.org/abs/2104.10402 (PTHash)
+ * @param keys the keys, must be distinct
+ * @param count count of keys, must be less than 2^32
+ * @return the minimal perfect hash function, or NULL if
+ *         keys are empty or duplicated
+ *******************************************************/
+silk_mph_t silk_mph_build(const silk_mph_key_t* keys, size_t count);
+
+/*******************************************************
+ * @brief delete a minimal perfect hash function
+ * @param mph the minimal perfect hash function
+ *******************************************************/
+void silk_mph_delete(silk_mph_t mph);
+
+/*******************************************************
+ * @brief get the count of keys of a minimal perfect hash
+ *        function
+ * @param mph the minimal perfect hash function
+ * @return the count of keys
+ *******************************************************/
+size_t silk_mph_count(silk_mph_t mph);
+
+/*******************************************************
+ * @brief get the index of a key
+ * @param mph the minimal perfect hash function
+ * @param data the key
+ * @param len length of the key
+ * @return the index in [0, count), an index in range is
+ *         returned for keys not built as well, so the
+ *         table entry should be checked if such keys
+ *         could be queried
+ *******************************************************/
+size_t silk_mph_get(silk_mph_t mph, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the size of a serialized minimal perfect
+ *        hash function
+ * @param mph the minimal perfect hash function
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_mph_serialized_size(silk_mph_t mph);
+
+/*******************************************************
+ * @brief serialize a minimal perfect hash function, all
+ *        values are little endian, the pilots start at
+ *        offset 64
+ * @param mph the minimal perfect hash function
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_mph_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_mph_serialize(silk_mph_t mph, void* buffer, size_t size);
+
+/*******************************************************
+ * @brief create a minimal perfect hash function from
+ *        serialized data, the data is copied
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the minimal perfect hash function, or NULL if
+ *         data is invalid
+ *******************************************************/
+silk_mph_t silk_mph_deserialize(const void* data, size_t size);
+
+/*******************************************************
+ * @brief create a minimal perfect hash function on
+ *        serialized data, such as a mmap'd file, the data
+ *        is used in place on little endian cpus if it is
+ *        8 bytes aligned, otherwise it is copied
+ * @note  data must be kept until the function is deleted
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the minimal perfect hash function, or NULL if
+ *         data is invalid
+ *******************************************************/
+silk_mph_t silk_mph_view(const void* data, size_t size);
+
+#endif // SILK_MPH_H
\ No newline at end of file
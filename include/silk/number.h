@@ -0,0 +1,76 @@
+#ifndef SILK_NUMBER_H
+#define SILK_NUMBER_H
+
+#include "common.h"
+
+// enough for any int64_t or uint64_t formatted by silk_number_format_int64 or silk_number_format_uint64
+#define SILK_NUMBER_INT_BUFFER_SIZE     24
+
+// enough for any double formatted by silk_number_format_double
+#define SILK_NUMBER_DOUBLE_BUFFER_SIZE  32
+
+/*******************************************************
+ * @brief format a signed integer in decimal
+ * @param buffer the buffer, SILK_NUMBER_INT_BUFFER_SIZE
+ *        bytes at least, the text is not '\0' terminated
+ * @param value the value
+ * @return the length of text
+ *******************************************************/
+size_t silk_number_format_int64(char* buffer, int64_t value);
+
+/*******************************************************
+ * @brief format an unsigned integer in decimal
+ * @param buffer the buffer, SILK_NUMBER_INT_BUFFER_SIZE
+ *        bytes at least, the text is not '\0' terminated
+ * @param value the value
+ * @return the length of text
+ *******************************************************/
+size_t silk_number_format_uint64(char* buffer, uint64_t value);
+
+/*******************************************************
+ * @brief format a double into text which reads back to
+ *        the same value, it is the shortest in nearly all
+ *        cases, but not guaranteed, the decimal point is
+ *        always '.' whatever the locale
+ * @param buffer the buffer, SILK_NUMBER_DOUBLE_BUFFER_SIZE
+ *        bytes at least, the text is not '\0' terminated
+ * @param value the value
+ * @return the length of text
+ *******************************************************/
+size_t silk_number_format_double(char* buffer, double value);
+
+/*******************************************************
+ * @brief parse a decimal integer from data with length
+ *        such as "-123", "+45" or "67", the whole range
+ *        must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_number_parse_int64(const char* data, size_t len, int64_t* value);
+
+/*******************************************************
+ * @brief parse a decimal unsigned integer from data 
+ *        with length such as "+45" or "67", the whole
+ *        range must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_number_parse_uint64(const char* data, size_t len, uint64_t* value);
+
+/*******************************************************
+ * @brief parse a double from data with length, such as
+ *        "-1.5", "2e10", ".5", "inf" or "nan", the whole
+ *        range must be the number, the decimal point is
+ *        always '.' whatever the locale
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_number_parse_double(const char* data, size_t len, double* value);
+
+#endif // SILK_NUMBER_H
\ No newline at end of file
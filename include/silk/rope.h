@@ -0,0 +1,124 @@
+#ifndef SILK_ROPE_H
+#define SILK_ROPE_H
+
+#include "common.h"
+#include "memory.h"
+#include "string.h"
+
+typedef struct SilkRope* silk_rope_t;
+
+/*******************************************************
+ * @brief create a rope
+ * @note  rope is a balanced tree of text chunks,
+ *        insert, remove and index are O(log n)
+ *        see: https://en.wikipedia.org/wiki/Rope_(data_structure)
+ * @param cstr init value, c-style string
+ * @return the rope
+ *******************************************************/
+silk_rope_t silk_rope_new(const char* cstr);
+
+/*******************************************************
+ * @brief delete a rope
+ * @param rope the rope to be deleted
+ *******************************************************/
+void silk_rope_delete(silk_rope_t rope);
+
+/*******************************************************
+ * @brief clear a rope
+ * @param rope the rope to be cleared
+ *******************************************************/
+void silk_rope_clear(silk_rope_t rope);
+
+/*******************************************************
+ * @brief get length of a rope
+ * @param rope the rope
+ * @return the length
+ *******************************************************/
+size_t silk_rope_length(silk_rope_t rope);
+
+/*******************************************************
+ * @brief get char at index of rope
+ * @param rope the rope
+ * @param index the index
+ * @return char at index of rope
+ *******************************************************/
+char silk_rope_at(silk_rope_t rope, size_t index);
+
+/*******************************************************
+ * @brief insert character into rope
+ * @param rope the rope
+ * @param index the index
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_insert(silk_rope_t rope, size_t index, char ch);
+
+/*******************************************************
+ * @brief insert c-style string into rope
+ * @param rope the rope
+ * @param index the index
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_inserts(silk_rope_t rope, size_t index, const char* cstr);
+
+/*******************************************************
+ * @brief insert data with length into rope
+ * @param rope the rope
+ * @param index the index
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_insertn(silk_rope_t rope, size_t index, const char* data, size_t len);
+
+/*******************************************************
+ * @brief append character into rope
+ * @param rope the rope
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_append(silk_rope_t rope, char ch);
+
+/*******************************************************
+ * @brief append c-style string into rope
+ * @param rope the rope
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_appends(silk_rope_t rope, const char* cstr);
+
+/*******************************************************
+ * @brief remove a character from a rope
+ * @param rope the rope
+ * @param index the index
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_remove(silk_rope_t rope, size_t index);
+
+/*******************************************************
+ * @brief remove some characters from a rope
+ * @param rope the rope
+ * @param index the index
+ * @param length the length to be removed
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_removes(silk_rope_t rope, size_t index, size_t length);
+
+/*******************************************************
+ * @brief move all characters of other to the end of rope
+ *        in O(log n), other becomes empty
+ * @param rope the rope
+ * @param other the rope to be concatenated
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_concat(silk_rope_t rope, silk_rope_t other);
+
+/*******************************************************
+ * @brief flatten a rope into a new string
+ * @param rope the rope
+ * @return the string
+ *******************************************************/
+silk_string_t silk_rope_to_string(silk_rope_t rope);
+
+#endif // SILK_ROPE_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef SILK_SET_H
+#define SILK_SET_H
+
+#include "common.h"
+#include "memory.h"
+#include "vector.h"
+
+typedef struct SilkSet* silk_set_t;
+
+/*******************************************************
+ * @brief create a hash set
+ * @note  elements are compared and hashed byte by byte,
+ *        strings could be stored as handles of silk_intern,
+ *        it is open addressing with linear probing
+ * @param element_size size of each element
+ * @return the set
+ *******************************************************/
+silk_set_t silk_set_new(size_t element_size);
+
+/*******************************************************
+ * @brief delete a hash set
+ * @param set the set to be deleted
+ *******************************************************/
+void silk_set_delete(silk_set_t set);
+
+/*******************************************************
+ * @brief clear a hash set, the capacity is kept
+ * @param set the set to be cleared
+ *******************************************************/
+void silk_set_clear(silk_set_t set);
+
+/*******************************************************
+ * @brief get the element size of a hash set
+ * @param set the set
+ * @return the element size
+ *******************************************************/
+size_t silk_set_element_size(silk_set_t set);
+
+/*******************************************************
+ * @brief get the count of elements of a hash set
+ * @param set the set
+ * @return the count of elements
+ *******************************************************/
+size_t silk_set_length(silk_set_t set);
+
+/*******************************************************
+ * @brief reserve enough memory of a hash set
+ * @param set the set
+ * @param count the count of elements could be held
+ *              without rehashing
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_reserve(silk_set_t set, size_t count);
+
+/*******************************************************
+ * @brief insert an element into a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is successful, it is true if the
+ *         element is already in the set
+ *******************************************************/
+bool silk_set_insert(silk_set_t set, const void* data);
+
+/*******************************************************
+ * @brief insert elements of an array into a hash set,
+ *        the set is reserved first, and elements are
+ *        hashed and prefetched in batches
+ * @param set the set
+ * @param data the elements, adjacent
+ * @param count count of elements
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_insert_bulk(silk_set_t set, const void* data, size_t count);
+
+/*******************************************************
+ * @brief remove an element from a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is removed, false if it is not in
+ *         the set
+ *******************************************************/
+bool silk_set_remove(silk_set_t set, const void* data);
+
+/*******************************************************
+ * @brief determine whether an element is in a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is in the set
+ *******************************************************/
+bool silk_set_contains(silk_set_t set, const void* data);
+
+/*******************************************************
+ * @brief invoke callback for every elements like
+ *        data = callback(data, element), elements must
+ *        not be modified
+ * @param set the set
+ * @param callback the callback function
+ * @param data the data input init value and output result
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_reduce(silk_set_t set, silk_reduce_callback_t callback, void* data);
+
+/*******************************************************
+ * @brief copy elements of a hash set into a new vector,
+ *        they are not sorted
+ * @param set the set
+ * @return the vector
+ *******************************************************/
+silk_vector_t silk_set_to_vector(silk_set_t set);
+
+/*******************************************************
+ * @brief create a set of elements in either set
+ * @note  the result is reserved once, and elements are
+ *        probed in batches with the slots prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the union set
+ *******************************************************/
+silk_set_t silk_set_union(silk_set_t x, silk_set_t y);
+
+/*******************************************************
+ * @brief create a set of elements in both sets
+ * @note  elements of the smaller set are probed in the
+ *        larger set in batches with the slots prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the intersection set
+ *******************************************************/
+silk_set_t silk_set_intersect(silk_set_t x, silk_set_t y);
+
+/*******************************************************
+ * @brief create a set of elements in x but not in y
+ * @note  elements are probed in batches with the slots
+ *        prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the difference set
+ *******************************************************/
+silk_set_t silk_set_difference(silk_set_t x, silk_set_t y);
+
+#endif // SILK_SET_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef SILK_STRBUILDER_H
+#define SILK_STRBUILDER_H
+
+#include "common.h"
+#include "memory.h"
+#include "string.h"
+
+#include <stdarg.h>
+
+typedef struct SilkStrbuilder* silk_strbuilder_t;
+
+/*******************************************************
+ * @brief create a string builder
+ * @note  appended data is collected in a chain of chunks
+ *        and never moved, it is copied only once when the
+ *        result is materialized or written
+ * @return the string builder
+ *******************************************************/
+silk_strbuilder_t silk_strbuilder_new(void);
+
+/*******************************************************
+ * @brief delete a string builder
+ * @param builder the string builder to be deleted
+ *******************************************************/
+void silk_strbuilder_delete(silk_strbuilder_t builder);
+
+/*******************************************************
+ * @brief clear a string builder, the first chunk is kept
+ *        for reuse
+ * @param builder the string builder to be cleared
+ *******************************************************/
+void silk_strbuilder_clear(silk_strbuilder_t builder);
+
+/*******************************************************
+ * @brief get length of data in a string builder
+ * @param builder the string builder
+ * @return the length
+ *******************************************************/
+size_t silk_strbuilder_length(silk_strbuilder_t builder);
+
+/*******************************************************
+ * @brief append character into string builder
+ * @param builder the string builder
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_append(silk_strbuilder_t builder, char ch);
+
+/*******************************************************
+ * @brief append c-style string into string builder
+ * @param builder the string builder
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appends(silk_strbuilder_t builder, const char* cstr);
+
+/*******************************************************
+ * @brief append data with length into string builder
+ * @param builder the string builder
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appendn(silk_strbuilder_t builder, const char* data, size_t len);
+
+/*******************************************************
+ * @brief append formatted data into string builder
+ * @param builder the string builder
+ * @param fmt the format, same as printf
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appendf(silk_strbuilder_t builder, const char* fmt, ...);
+
+/*******************************************************
+ * @brief append formatted data into string builder
+ * @param builder the string builder
+ * @param fmt the format, same as vprintf
+ * @param args the arguments
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_vappendf(silk_strbuilder_t builder, const char* fmt, va_list args);
+
+/*******************************************************
+ * @brief materialize the data into a new string, it is
+ *        allocated once with the exact size
+ * @param builder the string builder
+ * @return the string
+ *******************************************************/
+silk_string_t silk_strbuilder_to_string(silk_strbuilder_t builder);
+
+/*******************************************************
+ * @brief write the data into a file descriptor, the
+ *        chunks are gathered by writev on POSIX
+ * @param builder the string builder
+ * @param fd the file descriptor
+ * @return whether all data is written
+ *******************************************************/
+bool silk_strbuilder_write(silk_strbuilder_t builder, int fd);
+
+#endif // SILK_STRBUILDER_H
\ No newline at end of file
@@ -5,8 +5,22 @@
 #include "compare.h"
 #include "memory.h"
 
+#include <stdarg.h>
+
 typedef struct SilkString* silk_string_t;
 
+/*******************************************************
+ * @brief an edit of silk_string_edit, replace length
+ *        characters at index with size bytes of data
+ *******************************************************/
+typedef struct SilkStringEdit
+{
+    size_t index;           // index in the original string
+    size_t length;          // count of characters to be removed
+    const char* data;       // data to be inserted, could contain '\0'
+    size_t size;            // length of the data
+} silk_string_edit_t;
+
 /*******************************************************
  * @brief create a string
  * @param cstr init value, c-style string
@@ -66,6 +80,11 @@ size_t silk_string_length(silk_string_t str);
 
 /*******************************************************
  * @brief get string value as c-style string
+ * @note  the cached hash is dropped by this call, not by
+ *        writes through the pointer, so after
+ *        silk_string_hash or silk_string_equal, call it
+ *        again before writing, or the stale hash could
+ *        make equal strings compare unequal
  * @param str the string to be get
  * @return c-style string value
  *******************************************************/
@@ -79,6 +98,16 @@ char* silk_string_data(silk_string_t str);
  *******************************************************/
 bool silk_string_equal(silk_string_t str1, silk_string_t str2);
 
+/*******************************************************
+ * @brief get the hash value of a string
+ * @note  the value is calculated by silk_hash_murmur3_32
+ *        with seed 0 and cached until the string is
+ *        modified
+ * @param str the string
+ * @return the hash value
+ *******************************************************/
+uint32_t silk_string_hash(silk_string_t str);
+
 /*******************************************************
  * @brief get char at index of string
  * @param str the string
@@ -124,6 +153,33 @@ bool silk_string_append(silk_string_t str, char ch);
  *******************************************************/
 bool silk_string_appends(silk_string_t str, const char* cstr);
 
+/*******************************************************
+ * @brief append data with length into string
+ * @param str the string
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_appendn(silk_string_t str, const char* data, size_t len);
+
+/*******************************************************
+ * @brief reserve enough memory of a string
+ * @param str the string
+ * @param capacity the length could be held without 
+ *                 reallocating, not including the '\0'
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_reserve(silk_string_t str, size_t capacity);
+
+/*******************************************************
+ * @brief resize a string, new characters are uninitialized,
+ *        they could be written by silk_string_data
+ * @param str the string
+ * @param length the new length, not including the '\0'
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_resize(silk_string_t str, size_t length);
+
 /*******************************************************
  * @brief remove a character from a string
  * @param str the string
@@ -141,4 +197,158 @@ bool silk_string_remove(silk_string_t str, size_t index);
  *******************************************************/
 bool silk_string_removes(silk_string_t str, size_t index, size_t length);
 
+/*******************************************************
+ * @brief append formatted data into string, it is
+ *        formatted into the spare capacity directly
+ * @param str the string
+ * @param fmt the format, same as printf
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_appendf(silk_string_t str, const char* fmt, ...);
+
+/*******************************************************
+ * @brief append formatted data into string, it is
+ *        formatted into the spare capacity directly
+ * @param str the string
+ * @param fmt the format, same as vprintf
+ * @param args the arguments
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_vappendf(silk_string_t str, const char* fmt, va_list args);
+
+/*******************************************************
+ * @brief append a signed integer in decimal into string
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_int64(silk_string_t str, int64_t value);
+
+/*******************************************************
+ * @brief append an unsigned integer in decimal into string
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_uint64(silk_string_t str, uint64_t value);
+
+/*******************************************************
+ * @brief append a double into string, with text which
+ *        reads back to the same value, it is the shortest
+ *        in nearly all cases, but not guaranteed, the
+ *        decimal point is always '.' whatever the locale
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_double(silk_string_t str, double value);
+
+/*******************************************************
+ * @brief parse a decimal integer from data with length
+ *        such as "-123", "+45" or "67", the whole range
+ *        must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_int64(const char* data, size_t len, int64_t* value);
+
+/*******************************************************
+ * @brief parse a decimal unsigned integer from data 
+ *        with length such as "+45" or "67", the whole
+ *        range must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_uint64(const char* data, size_t len, uint64_t* value);
+
+/*******************************************************
+ * @brief parse a double from data with length, such as
+ *        "-1.5", "2e10", ".5", "inf" or "nan", the whole
+ *        range must be the number, the decimal point is
+ *        always '.' whatever the locale
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_double(const char* data, size_t len, double* value);
+
+/*******************************************************
+ * @brief determine whether a string is valid UTF-8
+ * @param str the string
+ * @return whether it is valid UTF-8
+ *******************************************************/
+bool silk_string_utf8_validate(silk_string_t str);
+
+/*******************************************************
+ * @brief get length of a string in UTF-8 code points,
+ *        silk_string_length is in bytes
+ * @param str the string, should be valid UTF-8
+ * @return the count of code points
+ *******************************************************/
+size_t silk_string_utf8_length(silk_string_t str);
+
+/*******************************************************
+ * @brief convert ascii letters of a string to lowercase
+ *        in place, other bytes are not changed
+ * @param str the string
+ *******************************************************/
+void silk_string_to_lower(silk_string_t str);
+
+/*******************************************************
+ * @brief convert ascii letters of a string to uppercase
+ *        in place, other bytes are not changed
+ * @param str the string
+ *******************************************************/
+void silk_string_to_upper(silk_string_t str);
+
+/*******************************************************
+ * @brief determine whether two string are equal
+ *        ignoring ascii case
+ * @param str1 the string to be determine
+ * @param str2 the string to be determine
+ * @return whether two string are equal
+ *******************************************************/
+bool silk_string_equal_nocase(silk_string_t str1, silk_string_t str2);
+
+/*******************************************************
+ * @brief compare two string ignoring ascii case, bytes
+ *        are compared as unsigned char after converted
+ *        to lowercase, like strcasecmp
+ * @param str1 the string to be compared
+ * @param str2 the string to be compared
+ * @return negative value while str1 < str2
+ *         positive value while str1 > str2
+ *         0 while str1 == str2
+ *******************************************************/
+int silk_string_compare_nocase(silk_string_t str1, silk_string_t str2);
+
+/*******************************************************
+ * @brief replace all occurrences of from with to, it is
+ *        done in one pass, with at most one allocation
+ * @note  from and to must not point into the string
+ * @param str the string
+ * @param from the c-style string to be replaced, not empty
+ * @param to the c-style string to replace with
+ * @return count of replaced occurrences, 
+ *         or SILK_INVALID_INDEX if it fails
+ *******************************************************/
+size_t silk_string_replace_all(silk_string_t str, const char* from, const char* to);
+
+/*******************************************************
+ * @brief apply a batch of edits in one pass, the output
+ *        size is computed first, so it allocates once
+ * @param str the string
+ * @param edits the edits, sorted by index and not
+ *              overlapped, indexes are in the original
+ *              string
+ * @param count count of edits
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_edit(silk_string_t str, const silk_string_edit_t* edits, size_t count);
+
 #endif // SILK_STRING_H
\ No newline at end of file
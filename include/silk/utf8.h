@@ -0,0 +1,27 @@
+#ifndef SILK_UTF8_H
+#define SILK_UTF8_H
+
+#include "common.h"
+
+/*******************************************************
+ * @brief determine whether data is valid UTF-8
+ * @note  overlong forms, surrogates and code points
+ *        above U+10FFFF are rejected, it uses SSSE3 or
+ *        AVX2 if the cpu supports
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is valid UTF-8
+ *******************************************************/
+bool silk_utf8_validate(const void* data, size_t len);
+
+/*******************************************************
+ * @brief count code points of UTF-8 data
+ * @note  it counts bytes which are not continuation
+ *        bytes, the data should be validated first
+ * @param data the data
+ * @param len length of the data
+ * @return the count of code points
+ *******************************************************/
+size_t silk_utf8_length(const void* data, size_t len);
+
+#endif // SILK_UTF8_H
\ No newline at end of file
@@ -1,6 +1,12 @@
 #ifndef SILK_UTILS_H
 #define SILK_UTILS_H
 
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
 /*******************************************************
  * @brief rotate left
  * @param VALUE the src value
@@ -19,4 +25,71 @@
  *******************************************************/
 #define SILK_ROR(LENGTH, VALUE, BITS) ((VALUE >> BITS) | (VALUE << (LENGTH - BITS)))
 
+/*******************************************************
+ * @brief prefetch the cache line of an address, so a
+ *        later access does not wait for the memory
+ * @param ADDR the address
+ *******************************************************/
+#if defined(__GNUC__)
+    #define SILK_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define SILK_PREFETCH(ADDR) _mm_prefetch((const char*)(ADDR), _MM_HINT_T0)
+#else
+    #define SILK_PREFETCH(ADDR) ((void)(ADDR))
+#endif
+
+/*******************************************************
+ * @brief multiply two uint64_t values into 128 bits
+ * @param x a value
+ * @param y a value
+ * @param high return the upper 64 bits
+ * @return the lower 64 bits
+ *******************************************************/
+static inline uint64_t silk_mul128(uint64_t x, uint64_t y, uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)x * y;
+    *high = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(x, y, high);
+#else
+    uint64_t x_lo = x & 0xFFFFFFFFu;
+    uint64_t x_hi = x >> 32;
+    uint64_t y_lo = y & 0xFFFFFFFFu;
+    uint64_t y_hi = y >> 32;
+    uint64_t lo_lo = x_lo * y_lo;
+    uint64_t hi_lo = x_hi * y_lo;
+    uint64_t lo_hi = x_lo * y_hi;
+    uint64_t hi_hi = x_hi * y_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+#endif
+}
+
+/*******************************************************
+ * @brief count leading zero bits
+ * @param x the value, must not be 0
+ * @return count of leading zero bits
+ *******************************************************/
+static inline int silk_clz64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - (int)index;
+#else
+    int n = 0;
+    while ((x >> 63) == 0)
+    {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
 #endif // SILK_UTILS_H
\ No newline at end of file
@@ -102,6 +102,14 @@ bool silk_vector_recycle(silk_vector_t vector);
  *******************************************************/
 bool silk_vector_reserve(silk_vector_t vector, size_t capacity);
 
+/*******************************************************
+ * @brief resize a vector, new elements are uninitialized
+ * @param vector the vector
+ * @param length the new length
+ * @return whether it is successful
+ *******************************************************/
+bool silk_vector_resize(silk_vector_t vector, size_t length);
+
 /*******************************************************
  * @brief insert elements into a vector
  * @param vector the vector
@@ -0,0 +1,49 @@
+#ifndef SILK_XORFILTER_H
+#define SILK_XORFILTER_H
+
+#include "common.h"
+#include "memory.h"
+#include "vector.h"
+
+typedef struct SilkXorfilter* silk_xorfilter_t;
+
+/*******************************************************
+ * @brief create a binary fuse filter of a static key set
+ * @note  it is an xor filter with 8-bit fingerprints in
+ *        spatially coupled segments, it takes about 9 bits
+ *        per key, the false positive rate is 1/256, and a
+ *        query reads 3 bytes, keys can not be added later
+ *        see: https://arxiv.org/abs/2201.01174
+ * @param keys the keys, bytes of each element is a key,
+ *             duplicated keys are allowed
+ * @return the filter, or NULL if it fails, building could
+ *         fail after all seeds are tried, it is not an
+ *         assertion failure
+ *******************************************************/
+silk_xorfilter_t silk_xorfilter_new(silk_vector_t keys);
+
+/*******************************************************
+ * @brief delete a binary fuse filter
+ * @param filter the filter to be deleted
+ *******************************************************/
+void silk_xorfilter_delete(silk_xorfilter_t filter);
+
+/*******************************************************
+ * @brief determine whether a key may be in a filter
+ * @param filter the filter
+ * @param data the key
+ * @param len length of the key, it should be the element
+ *            size of the vector to create the filter
+ * @return false if the key is surely not in the key set,
+ *         true if it is probably in the key set
+ *******************************************************/
+bool silk_xorfilter_contains(silk_xorfilter_t filter, const void* data, size_t len);
+
+/*******************************************************
+ * @brief get the memory of fingerprints of a filter
+ * @param filter the filter
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_xorfilter_size(silk_xorfilter_t filter);
+
+#endif // SILK_XORFILTER_H
\ No newline at end of file
@@ -0,0 +1,502 @@
+#include <silk/bloom.h>
+#include <silk/cpu.h>
+#include <silk/endian.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/utils.h>
+
+#include <string.h>
+
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
+// words of each block, a block is a cache line
+#define SILK_BLOOM_BLOCK_WORDS  8
+#define SILK_BLOOM_BLOCK_SIZE   (SILK_BLOOM_BLOCK_WORDS * sizeof(uint64_t))
+
+// max count of bits of each key
+#define SILK_BLOOM_MAX_K        16
+
+// keys hashed and prefetched ahead in bulk operations
+#define SILK_BLOOM_BATCH        16
+
+// size of the serialized header, keeps the serialized blocks aligned
+#define SILK_BLOOM_HEADER_SIZE  64
+
+// "SKBLOOM1" in little endian
+#define SILK_BLOOM_MAGIC        0x314d4f4f4c424b53ull
+
+struct SilkBloom
+{
+    uint64_t* blocks;       // SILK_BLOOM_BLOCK_WORDS words of each block
+    void* memory;           // allocated memory of blocks, NULL if blocks are in a view
+    size_t count;           // count of blocks
+    uint32_t k;             // count of bits of each key
+    bool readonly;          // whether it is a view
+};
+
+/*******************************************************
+ * @brief alloc a bloom filter with cache line aligned
+ *        blocks, the blocks are all zero
+ * @param count count of blocks
+ * @param k count of bits of each key
+ * @return the bloom filter
+ *******************************************************/
+static silk_bloom_t silk_bloom_alloc(size_t count, uint32_t k)
+{
+    silk_bloom_t bloom = silk_alloc(sizeof(struct SilkBloom));
+    SILK_ASSERT(bloom != NULL, NULL);
+
+    bloom->memory = silk_alloc(count * SILK_BLOOM_BLOCK_SIZE + SILK_BLOOM_BLOCK_SIZE - 1);
+    SILK_ASSERT(bloom->memory != NULL, silk_free(bloom), NULL);
+
+    uintptr_t address = ((uintptr_t)bloom->memory + SILK_BLOOM_BLOCK_SIZE - 1) & ~(uintptr_t)(SILK_BLOOM_BLOCK_SIZE - 1);
+    bloom->blocks = (uint64_t*)address;
+    bloom->count = count;
+    bloom->k = k;
+    bloom->readonly = false;
+    memset(bloom->blocks, 0, count * SILK_BLOOM_BLOCK_SIZE);
+    return bloom;
+}
+
+/*******************************************************
+ * @brief get the block of a key
+ * @param bloom the bloom filter
+ * @param hash hash value of the key
+ * @return the block
+ *******************************************************/
+static inline uint64_t* silk_bloom_block(silk_bloom_t bloom, uint64_t hash)
+{
+    // map the upper 32 bits to [0, count) without division
+    size_t index = (size_t)(((hash >> 32) * (uint64_t)bloom->count) >> 32);
+    return bloom->blocks + index * SILK_BLOOM_BLOCK_WORDS;
+}
+
+/*******************************************************
+ * @brief get the bits of a key in its block, the i-th
+ *        bit is the upper 9 bits of h1 + i * h2
+ * @param hash hash value of the key
+ * @param k count of bits of each key
+ * @param mask return the bits
+ *******************************************************/
+static inline void silk_bloom_mask(uint64_t hash, uint32_t k, uint64_t mask[SILK_BLOOM_BLOCK_WORDS])
+{
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)((hash * 0x9e3779b97f4a7c15ull) >> 32) | 1;
+
+    memset(mask, 0, SILK_BLOOM_BLOCK_SIZE);
+    for (uint32_t i = 0; i < k; i++, h1 += h2)
+    {
+        uint32_t bit = h1 >> 23;
+        mask[bit >> 6] |= 1ull << (bit & 63);
+    }
+}
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief determine whether all bits of mask are set in
+ *        a block by AVX2
+ * @param block the block
+ * @param mask the bits
+ * @return whether all bits are set
+ *******************************************************/
+SILK_TARGET("avx2")
+static bool silk_bloom_test_avx2(const uint64_t* block, const uint64_t* mask)
+{
+    __m256i b0 = _mm256_loadu_si256((const __m256i*)block);
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)(block + 4));
+    __m256i m0 = _mm256_loadu_si256((const __m256i*)mask);
+    __m256i m1 = _mm256_loadu_si256((const __m256i*)(mask + 4));
+    return (_mm256_testc_si256(b0, m0) & _mm256_testc_si256(b1, m1)) != 0;
+}
+
+/*******************************************************
+ * @brief determine whether all bits of mask are set in
+ *        a block by SSE2
+ * @param block the block
+ * @param mask the bits
+ * @return whether all bits are set
+ *******************************************************/
+SILK_TARGET("sse2")
+static bool silk_bloom_test_sse2(const uint64_t* block, const uint64_t* mask)
+{
+    __m128i result = _mm_set1_epi8(-1);
+    for (size_t i = 0; i < SILK_BLOOM_BLOCK_WORDS; i += 2)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i*)(block + i));
+        __m128i m = _mm_loadu_si128((const __m128i*)(mask + i));
+        result = _mm_and_si128(result, _mm_cmpeq_epi8(_mm_and_si128(b, m), m));
+    }
+    return _mm_movemask_epi8(result) == 0xffff;
+}
+#endif
+
+/*******************************************************
+ * @brief determine whether all bits of mask are set in
+ *        a block
+ * @param block the block
+ * @param mask the bits
+ * @return whether all bits are set
+ *******************************************************/
+static inline bool silk_bloom_test(const uint64_t* block, const uint64_t* mask)
+{
+#if defined(SILK_CPU_X86)
+    if (silk_cpu_supports(SILK_CPU_AVX2))
+        return silk_bloom_test_avx2(block, mask);
+
+    if (silk_cpu_supports(SILK_CPU_SSE2))
+        return silk_bloom_test_sse2(block, mask);
+#endif
+
+    uint64_t missing = 0;
+    for (size_t i = 0; i < SILK_BLOOM_BLOCK_WORDS; i++)
+        missing |= mask[i] & ~block[i];
+    return missing == 0;
+}
+
+/*******************************************************
+ * @brief set all bits of mask in a block
+ * @param block the block
+ * @param mask the bits
+ *******************************************************/
+static inline void silk_bloom_set(uint64_t* block, const uint64_t* mask)
+{
+    for (size_t i = 0; i < SILK_BLOOM_BLOCK_WORDS; i++)
+        block[i] |= mask[i];
+}
+
+/*******************************************************
+ * @brief create a blocked bloom filter
+ * @note  all bits of a key are in one 64-byte block, so
+ *        a query touches one cache line, the bits are
+ *        derived from one wyhash value by double hashing,
+ *        10 bits per key gives about 1% false positives
+ * @param capacity the expected count of keys
+ * @param bits_per_key bits of memory for each key
+ * @return the bloom filter
+ *******************************************************/
+silk_bloom_t silk_bloom_new(size_t capacity, size_t bits_per_key)
+{
+    SILK_ASSERT(bits_per_key > 0, NULL);
+    SILK_ASSERT(capacity <= SIZE_MAX / bits_per_key, NULL);
+
+    size_t bits = capacity * bits_per_key;
+    size_t count = bits / (SILK_BLOOM_BLOCK_SIZE * 8) + 1;
+    SILK_ASSERT(count <= UINT32_MAX, NULL);
+
+    // optimal k is bits_per_key * ln2
+    size_t k = (bits_per_key * 693 + 500) / 1000;
+    if (k < 1)
+        k = 1;
+    if (k > SILK_BLOOM_MAX_K)
+        k = SILK_BLOOM_MAX_K;
+
+    return silk_bloom_alloc(count, (uint32_t)k);
+}
+
+/*******************************************************
+ * @brief delete a bloom filter
+ * @param bloom the bloom filter to be deleted
+ *******************************************************/
+void silk_bloom_delete(silk_bloom_t bloom)
+{
+    SILK_ASSERT(bloom != NULL);
+
+    if (bloom->memory != NULL)
+        silk_free(bloom->memory);
+    silk_free(bloom);
+}
+
+/*******************************************************
+ * @brief clear a bloom filter
+ * @param bloom the bloom filter to be cleared
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_clear(silk_bloom_t bloom)
+{
+    SILK_ASSERT(bloom != NULL, false);
+
+    if (bloom->readonly)
+        return false;
+
+    memset(bloom->blocks, 0, bloom->count * SILK_BLOOM_BLOCK_SIZE);
+    return true;
+}
+
+/*******************************************************
+ * @brief add a key into a bloom filter
+ * @param bloom the bloom filter
+ * @param data the key
+ * @param len length of the key
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_add(silk_bloom_t bloom, const void* data, size_t len)
+{
+    SILK_ASSERT(bloom != NULL, false);
+
+    if (bloom->readonly)
+        return false;
+
+    uint64_t mask[SILK_BLOOM_BLOCK_WORDS];
+    uint64_t hash = silk_hash_wyhash(data, len, 0);
+    silk_bloom_mask(hash, bloom->k, mask);
+    silk_bloom_set(silk_bloom_block(bloom, hash), mask);
+    return true;
+}
+
+/*******************************************************
+ * @brief determine whether a key may be in a bloom filter
+ * @param bloom the bloom filter
+ * @param data the key
+ * @param len length of the key
+ * @return false if the key is surely not added,
+ *         true if it is probably added
+ *******************************************************/
+bool silk_bloom_contains(silk_bloom_t bloom, const void* data, size_t len)
+{
+    SILK_ASSERT(bloom != NULL, false);
+
+    uint64_t mask[SILK_BLOOM_BLOCK_WORDS];
+    uint64_t hash = silk_hash_wyhash(data, len, 0);
+    silk_bloom_mask(hash, bloom->k, mask);
+    return silk_bloom_test(silk_bloom_block(bloom, hash), mask);
+}
+
+/*******************************************************
+ * @brief add many keys with the same length into a bloom
+ *        filter, blocks are prefetched ahead
+ * @param bloom the bloom filter
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @return whether it is successful, false if the filter
+ *         is a read-only view
+ *******************************************************/
+bool silk_bloom_add_bulk(silk_bloom_t bloom, const void* keys, size_t key_len, size_t count)
+{
+    SILK_ASSERT(bloom != NULL, false);
+
+    if (bloom->readonly)
+        return false;
+    SILK_ASSERT(keys != NULL || count == 0, false);
+
+    const uint8_t* p = keys;
+    uint64_t hashes[SILK_BLOOM_BATCH];
+    uint64_t* blocks[SILK_BLOOM_BATCH];
+    uint64_t mask[SILK_BLOOM_BLOCK_WORDS];
+    for (size_t i = 0; i < count; i += SILK_BLOOM_BATCH)
+    {
+        size_t n = count - i < SILK_BLOOM_BATCH ? count - i : SILK_BLOOM_BATCH;
+        for (size_t j = 0; j < n; j++)
+        {
+            hashes[j] = silk_hash_wyhash(p + (i + j) * key_len, key_len, 0);
+            blocks[j] = silk_bloom_block(bloom, hashes[j]);
+            SILK_PREFETCH(blocks[j]);
+        }
+
+        for (size_t j = 0; j < n; j++)
+        {
+            silk_bloom_mask(hashes[j], bloom->k, mask);
+            silk_bloom_set(blocks[j], mask);
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief query many keys with the same length in a bloom
+ *        filter, blocks are prefetched ahead
+ * @param bloom the bloom filter
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @param results return whether each key may be in the
+ *                filter, could be NULL
+ * @return count of the keys which may be in the filter
+ *******************************************************/
+size_t silk_bloom_contains_bulk(silk_bloom_t bloom, const void* keys, size_t key_len, size_t count, bool* results)
+{
+    SILK_ASSERT(bloom != NULL, 0);
+    SILK_ASSERT(keys != NULL || count == 0, 0);
+
+    const uint8_t* p = keys;
+    uint64_t hashes[SILK_BLOOM_BATCH];
+    uint64_t* blocks[SILK_BLOOM_BATCH];
+    uint64_t mask[SILK_BLOOM_BLOCK_WORDS];
+    size_t found = 0;
+    for (size_t i = 0; i < count; i += SILK_BLOOM_BATCH)
+    {
+        size_t n = count - i < SILK_BLOOM_BATCH ? count - i : SILK_BLOOM_BATCH;
+        for (size_t j = 0; j < n; j++)
+        {
+            hashes[j] = silk_hash_wyhash(p + (i + j) * key_len, key_len, 0);
+            blocks[j] = silk_bloom_block(bloom, hashes[j]);
+            SILK_PREFETCH(blocks[j]);
+        }
+
+        for (size_t j = 0; j < n; j++)
+        {
+            silk_bloom_mask(hashes[j], bloom->k, mask);
+            bool result = silk_bloom_test(blocks[j], mask);
+            if (results != NULL)
+                results[i + j] = result;
+            found += result;
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************
+ * @brief get the size of a serialized bloom filter
+ * @param bloom the bloom filter
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_bloom_serialized_size(silk_bloom_t bloom)
+{
+    SILK_ASSERT(bloom != NULL, 0);
+
+    return SILK_BLOOM_HEADER_SIZE + bloom->count * SILK_BLOOM_BLOCK_SIZE;
+}
+
+/*******************************************************
+ * @brief serialize a bloom filter, all values are little
+ *        endian, the blocks start at offset 64
+ * @param bloom the bloom filter
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_bloom_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_bloom_serialize(silk_bloom_t bloom, void* buffer, size_t size)
+{
+    SILK_ASSERT(bloom != NULL, false);
+    SILK_ASSERT(buffer != NULL, false);
+
+    if (size < silk_bloom_serialized_size(bloom))
+        return false;
+
+    // header: magic, count of blocks, k, then zero padding
+    uint8_t* p = buffer;
+    memset(p, 0, SILK_BLOOM_HEADER_SIZE);
+    silk_endian_write_little64(p, SILK_BLOOM_MAGIC);
+    silk_endian_write_little64(p + 8, bloom->count);
+    silk_endian_write_little32(p + 16, bloom->k);
+    p += SILK_BLOOM_HEADER_SIZE;
+
+    size_t words = bloom->count * SILK_BLOOM_BLOCK_WORDS;
+    if (silk_endian_is_little())
+    {
+        memcpy(p, bloom->blocks, words * sizeof(uint64_t));
+    }
+    else
+    {
+        for (size_t i = 0; i < words; i++)
+            silk_endian_write_little64(p + i * sizeof(uint64_t), bloom->blocks[i]);
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief parse the header of a serialized bloom filter
+ * @param data the serialized data
+ * @param size size of the data
+ * @param count return count of blocks
+ * @param k return count of bits of each key
+ * @return whether the data is valid
+ *******************************************************/
+static bool silk_bloom_parse(const uint8_t* data, size_t size, size_t* count, uint32_t* k)
+{
+    if (data == NULL || size < SILK_BLOOM_HEADER_SIZE)
+        return false;
+
+    if (silk_endian_read_little64(data) != SILK_BLOOM_MAGIC)
+        return false;
+
+    uint64_t blocks = silk_endian_read_little64(data + 8);
+    uint32_t bits = silk_endian_read_little32(data + 16);
+    if (blocks == 0 || blocks > UINT32_MAX || bits == 0 || bits > SILK_BLOOM_MAX_K)
+        return false;
+
+    if (blocks > (size - SILK_BLOOM_HEADER_SIZE) / SILK_BLOOM_BLOCK_SIZE)
+        return false;
+
+    *count = (size_t)blocks;
+    *k = bits;
+    return true;
+}
+
+/*******************************************************
+ * @brief create a bloom filter from serialized data, the
+ *        data is copied
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the bloom filter, or NULL if data is invalid
+ *******************************************************/
+silk_bloom_t silk_bloom_deserialize(const void* data, size_t size)
+{
+    size_t count;
+    uint32_t k;
+    if (!silk_bloom_parse(data, size, &count, &k))
+        return NULL;
+
+    silk_bloom_t bloom = silk_bloom_alloc(count, k);
+    SILK_ASSERT(bloom != NULL, NULL);
+
+    const uint8_t* p = (const uint8_t*)data + SILK_BLOOM_HEADER_SIZE;
+    size_t words = count * SILK_BLOOM_BLOCK_WORDS;
+    if (silk_endian_is_little())
+    {
+        memcpy(bloom->blocks, p, words * sizeof(uint64_t));
+    }
+    else
+    {
+        for (size_t i = 0; i < words; i++)
+            bloom->blocks[i] = silk_endian_read_little64(p + i * sizeof(uint64_t));
+    }
+
+    return bloom;
+}
+
+/*******************************************************
+ * @brief create a read-only bloom filter on serialized
+ *        data, such as a mmap'd file, the blocks are used
+ *        in place on little endian cpus if data is 8
+ *        bytes aligned, otherwise they are copied
+ * @note  data must be kept until the filter is deleted
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the bloom filter, or NULL if data is invalid
+ *******************************************************/
+silk_bloom_t silk_bloom_view(const void* data, size_t size)
+{
+    size_t count;
+    uint32_t k;
+    if (!silk_bloom_parse(data, size, &count, &k))
+        return NULL;
+
+    silk_bloom_t bloom = NULL;
+    if (silk_endian_is_little() && ((uintptr_t)data & (sizeof(uint64_t) - 1)) == 0)
+    {
+        bloom = silk_alloc(sizeof(struct SilkBloom));
+        SILK_ASSERT(bloom != NULL, NULL);
+
+        bloom->blocks = (uint64_t*)((uintptr_t)data + SILK_BLOOM_HEADER_SIZE);
+        bloom->memory = NULL;
+        bloom->count = count;
+        bloom->k = k;
+    }
+    else
+    {
+        bloom = silk_bloom_deserialize(data, size);
+        SILK_ASSERT(bloom != NULL, NULL);
+    }
+
+    bloom->readonly = true;
+    return bloom;
+}
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include <silk/cmap.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/map.h>
+
+#include <string.h>
+
+#include "map_inner.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+    typedef SRWLOCK silk_cmap_lock_t;
+    #define SILK_CMAP_LOCK_INIT(LOCK)       (InitializeSRWLock(LOCK), 0)
+    #define SILK_CMAP_LOCK_DESTROY(LOCK)    ((void)(LOCK))
+    #define SILK_CMAP_READ_LOCK(LOCK)       AcquireSRWLockShared(LOCK)
+    #define SILK_CMAP_READ_UNLOCK(LOCK)     ReleaseSRWLockShared(LOCK)
+    #define SILK_CMAP_WRITE_LOCK(LOCK)      AcquireSRWLockExclusive(LOCK)
+    #define SILK_CMAP_WRITE_UNLOCK(LOCK)    ReleaseSRWLockExclusive(LOCK)
+#else
+    #include <pthread.h>
+    typedef pthread_rwlock_t silk_cmap_lock_t;
+    #define SILK_CMAP_LOCK_INIT(LOCK)       pthread_rwlock_init(LOCK, NULL)
+    #define SILK_CMAP_LOCK_DESTROY(LOCK)    pthread_rwlock_destroy(LOCK)
+    #define SILK_CMAP_READ_LOCK(LOCK)       pthread_rwlock_rdlock(LOCK)
+    #define SILK_CMAP_READ_UNLOCK(LOCK)     pthread_rwlock_unlock(LOCK)
+    #define SILK_CMAP_WRITE_LOCK(LOCK)      pthread_rwlock_wrlock(LOCK)
+    #define SILK_CMAP_WRITE_UNLOCK(LOCK)    pthread_rwlock_unlock(LOCK)
+#endif
+
+// default count of shards
+#define SILK_CMAP_DEFAULT_SHARDS    64
+
+// max count of shards
+#define SILK_CMAP_MAX_SHARDS        (1u << 16)
+
+// size of a cache line
+#define SILK_CMAP_CACHE_LINE        64
+
+struct SilkCmapShard
+{
+    silk_cmap_lock_t lock;
+    silk_map_t map;
+    uint8_t padding[SILK_CMAP_CACHE_LINE];  // keeps locks of shards in different cache lines
+};
+
+struct SilkCmap
+{
+    struct SilkCmapShard* shards;
+    size_t count;           // count of shards, power of 2
+    size_t key_size;
+    size_t value_size;
+};
+
+/*******************************************************
+ * @brief get the shard of a key, by the high 32 bits of
+ *        the hash, the map in the shard uses the low bits
+ * @param cmap the map
+ * @param key the key
+ * @param hash return the hash for the map in the shard,
+ *             so the key is hashed once
+ * @return the shard
+ *******************************************************/
+static inline struct SilkCmapShard* silk_cmap_shard(silk_cmap_t cmap, const void* key, uint32_t* hash)
+{
+    uint64_t full = silk_hash_wyhash(key, cmap->key_size, 0);
+    *hash = silk_map_hash_fold(full);
+    return &cmap->shards[(full >> 32) & (cmap->count - 1)];
+}
+
+/*******************************************************
+ * @brief copy the value of a key out of a shard, it must
+ *        be locked
+ * @param cmap the map
+ * @param shard the shard
+ * @param key the key
+ * @param hash the hash for the map in the shard
+ * @param value return the value, nullable
+ * @return whether the key is in the shard
+ *******************************************************/
+static inline bool silk_cmap_shard_get(silk_cmap_t cmap, struct SilkCmapShard* shard, const void* key, uint32_t hash, void* value)
+{
+    const void* slot = silk_map_find_hashed(shard->map, key, hash);
+    if (slot == NULL)
+        return false;
+
+    if (value != NULL && cmap->value_size > 0)
+        memcpy(value, slot, cmap->value_size);
+    return true;
+}
+
+/*******************************************************
+ * @brief put a copy of the value of a key into a shard,
+ *        it must be locked
+ * @param cmap the map
+ * @param shard the shard
+ * @param key the key
+ * @param hash the hash for the map in the shard
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+static inline bool silk_cmap_shard_put(silk_cmap_t cmap, struct SilkCmapShard* shard, const void* key, uint32_t hash, const void* value)
+{
+    void* slot = silk_map_emplace_hashed(shard->map, key, hash, NULL);
+    if (slot == NULL)
+        return false;
+
+    if (cmap->value_size > 0)
+        memcpy(slot, value, cmap->value_size);
+    return true;
+}
+
+/*******************************************************
+ * @brief destroy the first count shards
+ * @param cmap the map
+ * @param count count of the shards to be destroyed
+ *******************************************************/
+static void silk_cmap_destroy(silk_cmap_t cmap, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        SILK_CMAP_LOCK_DESTROY(&cmap->shards[i].lock);
+        silk_map_delete(cmap->shards[i].map);
+    }
+}
+
+/*******************************************************
+ * @brief create a concurrent hash map, which could be
+ *        accessed by many threads
+ * @note  keys are distributed into shards by hash, each
+ *        shard is a silk_map_t guarded by a read-write
+ *        lock, so threads accessing different shards do
+ *        not block each other, and readers of the same
+ *        shard do not block each other
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @param shards count of shards, rounded up to power of 2,
+ *               0 to use the default 64, it should be
+ *               several times the count of threads
+ * @return the map
+ *******************************************************/
+silk_cmap_t silk_cmap_new(size_t key_size, size_t value_size, size_t shards)
+{
+    SILK_ASSERT(key_size > 0, NULL);
+    SILK_ASSERT(shards <= SILK_CMAP_MAX_SHARDS, NULL);
+
+    size_t count = 1;
+    while (count < (shards == 0 ? SILK_CMAP_DEFAULT_SHARDS : shards))
+        count *= 2;
+
+    silk_cmap_t cmap = silk_alloc(sizeof(struct SilkCmap));
+    SILK_ASSERT(cmap != NULL, NULL);
+
+    cmap->shards = silk_alloc(sizeof(struct SilkCmapShard) * count);
+    SILK_ASSERT(cmap->shards != NULL, silk_free(cmap), NULL);
+
+    cmap->count = count;
+    cmap->key_size = key_size;
+    cmap->value_size = value_size;
+    for (size_t i = 0; i < count; i++)
+    {
+        cmap->shards[i].map = silk_map_new(key_size, value_size);
+        SILK_ASSERT(cmap->shards[i].map != NULL, silk_cmap_destroy(cmap, i), silk_free(cmap->shards), silk_free(cmap), NULL);
+
+        bool initialized = SILK_CMAP_LOCK_INIT(&cmap->shards[i].lock) == 0;
+        SILK_ASSERT(initialized, silk_map_delete(cmap->shards[i].map), silk_cmap_destroy(cmap, i), silk_free(cmap->shards), silk_free(cmap), NULL);
+    }
+
+    return cmap;
+}
+
+/*******************************************************
+ * @brief delete a concurrent hash map, no thread may be
+ *        accessing it
+ * @param cmap the map to be deleted
+ *******************************************************/
+void silk_cmap_delete(silk_cmap_t cmap)
+{
+    SILK_ASSERT(cmap != NULL);
+
+    silk_cmap_destroy(cmap, cmap->count);
+    silk_free(cmap->shards);
+    silk_free(cmap);
+}
+
+/*******************************************************
+ * @brief clear a concurrent hash map, shard by shard
+ * @param cmap the map to be cleared
+ *******************************************************/
+void silk_cmap_clear(silk_cmap_t cmap)
+{
+    SILK_ASSERT(cmap != NULL);
+
+    for (size_t i = 0; i < cmap->count; i++)
+    {
+        SILK_CMAP_WRITE_LOCK(&cmap->shards[i].lock);
+        silk_map_clear(cmap->shards[i].map);
+        SILK_CMAP_WRITE_UNLOCK(&cmap->shards[i].lock);
+    }
+}
+
+/*******************************************************
+ * @brief get the count of entries of a concurrent hash
+ *        map, shards are counted one by one, so it is not
+ *        a snapshot while other threads are modifying it
+ * @param cmap the map
+ * @return the count of entries
+ *******************************************************/
+size_t silk_cmap_length(silk_cmap_t cmap)
+{
+    SILK_ASSERT(cmap != NULL, 0);
+
+    size_t length = 0;
+    for (size_t i = 0; i < cmap->count; i++)
+    {
+        SILK_CMAP_READ_LOCK(&cmap->shards[i].lock);
+        length += silk_map_length(cmap->shards[i].map);
+        SILK_CMAP_READ_UNLOCK(&cmap->shards[i].lock);
+    }
+    return length;
+}
+
+/*******************************************************
+ * @brief insert an entry into a concurrent hash map, the
+ *        value is replaced if the key is already in it
+ * @param cmap the map
+ * @param key the key
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_cmap_put(silk_cmap_t cmap, const void* key, const void* value)
+{
+    SILK_ASSERT(cmap != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+    SILK_ASSERT(value != NULL || cmap->value_size == 0, false);
+
+    uint32_t hash;
+    struct SilkCmapShard* shard = silk_cmap_shard(cmap, key, &hash);
+    SILK_CMAP_WRITE_LOCK(&shard->lock);
+    bool result = silk_cmap_shard_put(cmap, shard, key, hash, value);
+    SILK_CMAP_WRITE_UNLOCK(&shard->lock);
+    return result;
+}
+
+/*******************************************************
+ * @brief get a copy of the value of a key
+ * @param cmap the map
+ * @param key the key
+ * @param value return the value, nullable
+ * @return whether the key is in the map
+ *******************************************************/
+bool silk_cmap_get(silk_cmap_t cmap, const void* key, void* value)
+{
+    SILK_ASSERT(cmap != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+
+    uint32_t hash;
+    struct SilkCmapShard* shard = silk_cmap_shard(cmap, key, &hash);
+    SILK_CMAP_READ_LOCK(&shard->lock);
+    bool result = silk_cmap_shard_get(cmap, shard, key, hash, value);
+    SILK_CMAP_READ_UNLOCK(&shard->lock);
+    return result;
+}
+
+/*******************************************************
+ * @brief remove an entry from a concurrent hash map
+ * @param cmap the map
+ * @param key the key
+ * @return whether it is removed, false if the key is not
+ *         in the map
+ *******************************************************/
+bool silk_cmap_erase(silk_cmap_t cmap, const void* key)
+{
+    SILK_ASSERT(cmap != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+
+    uint32_t hash;
+    struct SilkCmapShard* shard = silk_cmap_shard(cmap, key, &hash);
+    SILK_CMAP_WRITE_LOCK(&shard->lock);
+    bool result = silk_map_erase_hashed(shard->map, key, hash);
+    SILK_CMAP_WRITE_UNLOCK(&shard->lock);
+    return result;
+}
+
+/*******************************************************
+ * @brief get the value of a key, insert the value by
+ *        compute if the key is not in the map, compute is
+ *        called at most once among all threads for a key
+ *        until it is erased
+ * @note  compute is called with the shard of the key
+ *        write locked, it must not access the same map,
+ *        or it deadlocks
+ * @param cmap the map
+ * @param key the key
+ * @param compute the callback to compute the value
+ * @param data the data passed to compute
+ * @param value return the value, either found or
+ *              computed, not nullable
+ * @return whether the key is in the map after all, false
+ *         if compute declines or it fails
+ *******************************************************/
+bool silk_cmap_compute_if_absent(silk_cmap_t cmap, const void* key, silk_cmap_compute_t compute, void* data, void* value)
+{
+    SILK_ASSERT(cmap != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+    SILK_ASSERT(compute != NULL, false);
+    SILK_ASSERT(value != NULL, false);
+
+    // most keys are present, so try with the read lock first
+    uint32_t hash;
+    struct SilkCmapShard* shard = silk_cmap_shard(cmap, key, &hash);
+    SILK_CMAP_READ_LOCK(&shard->lock);
+    bool found = silk_cmap_shard_get(cmap, shard, key, hash, value);
+    SILK_CMAP_READ_UNLOCK(&shard->lock);
+    if (found)
+        return true;
+
+    // another thread could insert it between the locks, so check again
+    SILK_CMAP_WRITE_LOCK(&shard->lock);
+    bool result = silk_cmap_shard_get(cmap, shard, key, hash, value);
+    if (!result && compute(key, value, data))
+        result = silk_cmap_shard_put(cmap, shard, key, hash, value);
+    SILK_CMAP_WRITE_UNLOCK(&shard->lock);
+    return result;
+}
\ No newline at end of file
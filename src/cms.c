@@ -0,0 +1,325 @@
+#include <silk/cms.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+#define SILK_CMS_MAX_DEPTH  16
+
+struct SilkCmsEntry
+{
+    uint8_t* data;          // copy of the key
+    size_t len;
+    uint32_t count;
+    uint32_t fingerprint;   // hash of the first row, to skip comparing most keys
+};
+
+struct SilkCms
+{
+    uint32_t* counters;     // depth rows of width counters
+    size_t width;           // power of 2
+    size_t depth;
+    uint64_t total;
+    uint32_t seeds[SILK_CMS_MAX_DEPTH];
+    struct SilkCmsEntry* heap;  // min-heap of heavy hitters by count
+    size_t heap_length;
+    size_t heap_capacity;
+};
+
+/*******************************************************
+ * @brief swap two entries of the heap
+ * @param heap the heap
+ * @param i an index
+ * @param j an index
+ *******************************************************/
+static inline void silk_cms_heap_swap(struct SilkCmsEntry* heap, size_t i, size_t j)
+{
+    struct SilkCmsEntry temp = heap[i];
+    heap[i] = heap[j];
+    heap[j] = temp;
+}
+
+/*******************************************************
+ * @brief move an entry up until its parent is not larger
+ * @param cms the sketch
+ * @param i index of the entry
+ *******************************************************/
+static void silk_cms_heap_up(silk_cms_t cms, size_t i)
+{
+    while (i > 0 && cms->heap[(i - 1) / 2].count > cms->heap[i].count)
+    {
+        silk_cms_heap_swap(cms->heap, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/*******************************************************
+ * @brief move an entry down until its children are not
+ *        smaller
+ * @param cms the sketch
+ * @param i index of the entry
+ *******************************************************/
+static void silk_cms_heap_down(silk_cms_t cms, size_t i)
+{
+    for (;;)
+    {
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = 2 * i + 2;
+        if (left < cms->heap_length && cms->heap[left].count < cms->heap[smallest].count)
+            smallest = left;
+        if (right < cms->heap_length && cms->heap[right].count < cms->heap[smallest].count)
+            smallest = right;
+        if (smallest == i)
+            return;
+
+        silk_cms_heap_swap(cms->heap, i, smallest);
+        i = smallest;
+    }
+}
+
+/*******************************************************
+ * @brief track a key in the heavy hitters
+ * @param cms the sketch
+ * @param data the key
+ * @param len length of the key
+ * @param count the estimated count of the key
+ * @param fingerprint hash of the key
+ *******************************************************/
+static void silk_cms_track(silk_cms_t cms, const void* data, size_t len, uint32_t count, uint32_t fingerprint)
+{
+    // a key in the heap has count not less than the minimum, so most keys stop here
+    bool full = cms->heap_length == cms->heap_capacity;
+    if (full && count <= cms->heap[0].count)
+        return;
+
+    for (size_t i = 0; i < cms->heap_length; i++)
+    {
+        struct SilkCmsEntry* entry = &cms->heap[i];
+        if (entry->fingerprint == fingerprint && entry->len == len && memcmp(entry->data, data, len) == 0)
+        {
+            entry->count = count;
+            silk_cms_heap_down(cms, i);
+            return;
+        }
+    }
+
+    uint8_t* copy = silk_alloc(len > 0 ? len : 1);
+    SILK_ASSERT(copy != NULL);
+    if (len > 0)
+        silk_copy(copy, data, len);
+
+    struct SilkCmsEntry entry = {copy, len, count, fingerprint};
+    if (full)
+    {
+        // replace the minimum
+        silk_free(cms->heap[0].data);
+        cms->heap[0] = entry;
+        silk_cms_heap_down(cms, 0);
+    }
+    else
+    {
+        cms->heap[cms->heap_length] = entry;
+        cms->heap_length++;
+        silk_cms_heap_up(cms, cms->heap_length - 1);
+    }
+}
+
+/*******************************************************
+ * @brief create a count-min sketch
+ * @note  a key is counted in one counter of each row, the
+ *        estimate is the minimum of them, it is never less
+ *        than the real count, and exceeds it by at most
+ *        e / width * total with probability 1 - e^-depth,
+ *        counters saturate at UINT32_MAX
+ *        see: https://en.wikipedia.org/wiki/Count%E2%80%93min_sketch
+ * @param width count of counters of each row, rounded up
+ *              to power of 2
+ * @param depth count of rows, 1 to 16
+ * @param topk count of heavy hitters to be tracked, 0
+ *             to disable, they are scanned linearly so it
+ *             should be small
+ * @return the sketch
+ *******************************************************/
+silk_cms_t silk_cms_new(size_t width, size_t depth, size_t topk)
+{
+    SILK_ASSERT(width > 0 && width <= ((size_t)1 << 31), NULL);
+    SILK_ASSERT(depth > 0 && depth <= SILK_CMS_MAX_DEPTH, NULL);
+
+    size_t power = 1;
+    while (power < width)
+        power *= 2;
+
+    silk_cms_t cms = silk_alloc(sizeof(struct SilkCms));
+    SILK_ASSERT(cms != NULL, NULL);
+
+    cms->counters = silk_alloc(sizeof(uint32_t) * power * depth);
+    SILK_ASSERT(cms->counters != NULL, silk_free(cms), NULL);
+
+    cms->heap = NULL;
+    if (topk > 0)
+    {
+        cms->heap = silk_alloc(sizeof(struct SilkCmsEntry) * topk);
+        SILK_ASSERT(cms->heap != NULL, silk_free(cms->counters), silk_free(cms), NULL);
+    }
+
+    // a different seed of each row makes the rows independent
+    for (size_t i = 0; i < depth; i++)
+        cms->seeds[i] = (uint32_t)(0x9e3779b9u * (i + 1));
+
+    memset(cms->counters, 0, sizeof(uint32_t) * power * depth);
+    cms->width = power;
+    cms->depth = depth;
+    cms->total = 0;
+    cms->heap_length = 0;
+    cms->heap_capacity = topk;
+    return cms;
+}
+
+/*******************************************************
+ * @brief delete a count-min sketch
+ * @param cms the sketch to be deleted
+ *******************************************************/
+void silk_cms_delete(silk_cms_t cms)
+{
+    SILK_ASSERT(cms != NULL);
+
+    silk_cms_clear(cms);
+    if (cms->heap != NULL)
+        silk_free(cms->heap);
+    silk_free(cms->counters);
+    silk_free(cms);
+}
+
+/*******************************************************
+ * @brief clear a count-min sketch, and the heavy hitters
+ * @param cms the sketch to be cleared
+ *******************************************************/
+void silk_cms_clear(silk_cms_t cms)
+{
+    SILK_ASSERT(cms != NULL);
+
+    for (size_t i = 0; i < cms->heap_length; i++)
+        silk_free(cms->heap[i].data);
+
+    memset(cms->counters, 0, sizeof(uint32_t) * cms->width * cms->depth);
+    cms->heap_length = 0;
+    cms->total = 0;
+}
+
+/*******************************************************
+ * @brief add occurrences of a key into a count-min sketch
+ *        by conservative update, only the counters which
+ *        are less than the new estimate are raised
+ * @param cms the sketch
+ * @param data the key
+ * @param len length of the key
+ * @param count count of occurrences
+ * @return the estimated count of the key after adding
+ *******************************************************/
+uint32_t silk_cms_add(silk_cms_t cms, const void* data, size_t len, uint32_t count)
+{
+    SILK_ASSERT(cms != NULL, 0);
+    SILK_ASSERT(data != NULL || len == 0, 0);
+
+    // hashes of all rows in SIMD lanes
+    uint32_t hashes[SILK_CMS_MAX_DEPTH];
+    uint32_t* counters[SILK_CMS_MAX_DEPTH];
+    silk_hash_murmur3_32_seeds(data, len, cms->seeds, cms->depth, hashes);
+
+    uint32_t estimate = UINT32_MAX;
+    for (size_t i = 0; i < cms->depth; i++)
+    {
+        counters[i] = &cms->counters[i * cms->width + (hashes[i] & (cms->width - 1))];
+        if (*counters[i] < estimate)
+            estimate = *counters[i];
+    }
+
+    estimate = estimate > UINT32_MAX - count ? UINT32_MAX : estimate + count;
+    for (size_t i = 0; i < cms->depth; i++)
+    {
+        if (*counters[i] < estimate)
+            *counters[i] = estimate;
+    }
+
+    cms->total += count;
+    if (cms->heap_capacity > 0)
+        silk_cms_track(cms, data, len, estimate, hashes[0]);
+
+    return estimate;
+}
+
+/*******************************************************
+ * @brief estimate the count of a key
+ * @param cms the sketch
+ * @param data the key
+ * @param len length of the key
+ * @return the estimated count, not less than the real one
+ *******************************************************/
+uint32_t silk_cms_estimate(silk_cms_t cms, const void* data, size_t len)
+{
+    SILK_ASSERT(cms != NULL, 0);
+    SILK_ASSERT(data != NULL || len == 0, 0);
+
+    uint32_t hashes[SILK_CMS_MAX_DEPTH];
+    silk_hash_murmur3_32_seeds(data, len, cms->seeds, cms->depth, hashes);
+
+    uint32_t estimate = UINT32_MAX;
+    for (size_t i = 0; i < cms->depth; i++)
+    {
+        uint32_t counter = cms->counters[i * cms->width + (hashes[i] & (cms->width - 1))];
+        if (counter < estimate)
+            estimate = counter;
+    }
+    return estimate;
+}
+
+/*******************************************************
+ * @brief get the total count of all added occurrences
+ * @param cms the sketch
+ * @return the total count
+ *******************************************************/
+uint64_t silk_cms_total(silk_cms_t cms)
+{
+    SILK_ASSERT(cms != NULL, 0);
+
+    return cms->total;
+}
+
+/*******************************************************
+ * @brief get the heavy hitters, the keys with the largest
+ *        estimated counts, sorted by count descending
+ * @param cms the sketch
+ * @param items return the heavy hitters
+ * @param count max count of items
+ * @return count of items returned
+ *******************************************************/
+size_t silk_cms_top(silk_cms_t cms, silk_cms_item_t* items, size_t count)
+{
+    SILK_ASSERT(cms != NULL, 0);
+    SILK_ASSERT(items != NULL || count == 0, 0);
+
+    // insertion into the sorted items, the heap is small
+    size_t n = 0;
+    for (size_t i = 0; i < cms->heap_length; i++)
+    {
+        const struct SilkCmsEntry* entry = &cms->heap[i];
+        size_t pos = n;
+        while (pos > 0 && items[pos - 1].count < entry->count)
+            pos--;
+        if (pos >= count)
+            continue;
+
+        size_t last = n < count ? n : count - 1;
+        for (size_t j = last; j > pos; j--)
+            items[j] = items[j - 1];
+
+        items[pos].data = entry->data;
+        items[pos].len = entry->len;
+        items[pos].count = entry->count;
+        if (n < count)
+            n++;
+    }
+
+    return n;
+}
\ No newline at end of file
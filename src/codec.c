@@ -0,0 +1,515 @@
+#include <silk/codec.h>
+#include <silk/cpu.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
+// value of invalid chars in the decoding tables
+#define SILK_CODEC_INVALID      0xFF
+
+static const char silk_base64_alphabet[65] = 
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const char silk_hex_alphabet[17] = "0123456789abcdef";
+
+// value of each char of the alphabets, SILK_CODEC_INVALID for others
+static const uint8_t silk_base64_values[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t silk_hex_values[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+#if defined(SILK_CPU_X86)
+/* 
+ * The SSSE3 kernels are from Wojciech Mula and Daniel Lemire,
+ * see: https://arxiv.org/abs/1704.00605 and http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+ */
+
+/*******************************************************
+ * @brief encode 12 bytes to 16 chars by SSSE3
+ * @param dst the text
+ * @param src the data, 16 bytes are read
+ *******************************************************/
+SILK_TARGET("ssse3")
+static void silk_base64_encode_block_ssse3(char* dst, const uint8_t* src)
+{
+    const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, 
+                                            '/' - 63, 'A', 0, 0);
+    __m128i input = _mm_loadu_si128((const __m128i*)src);
+
+    // spread every 3 bytes into 4 lanes of 6 bits
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(t0, t1);
+
+    // map 0-25, 26-51, 52-61, 62 and 63 to their offsets in shift_lut
+    __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    offsets = _mm_or_si128(offsets, _mm_and_si128(less, _mm_set1_epi8(13)));
+    __m128i output = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, offsets), indices);
+    _mm_storeu_si128((__m128i*)dst, output);
+}
+
+/*******************************************************
+ * @brief decode 16 chars to 12 bytes by SSSE3
+ * @param dst the data, 12 bytes are written
+ * @param src the text
+ * @return whether the chars are valid
+ *******************************************************/
+SILK_TARGET("ssse3")
+static bool silk_base64_decode_block_ssse3(uint8_t* dst, const char* src)
+{
+    const __m128i lut_low = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 
+                                          0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_high = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i input = _mm_loadu_si128((const __m128i*)src);
+    __m128i high = _mm_and_si128(_mm_srli_epi32(input, 4), nibble);
+    __m128i low = _mm_and_si128(input, nibble);
+
+    // a char is valid if the bits of its nibbles do not intersect
+    __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lut_low, low), _mm_shuffle_epi8(lut_high, high));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF)
+        return false;
+
+    // '/' shares the high nibble with '+', pick its own offset
+    __m128i eq_slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+    __m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_slash, high)));
+
+    // pack 4 lanes of 6 bits into 3 bytes
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storel_epi64((__m128i*)dst, merged);
+    uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(merged, 8));
+    memcpy(dst + 8, &tail, sizeof(tail));
+    return true;
+}
+
+/*******************************************************
+ * @brief encode 16 bytes to 32 hex chars by SSSE3
+ * @param dst the text
+ * @param src the data
+ *******************************************************/
+SILK_TARGET("ssse3")
+static void silk_hex_encode_block_ssse3(char* dst, const uint8_t* src)
+{
+    const __m128i lut = _mm_loadu_si128((const __m128i*)silk_hex_alphabet);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i input = _mm_loadu_si128((const __m128i*)src);
+    __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(input, nibble));
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi8(high, low));
+}
+
+/*******************************************************
+ * @brief get values of 16 hex chars by SSSE3
+ * @param input the chars
+ * @param valid return 0 in lanes of invalid chars
+ * @return the values
+ *******************************************************/
+SILK_TARGET("ssse3")
+static inline __m128i silk_hex_values_ssse3(__m128i input, __m128i* valid)
+{
+    // unsigned x <= limit is min(x, limit) == x
+    __m128i digit = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(input, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    *valid = _mm_or_si128(is_digit, is_letter);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit), 
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+/*******************************************************
+ * @brief decode 32 hex chars to 16 bytes by SSSE3
+ * @param dst the data
+ * @param src the text
+ * @return whether the chars are valid
+ *******************************************************/
+SILK_TARGET("ssse3")
+static bool silk_hex_decode_block_ssse3(uint8_t* dst, const char* src)
+{
+    __m128i valid0, valid1;
+    __m128i values0 = silk_hex_values_ssse3(_mm_loadu_si128((const __m128i*)src), &valid0);
+    __m128i values1 = silk_hex_values_ssse3(_mm_loadu_si128((const __m128i*)(src + 16)), &valid1);
+    if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF)
+        return false;
+
+    // high * 16 + low of each pair
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    __m128i bytes0 = _mm_maddubs_epi16(values0, weights);
+    __m128i bytes1 = _mm_maddubs_epi16(values1, weights);
+    _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(bytes0, bytes1));
+    return true;
+}
+#endif
+
+/*******************************************************
+ * @brief get length of base64 text of data
+ * @param len length of the data
+ * @return length of the text, with padding
+ *******************************************************/
+size_t silk_base64_encode_length(size_t len)
+{
+    return (len + 2) / 3 * 4;
+}
+
+/*******************************************************
+ * @brief get max length of data decoded from base64 text
+ * @param len length of the text
+ * @return max length of the data
+ *******************************************************/
+size_t silk_base64_decode_length(size_t len)
+{
+    return len / 4 * 3 + (len % 4) * 3 / 4;
+}
+
+/*******************************************************
+ * @brief encode data to base64 text, RFC 4648 alphabet
+ *        with padding
+ * @param dst the buffer of text, at least 
+ *            silk_base64_encode_length(len) bytes, no '\0'
+ *            is written
+ * @param src the data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_base64_encode(char* dst, const void* src, size_t len)
+{
+    SILK_ASSERT(dst != NULL || len == 0, 0);
+    SILK_ASSERT(src != NULL || len == 0, 0);
+
+    const uint8_t* data = src;
+    char* p = dst;
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSSE3))
+    {
+        // the kernel reads 16 bytes for 12
+        for (; len - i >= 16; i += 12, p += 16)
+            silk_base64_encode_block_ssse3(p, data + i);
+    }
+#endif
+
+    for (; len - i >= 3; i += 3, p += 4)
+    {
+        uint32_t triple = ((uint32_t)data[i] << 16) | ((uint32_t)data[i + 1] << 8) | data[i + 2];
+        p[0] = silk_base64_alphabet[(triple >> 18) & 0x3F];
+        p[1] = silk_base64_alphabet[(triple >> 12) & 0x3F];
+        p[2] = silk_base64_alphabet[(triple >> 6) & 0x3F];
+        p[3] = silk_base64_alphabet[triple & 0x3F];
+    }
+
+    if (len - i == 1)
+    {
+        p[0] = silk_base64_alphabet[data[i] >> 2];
+        p[1] = silk_base64_alphabet[(data[i] & 0x03) << 4];
+        p[2] = '=';
+        p[3] = '=';
+        p += 4;
+    }
+    else if (len - i == 2)
+    {
+        p[0] = silk_base64_alphabet[data[i] >> 2];
+        p[1] = silk_base64_alphabet[((data[i] & 0x03) << 4) | (data[i + 1] >> 4)];
+        p[2] = silk_base64_alphabet[(data[i + 1] & 0x0F) << 2];
+        p[3] = '=';
+        p += 4;
+    }
+
+    return (size_t)(p - dst);
+}
+
+/*******************************************************
+ * @brief decode base64 text to data, padding is optional
+ *        and whitespace is not allowed
+ * @param dst the buffer of data, at least 
+ *            silk_base64_decode_length(len) bytes
+ * @param src the text
+ * @param len length of the text
+ * @return length of the data, or SILK_INVALID_INDEX if 
+ *         the text is invalid
+ *******************************************************/
+size_t silk_base64_decode(void* dst, const char* src, size_t len)
+{
+    SILK_ASSERT(dst != NULL || len == 0, SILK_INVALID_INDEX);
+    SILK_ASSERT(src != NULL || len == 0, SILK_INVALID_INDEX);
+
+    // padding must complete the last quantum
+    if (len > 0 && len % 4 == 0 && src[len - 1] == '=')
+        len -= src[len - 2] == '=' ? 2 : 1;
+
+    if (len % 4 == 1)
+        return SILK_INVALID_INDEX;
+
+    uint8_t* p = dst;
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSSE3))
+    {
+        for (; len - i >= 16; i += 16, p += 12)
+        {
+            if (!silk_base64_decode_block_ssse3(p, src + i))
+                return SILK_INVALID_INDEX;
+        }
+    }
+#endif
+
+    for (; i < len; i += 4)
+    {
+        size_t n = len - i < 4 ? len - i : 4;
+        uint32_t quad = 0;
+        uint8_t bad = 0;
+        for (size_t k = 0; k < 4; k++)
+        {
+            uint8_t value = k < n ? silk_base64_values[(uint8_t)src[i + k]] : 0;
+            bad |= value;
+            quad = (quad << 6) | (value & 0x3F);
+        }
+
+        // only SILK_CODEC_INVALID has the highest bit
+        if (bad & 0x80)
+            return SILK_INVALID_INDEX;
+
+        p[0] = (uint8_t)(quad >> 16);
+        if (n > 2)
+            p[1] = (uint8_t)(quad >> 8);
+        if (n > 3)
+            p[2] = (uint8_t)quad;
+        p += n - 1;
+    }
+
+    return (size_t)(p - (uint8_t*)dst);
+}
+
+/*******************************************************
+ * @brief encode data to base64 text and append it into 
+ *        a string
+ * @param str the string
+ * @param src the data
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_base64_encode_string(silk_string_t str, const void* src, size_t len)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    size_t length = silk_string_length(str);
+    SILK_ASSERT(silk_string_resize(str, length + silk_base64_encode_length(len)), false);
+
+    silk_base64_encode(silk_string_data(str) + length, src, len);
+    return true;
+}
+
+/*******************************************************
+ * @brief decode base64 text and append the data into a
+ *        string, the string is not changed if it fails
+ * @param str the string
+ * @param src the text
+ * @param len length of the text
+ * @return whether it is successful
+ *******************************************************/
+bool silk_base64_decode_string(silk_string_t str, const char* src, size_t len)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    size_t length = silk_string_length(str);
+    SILK_ASSERT(silk_string_reserve(str, length + silk_base64_decode_length(len)), false);
+
+    size_t n = silk_base64_decode(silk_string_data(str) + length, src, len);
+    if (n == SILK_INVALID_INDEX)
+    {
+        silk_string_data(str)[length] = '\0';
+        return false;
+    }
+
+    return silk_string_resize(str, length + n);
+}
+
+/*******************************************************
+ * @brief get length of hex text of data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_hex_encode_length(size_t len)
+{
+    return len * 2;
+}
+
+/*******************************************************
+ * @brief get max length of data decoded from hex text
+ * @param len length of the text
+ * @return max length of the data
+ *******************************************************/
+size_t silk_hex_decode_length(size_t len)
+{
+    return len / 2;
+}
+
+/*******************************************************
+ * @brief encode data to lowercase hex text
+ * @param dst the buffer of text, at least 
+ *            silk_hex_encode_length(len) bytes, no '\0'
+ *            is written
+ * @param src the data
+ * @param len length of the data
+ * @return length of the text
+ *******************************************************/
+size_t silk_hex_encode(char* dst, const void* src, size_t len)
+{
+    SILK_ASSERT(dst != NULL || len == 0, 0);
+    SILK_ASSERT(src != NULL || len == 0, 0);
+
+    const uint8_t* data = src;
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSSE3))
+    {
+        for (; len - i >= 16; i += 16)
+            silk_hex_encode_block_ssse3(dst + i * 2, data + i);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        dst[i * 2] = silk_hex_alphabet[data[i] >> 4];
+        dst[i * 2 + 1] = silk_hex_alphabet[data[i] & 0x0F];
+    }
+
+    return len * 2;
+}
+
+/*******************************************************
+ * @brief decode hex text to data, both cases are accepted
+ * @param dst the buffer of data, at least 
+ *            silk_hex_decode_length(len) bytes
+ * @param src the text
+ * @param len length of the text
+ * @return length of the data, or SILK_INVALID_INDEX if 
+ *         the text is invalid
+ *******************************************************/
+size_t silk_hex_decode(void* dst, const char* src, size_t len)
+{
+    SILK_ASSERT(dst != NULL || len == 0, SILK_INVALID_INDEX);
+    SILK_ASSERT(src != NULL || len == 0, SILK_INVALID_INDEX);
+
+    if (len % 2 != 0)
+        return SILK_INVALID_INDEX;
+
+    uint8_t* data = dst;
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (len >= 32 && silk_cpu_supports(SILK_CPU_SSSE3))
+    {
+        for (; len - i >= 32; i += 32)
+        {
+            if (!silk_hex_decode_block_ssse3(data + i / 2, src + i))
+                return SILK_INVALID_INDEX;
+        }
+    }
+#endif
+
+    for (; i < len; i += 2)
+    {
+        uint8_t high = silk_hex_values[(uint8_t)src[i]];
+        uint8_t low = silk_hex_values[(uint8_t)src[i + 1]];
+        if ((high | low) == SILK_CODEC_INVALID)
+            return SILK_INVALID_INDEX;
+        data[i / 2] = (uint8_t)((high << 4) | low);
+    }
+
+    return len / 2;
+}
+
+/*******************************************************
+ * @brief encode data to hex text and append it into
+ *        a string
+ * @param str the string
+ * @param src the data
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hex_encode_string(silk_string_t str, const void* src, size_t len)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    size_t length = silk_string_length(str);
+    SILK_ASSERT(silk_string_resize(str, length + silk_hex_encode_length(len)), false);
+
+    silk_hex_encode(silk_string_data(str) + length, src, len);
+    return true;
+}
+
+/*******************************************************
+ * @brief decode hex text and append the data into a
+ *        string, the string is not changed if it fails
+ * @param str the string
+ * @param src the text
+ * @param len length of the text
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hex_decode_string(silk_string_t str, const char* src, size_t len)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    size_t length = silk_string_length(str);
+    SILK_ASSERT(silk_string_reserve(str, length + silk_hex_decode_length(len)), false);
+
+    size_t n = silk_hex_decode(silk_string_data(str) + length, src, len);
+    if (n == SILK_INVALID_INDEX)
+    {
+        silk_string_data(str)[length] = '\0';
+        return false;
+    }
+
+    return silk_string_resize(str, length + n);
+}
\ No newline at end of file
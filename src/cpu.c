@@ -0,0 +1,135 @@
+#include <silk/cpu.h>
+
+#if defined(SILK_CPU_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+// set once the features are detected, it is in the same word as the features
+#define SILK_CPU_DETECTED   (1u << 31)
+
+// features with SILK_CPU_DETECTED, one word is read and written at once, so a
+// thread sees either 0 or the whole value, never the flag without the features
+static uint32_t silk_inner_cpu_features = 0;
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief execute cpuid
+ * @param leaf the leaf, eax
+ * @param subleaf the sub-leaf, ecx
+ * @param regs return eax, ebx, ecx and edx
+ *******************************************************/
+static void silk_cpu_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = (uint32_t)info[i];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/*******************************************************
+ * @brief read the extended control register 0
+ * @return the value of XCR0
+ *******************************************************/
+static uint64_t silk_cpu_xgetbv(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
+/*******************************************************
+ * @brief detect the instruction sets of the cpu
+ * @return the features, bits of SILK_CPU_*
+ *******************************************************/
+static uint32_t silk_cpu_detect(void)
+{
+    uint32_t features = 0;
+#if defined(SILK_CPU_X86)
+    uint32_t regs[4];
+    silk_cpu_cpuid(0, 0, regs);
+    uint32_t max_leaf = regs[0];
+    if (max_leaf < 1)
+        return 0;
+
+    silk_cpu_cpuid(1, 0, regs);
+    if (regs[3] & (1u << 26))
+        features |= SILK_CPU_SSE2;
+    if (regs[2] & (1u << 9))
+        features |= SILK_CPU_SSSE3;
+    if (regs[2] & (1u << 19))
+        features |= SILK_CPU_SSE41;
+    if (regs[2] & (1u << 20))
+        features |= SILK_CPU_SSE42;
+    if (regs[2] & (1u << 1))
+        features |= SILK_CPU_PCLMUL;
+
+    // AVX registers must be saved by the OS as well
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx = (regs[2] & (1u << 28)) != 0;
+    if (max_leaf >= 7 && osxsave && avx && (silk_cpu_xgetbv() & 0x6) == 0x6)
+    {
+        silk_cpu_cpuid(7, 0, regs);
+        if (regs[1] & (1u << 5))
+            features |= SILK_CPU_AVX2;
+    }
+#endif
+    return features;
+}
+
+/*******************************************************
+ * @brief get the instruction sets supported by the cpu,
+ *        detected once at the first call
+ * @return the features, bits of SILK_CPU_*
+ *******************************************************/
+uint32_t silk_cpu_features(void)
+{
+    // racing threads detect and store the same word
+    uint32_t features = silk_inner_cpu_features;
+    if (!(features & SILK_CPU_DETECTED))
+    {
+        features = silk_cpu_detect() | SILK_CPU_DETECTED;
+        silk_inner_cpu_features = features;
+    }
+    return features & ~SILK_CPU_DETECTED;
+}
+
+/*******************************************************
+ * @brief determine whether the cpu supports all features
+ * @param features bits of SILK_CPU_*
+ * @return whether all features are supported
+ *******************************************************/
+bool silk_cpu_supports(uint32_t features)
+{
+    return (silk_cpu_features() & features) == features;
+}
+
+/*******************************************************
+ * @brief set the instruction sets used by the library
+ * @note  only features detected on the cpu are kept,
+ *        it is used to fall back to slower code paths,
+ *        the features are process-wide and written
+ *        without synchronization, so it is not
+ *        thread-safe, it must not be called while other
+ *        threads use the library
+ * @param features bits of SILK_CPU_*
+ * @return the old features
+ *******************************************************/
+uint32_t silk_cpu_set_features(uint32_t features)
+{
+    uint32_t old = silk_cpu_features();
+    silk_inner_cpu_features = (features & silk_cpu_detect()) | SILK_CPU_DETECTED;
+    return old;
+}
\ No newline at end of file
@@ -3,6 +3,16 @@
 #define SILK_ENDIAN_LEFT_SHIFT_READ(TYPE, PTR, INDEX, SHIFT)    (((TYPE)(*(PTR + INDEX))) << SHIFT) 
 #define SILK_ENDIAN_RIGHT_SHIFT_WRITE(VALUE, PTR, INDEX, SHIFT) (*(PTR + INDEX) = (uint8_t)((value >> SHIFT) & 0xff))
 
+/*******************************************************
+ * @brief determine whether the cpu is little endian
+ * @return whether the cpu is little endian
+ *******************************************************/
+bool silk_endian_is_little(void)
+{
+    const uint16_t one = 1;
+    return *(const uint8_t*)&one == 1;
+}
+
 /*******************************************************
  * @brief read little-endian uint16_t value from data
  * @param data the data
@@ -1,51 +1,97 @@
 #include <silk/hash.h>
+#include <silk/cpu.h>
 #include <silk/log.h>
+#include <silk/utils.h>
+
+#include <string.h>
+
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
+// default secret of wyhash final4
+static const uint64_t silk_hash_wyhash_secret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
 
 /*******************************************************
- * @brief calculate the hash value by MurmurHash
- *        see: https://en.wikipedia.org/wiki/MurmurHash
- * @param data the data
- * @param len length of the data
- * @param seed seed of hash
- * @return the hash value
+ * @brief read little-endian uint64_t value, unaligned
+ * @param p the data
+ * @return the value
  *******************************************************/
-uint32_t silk_hash_murmur3_32(const void* data, size_t len, uint32_t seed)
+static inline uint64_t silk_hash_read64(const uint8_t* p)
 {
-    SILK_ASSERT(data != NULL, seed);
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+/*******************************************************
+ * @brief read little-endian uint32_t value, unaligned
+ * @param p the data
+ * @return the value
+ *******************************************************/
+static inline uint64_t silk_hash_read32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
 
+/*******************************************************
+ * @brief mix a 4 bytes block into MurmurHash3 x86_32
+ * @param hash the intermediate hash value
+ * @param k the block
+ * @return the intermediate hash value
+ *******************************************************/
+static inline uint32_t silk_hash_murmur3_32_block(uint32_t hash, uint32_t k)
+{
     uint32_t c1 = 0xcc9e2d51;
     uint32_t c2 = 0x1b873593;
     uint32_t r1 = 15;
     uint32_t r2 = 13;
     uint32_t m = 5;
     uint32_t n = 0xe6546b64;
-    uint32_t hash = seed;
 
-    const uint32_t* chunks = (const uint32_t*)(data);
-    size_t i = 0;
-    for (; (i + 1) * sizeof(uint32_t) - 1 < len; i++)
-    {
-        uint32_t k = chunks[i];
-        k = k * c1;
-        k = SILK_ROL(32, k, r1);
-        k = k * c2;
+    k = k * c1;
+    k = SILK_ROL(32, k, r1);
+    k = k * c2;
 
-        hash = hash ^ k;
-        hash = SILK_ROL(32, hash, r2);
-        hash = (hash * m) + n;
-    }
+    hash = hash ^ k;
+    hash = SILK_ROL(32, hash, r2);
+    hash = (hash * m) + n;
+    return hash;
+}
 
-    const uint8_t* remaining = (const uint8_t*)(data) + (i * sizeof(uint32_t));
+/*******************************************************
+ * @brief mix the remaining bytes and the length into
+ *        MurmurHash3 x86_32
+ * @param hash the intermediate hash value
+ * @param remaining the remaining bytes
+ * @param size count of the remaining bytes, less than 4
+ * @param len length of the whole data
+ * @return the hash value
+ *******************************************************/
+static inline uint32_t silk_hash_murmur3_32_tail(uint32_t hash, const uint8_t* remaining, size_t size, size_t len)
+{
+    uint32_t c1 = 0xcc9e2d51;
+    uint32_t c2 = 0x1b873593;
+    uint32_t r1 = 15;
     uint32_t remainingBytes = 0;
-    size_t remainingSize = len - i * sizeof(uint32_t);
 
-    if (remainingSize >= 3)
+    if (size >= 3)
         remainingBytes |= (remaining[2] << 16);
 
-    if (remainingSize >= 2)
+    if (size >= 2)
         remainingBytes |= (remaining[1] << 8);
 
-    if (remainingSize >= 1)
+    if (size >= 1)
     {
         remainingBytes |= remaining[0];
 
@@ -55,7 +101,7 @@ uint32_t silk_hash_murmur3_32(const void* data, size_t len, uint32_t seed)
         hash = hash ^ remainingBytes;
     }
 
-    hash = hash ^ len;
+    hash = hash ^ (uint32_t)len;
     hash = hash ^ (hash >> 16);
     hash = hash * 0x85ebca6b;
     hash = hash ^ (hash >> 13);
@@ -63,4 +109,857 @@ uint32_t silk_hash_murmur3_32(const void* data, size_t len, uint32_t seed)
     hash = hash ^ (hash >> 16);
 
     return hash;
+}
+
+/*******************************************************
+ * @brief calculate the hash value by MurmurHash
+ *        see: https://en.wikipedia.org/wiki/MurmurHash
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @return the hash value
+ *******************************************************/
+uint32_t silk_hash_murmur3_32(const void* data, size_t len, uint32_t seed)
+{
+    SILK_ASSERT(data != NULL, seed);
+
+    const uint8_t* p = data;
+    uint32_t hash = seed;
+    size_t blocks = len / sizeof(uint32_t);
+    for (size_t i = 0; i < blocks; i++, p += sizeof(uint32_t))
+    {
+        uint32_t k;
+        memcpy(&k, p, sizeof(k));
+        hash = silk_hash_murmur3_32_block(hash, k);
+    }
+
+    return silk_hash_murmur3_32_tail(hash, p, len % sizeof(uint32_t), len);
+}
+
+/*******************************************************
+ * @brief load the remaining bytes of a key as
+ *        silk_hash_murmur3_32_tail reads them
+ * @param remaining the remaining bytes
+ * @param size count of the remaining bytes, less than 4
+ * @return the value
+ *******************************************************/
+static inline uint32_t silk_hash_murmur3_32_remaining(const uint8_t* remaining, size_t size)
+{
+    uint32_t value = 0;
+    for (size_t i = size; i > 0; i--)
+        value = (value << 8) | remaining[i - 1];
+    return value;
+}
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief mix 4 lanes of 4 bytes blocks into MurmurHash3
+ *        x86_32 by SSE4.1
+ * @param hash the intermediate hash values
+ * @param k the blocks
+ * @param last whether they are the remaining bytes
+ * @return the intermediate hash values
+ *******************************************************/
+SILK_TARGET("sse4.1")
+static inline __m128i silk_hash_murmur3_32_block_sse41(__m128i hash, __m128i k, bool last)
+{
+    k = _mm_mullo_epi32(k, _mm_set1_epi32((int)0xcc9e2d51));
+    k = _mm_or_si128(_mm_slli_epi32(k, 15), _mm_srli_epi32(k, 17));
+    k = _mm_mullo_epi32(k, _mm_set1_epi32((int)0x1b873593));
+    hash = _mm_xor_si128(hash, k);
+    if (last)
+        return hash;
+
+    hash = _mm_or_si128(_mm_slli_epi32(hash, 13), _mm_srli_epi32(hash, 19));
+    return _mm_add_epi32(_mm_add_epi32(hash, _mm_slli_epi32(hash, 2)), _mm_set1_epi32((int)0xe6546b64));
+}
+
+/*******************************************************
+ * @brief mix the length into 4 lanes of MurmurHash3
+ *        x86_32 by SSE4.1
+ * @param hash the intermediate hash values
+ * @param len length of the data
+ * @return the hash values
+ *******************************************************/
+SILK_TARGET("sse4.1")
+static inline __m128i silk_hash_murmur3_32_fmix_sse41(__m128i hash, size_t len)
+{
+    hash = _mm_xor_si128(hash, _mm_set1_epi32((int)(uint32_t)len));
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+    hash = _mm_mullo_epi32(hash, _mm_set1_epi32((int)0x85ebca6b));
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 13));
+    hash = _mm_mullo_epi32(hash, _mm_set1_epi32((int)0xc2b2ae35));
+    return _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+}
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of 4 keys in the
+ *        4 lanes of SSE4.1 registers
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param seed seed of hash
+ * @param out return the hash values
+ *******************************************************/
+SILK_TARGET("sse4.1")
+static void silk_hash_murmur3_32_batch_sse41(const uint8_t* keys, size_t key_len, uint32_t seed, uint32_t* out)
+{
+    __m128i hash = _mm_set1_epi32((int)seed);
+
+    size_t blocks = key_len / sizeof(uint32_t);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const uint8_t* p = keys + i * sizeof(uint32_t);
+        uint32_t k0, k1, k2, k3;
+        memcpy(&k0, p, 4);
+        memcpy(&k1, p + key_len, 4);
+        memcpy(&k2, p + 2 * key_len, 4);
+        memcpy(&k3, p + 3 * key_len, 4);
+        hash = silk_hash_murmur3_32_block_sse41(hash, _mm_set_epi32((int)k3, (int)k2, (int)k1, (int)k0), false);
+    }
+
+    size_t size = key_len % sizeof(uint32_t);
+    if (size > 0)
+    {
+        const uint8_t* p = keys + blocks * sizeof(uint32_t);
+        __m128i k = _mm_set_epi32((int)silk_hash_murmur3_32_remaining(p + 3 * key_len, size),
+                                  (int)silk_hash_murmur3_32_remaining(p + 2 * key_len, size),
+                                  (int)silk_hash_murmur3_32_remaining(p + key_len, size),
+                                  (int)silk_hash_murmur3_32_remaining(p, size));
+        hash = silk_hash_murmur3_32_block_sse41(hash, k, true);
+    }
+
+    _mm_storeu_si128((__m128i*)out, silk_hash_murmur3_32_fmix_sse41(hash, key_len));
+}
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of one key with 4
+ *        seeds in the 4 lanes of SSE4.1 registers
+ * @param data the data
+ * @param len length of the data
+ * @param seeds the 4 seeds
+ * @param out return the hash values
+ *******************************************************/
+SILK_TARGET("sse4.1")
+static void silk_hash_murmur3_32_seeds_sse41(const uint8_t* data, size_t len, const uint32_t* seeds, uint32_t* out)
+{
+    __m128i hash = _mm_loadu_si128((const __m128i*)seeds);
+
+    size_t blocks = len / sizeof(uint32_t);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        uint32_t k;
+        memcpy(&k, data + i * sizeof(uint32_t), 4);
+        hash = silk_hash_murmur3_32_block_sse41(hash, _mm_set1_epi32((int)k), false);
+    }
+
+    size_t size = len % sizeof(uint32_t);
+    if (size > 0)
+    {
+        uint32_t k = silk_hash_murmur3_32_remaining(data + blocks * sizeof(uint32_t), size);
+        hash = silk_hash_murmur3_32_block_sse41(hash, _mm_set1_epi32((int)k), true);
+    }
+
+    _mm_storeu_si128((__m128i*)out, silk_hash_murmur3_32_fmix_sse41(hash, len));
+}
+
+/*******************************************************
+ * @brief mix 8 lanes of 4 bytes blocks into MurmurHash3
+ *        x86_32 by AVX2
+ * @param hash the intermediate hash values
+ * @param k the blocks
+ * @param last whether they are the remaining bytes
+ * @return the intermediate hash values
+ *******************************************************/
+SILK_TARGET("avx2")
+static inline __m256i silk_hash_murmur3_32_block_avx2(__m256i hash, __m256i k, bool last)
+{
+    k = _mm256_mullo_epi32(k, _mm256_set1_epi32((int)0xcc9e2d51));
+    k = _mm256_or_si256(_mm256_slli_epi32(k, 15), _mm256_srli_epi32(k, 17));
+    k = _mm256_mullo_epi32(k, _mm256_set1_epi32((int)0x1b873593));
+    hash = _mm256_xor_si256(hash, k);
+    if (last)
+        return hash;
+
+    hash = _mm256_or_si256(_mm256_slli_epi32(hash, 13), _mm256_srli_epi32(hash, 19));
+    return _mm256_add_epi32(_mm256_add_epi32(hash, _mm256_slli_epi32(hash, 2)), _mm256_set1_epi32((int)0xe6546b64));
+}
+
+/*******************************************************
+ * @brief mix the length into 8 lanes of MurmurHash3
+ *        x86_32 by AVX2
+ * @param hash the intermediate hash values
+ * @param len length of the data
+ * @return the hash values
+ *******************************************************/
+SILK_TARGET("avx2")
+static inline __m256i silk_hash_murmur3_32_fmix_avx2(__m256i hash, size_t len)
+{
+    hash = _mm256_xor_si256(hash, _mm256_set1_epi32((int)(uint32_t)len));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)0x85ebca6b));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)0xc2b2ae35));
+    return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+}
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of 8 keys in the
+ *        8 lanes of AVX2 registers
+ * @note  blocks are loaded lane by lane, vpgatherdd is
+ *        slower on cpus with the gather data sampling
+ *        mitigation
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param seed seed of hash
+ * @param out return the hash values
+ *******************************************************/
+SILK_TARGET("avx2")
+static void silk_hash_murmur3_32_batch_avx2(const uint8_t* keys, size_t key_len, uint32_t seed, uint32_t* out)
+{
+    __m256i hash = _mm256_set1_epi32((int)seed);
+
+    size_t blocks = key_len / sizeof(uint32_t);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const uint8_t* p = keys + i * sizeof(uint32_t);
+        uint32_t k0, k1, k2, k3, k4, k5, k6, k7;
+        memcpy(&k0, p, 4);
+        memcpy(&k1, p + key_len, 4);
+        memcpy(&k2, p + 2 * key_len, 4);
+        memcpy(&k3, p + 3 * key_len, 4);
+        memcpy(&k4, p + 4 * key_len, 4);
+        memcpy(&k5, p + 5 * key_len, 4);
+        memcpy(&k6, p + 6 * key_len, 4);
+        memcpy(&k7, p + 7 * key_len, 4);
+
+        __m256i k = _mm256_setr_epi32((int)k0, (int)k1, (int)k2, (int)k3, (int)k4, (int)k5, (int)k6, (int)k7);
+        hash = silk_hash_murmur3_32_block_avx2(hash, k, false);
+    }
+
+    size_t size = key_len % sizeof(uint32_t);
+    if (size > 0)
+    {
+        // loading 4 bytes may read past the last key, load the remaining bytes one by one
+        const uint8_t* p = keys + blocks * sizeof(uint32_t);
+        uint32_t remaining[8];
+        for (size_t i = 0; i < 8; i++)
+            remaining[i] = silk_hash_murmur3_32_remaining(p + i * key_len, size);
+
+        hash = silk_hash_murmur3_32_block_avx2(hash, _mm256_loadu_si256((const __m256i*)remaining), true);
+    }
+
+    _mm256_storeu_si256((__m256i*)out, silk_hash_murmur3_32_fmix_avx2(hash, key_len));
+}
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of one key with 8
+ *        seeds in the 8 lanes of AVX2 registers
+ * @param data the data
+ * @param len length of the data
+ * @param seeds the 8 seeds
+ * @param out return the hash values
+ *******************************************************/
+SILK_TARGET("avx2")
+static void silk_hash_murmur3_32_seeds_avx2(const uint8_t* data, size_t len, const uint32_t* seeds, uint32_t* out)
+{
+    __m256i hash = _mm256_loadu_si256((const __m256i*)seeds);
+
+    size_t blocks = len / sizeof(uint32_t);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        uint32_t k;
+        memcpy(&k, data + i * sizeof(uint32_t), 4);
+        hash = silk_hash_murmur3_32_block_avx2(hash, _mm256_set1_epi32((int)k), false);
+    }
+
+    size_t size = len % sizeof(uint32_t);
+    if (size > 0)
+    {
+        uint32_t k = silk_hash_murmur3_32_remaining(data + blocks * sizeof(uint32_t), size);
+        hash = silk_hash_murmur3_32_block_avx2(hash, _mm256_set1_epi32((int)k), true);
+    }
+
+    _mm256_storeu_si256((__m256i*)out, silk_hash_murmur3_32_fmix_avx2(hash, len));
+}
+#endif
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of many keys with
+ *        the same length, keys are hashed in parallel in
+ *        SIMD lanes, 8 keys with AVX2 or 4 with SSE4.1,
+ *        the hash values are the same as calculated by
+ *        silk_hash_murmur3_32 one by one
+ * @param keys the keys, stored one after another
+ * @param key_len length of each key
+ * @param count count of the keys
+ * @param seed seed of hash
+ * @param out return the hash values, count of them
+ *******************************************************/
+void silk_hash_murmur3_32_batch(const void* keys, size_t key_len, size_t count, uint32_t seed, uint32_t* out)
+{
+    SILK_ASSERT(keys != NULL || count == 0);
+    SILK_ASSERT(out != NULL || count == 0);
+
+    const uint8_t* p = keys;
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (silk_cpu_supports(SILK_CPU_AVX2))
+    {
+        for (; i + 8 <= count; i += 8)
+            silk_hash_murmur3_32_batch_avx2(p + i * key_len, key_len, seed, out + i);
+    }
+
+    if (silk_cpu_supports(SILK_CPU_SSE41))
+    {
+        for (; i + 4 <= count; i += 4)
+            silk_hash_murmur3_32_batch_sse41(p + i * key_len, key_len, seed, out + i);
+    }
+#endif
+
+    for (; i < count; i++)
+        out[i] = silk_hash_murmur3_32(p + i * key_len, key_len, seed);
+}
+
+/*******************************************************
+ * @brief calculate MurmurHash3 x86_32 of one key with
+ *        many seeds, seeds are hashed in parallel in SIMD
+ *        lanes, 8 seeds with AVX2 or 4 with SSE4.1, the
+ *        hash values are the same as calculated by
+ *        silk_hash_murmur3_32 one by one
+ * @param data the data
+ * @param len length of the data
+ * @param seeds the seeds
+ * @param count count of the seeds
+ * @param out return the hash values, count of them
+ *******************************************************/
+void silk_hash_murmur3_32_seeds(const void* data, size_t len, const uint32_t* seeds, size_t count, uint32_t* out)
+{
+    SILK_ASSERT(data != NULL || len == 0);
+    SILK_ASSERT(seeds != NULL || count == 0);
+    SILK_ASSERT(out != NULL || count == 0);
+
+    if (data == NULL)
+        data = "";
+
+    size_t i = 0;
+
+#if defined(SILK_CPU_X86)
+    if (silk_cpu_supports(SILK_CPU_AVX2))
+    {
+        for (; i + 8 <= count; i += 8)
+            silk_hash_murmur3_32_seeds_avx2(data, len, seeds + i, out + i);
+    }
+
+    if (silk_cpu_supports(SILK_CPU_SSE41))
+    {
+        for (; i + 4 <= count; i += 4)
+            silk_hash_murmur3_32_seeds_sse41(data, len, seeds + i, out + i);
+    }
+#endif
+
+    for (; i < count; i++)
+        out[i] = silk_hash_murmur3_32(data, len, seeds[i]);
+}
+
+/*******************************************************
+ * @brief init a state to calculate MurmurHash3 x86_32
+ *        incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_murmur3_32_init(silk_hash_state_t* state, uint32_t seed)
+{
+    SILK_ASSERT(state != NULL);
+
+    state->value[0] = seed;
+    state->length = 0;
+    state->pending = 0;
+}
+
+/*******************************************************
+ * @brief feed data into a MurmurHash3 x86_32 state
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_murmur3_32_update(silk_hash_state_t* state, const void* data, size_t len)
+{
+    SILK_ASSERT(state != NULL);
+    SILK_ASSERT(data != NULL || len == 0);
+
+    if (len == 0)
+        return;
+
+    const uint8_t* p = data;
+    uint32_t hash = (uint32_t)state->value[0];
+    state->length += len;
+
+    if (state->pending > 0)
+    {
+        size_t size = sizeof(uint32_t) - state->pending;
+        if (size > len)
+            size = len;
+
+        memcpy(state->buffer + state->pending, p, size);
+        state->pending += size;
+        p += size;
+        len -= size;
+        if (state->pending < sizeof(uint32_t))
+            return;
+
+        uint32_t k;
+        memcpy(&k, state->buffer, sizeof(k));
+        hash = silk_hash_murmur3_32_block(hash, k);
+        state->pending = 0;
+    }
+
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t), p += sizeof(uint32_t))
+    {
+        uint32_t k;
+        memcpy(&k, p, sizeof(k));
+        hash = silk_hash_murmur3_32_block(hash, k);
+    }
+
+    if (len > 0)
+        memcpy(state->buffer, p, len);
+    state->pending = len;
+    state->value[0] = hash;
+}
+
+/*******************************************************
+ * @brief get the hash value of a MurmurHash3 x86_32 state,
+ *        the state is not changed
+ * @param state the state
+ * @return the hash value
+ *******************************************************/
+uint32_t silk_hash_murmur3_32_final(const silk_hash_state_t* state)
+{
+    SILK_ASSERT(state != NULL, 0);
+
+    return silk_hash_murmur3_32_tail((uint32_t)state->value[0], state->buffer, state->pending, state->length);
+}
+
+/*******************************************************
+ * @brief final mix of MurmurHash3 x64
+ * @param k the value
+ * @return the mixed value
+ *******************************************************/
+static inline uint64_t silk_hash_murmur3_fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+/*******************************************************
+ * @brief mix a 16 bytes block into MurmurHash3 x64_128
+ * @param h the intermediate hash values
+ * @param p the block
+ *******************************************************/
+static inline void silk_hash_murmur3_128_block(uint64_t h[2], const uint8_t* p)
+{
+    const uint64_t c1 = 0x87c37b91114253d5ull;
+    const uint64_t c2 = 0x4cf5ad432745937full;
+    uint64_t h1 = h[0];
+    uint64_t h2 = h[1];
+    uint64_t k1 = silk_hash_read64(p);
+    uint64_t k2 = silk_hash_read64(p + 8);
+
+    k1 *= c1;
+    k1 = SILK_ROL(64, k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = SILK_ROL(64, h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = SILK_ROL(64, k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    h2 = SILK_ROL(64, h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+
+    h[0] = h1;
+    h[1] = h2;
+}
+
+/*******************************************************
+ * @brief mix the remaining bytes and the length into
+ *        MurmurHash3 x64_128
+ * @param h the intermediate hash values
+ * @param p the remaining bytes
+ * @param remain count of the remaining bytes, less than 16
+ * @param len length of the whole data
+ * @param hash return the hash value
+ *******************************************************/
+static inline void silk_hash_murmur3_128_tail(const uint64_t h[2], const uint8_t* p, size_t remain, size_t len, uint64_t hash[2])
+{
+    const uint64_t c1 = 0x87c37b91114253d5ull;
+    const uint64_t c2 = 0x4cf5ad432745937full;
+    uint64_t h1 = h[0];
+    uint64_t h2 = h[1];
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for (size_t i = remain; i > 8; i--)
+        k2 = (k2 << 8) | p[i - 1];
+    for (size_t i = remain < 8 ? remain : 8; i > 0; i--)
+        k1 = (k1 << 8) | p[i - 1];
+
+    if (remain > 8)
+    {
+        k2 *= c2;
+        k2 = SILK_ROL(64, k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+
+    if (remain > 0)
+    {
+        k1 *= c1;
+        k1 = SILK_ROL(64, k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+    h1 += h2;
+    h2 += h1;
+    h1 = silk_hash_murmur3_fmix64(h1);
+    h2 = silk_hash_murmur3_fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    hash[0] = h1;
+    hash[1] = h2;
+}
+
+/*******************************************************
+ * @brief calculate the 128 bits hash value by MurmurHash3
+ *        x64 variant, same as MurmurHash3_x64_128
+ *        see: https://github.com/aappleby/smhasher
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @param hash return the hash value, the lower 64 bits
+ *             in hash[0] and the upper in hash[1]
+ *******************************************************/
+void silk_hash_murmur3_128(const void* data, size_t len, uint32_t seed, uint64_t hash[2])
+{
+    SILK_ASSERT(hash != NULL);
+    SILK_ASSERT(data != NULL || len == 0);
+
+    const uint8_t* p = data;
+    uint64_t h[2] = {seed, seed};
+
+    size_t blocks = len / 16;
+    for (size_t i = 0; i < blocks; i++, p += 16)
+        silk_hash_murmur3_128_block(h, p);
+
+    silk_hash_murmur3_128_tail(h, p, len & 15, len, hash);
+}
+
+/*******************************************************
+ * @brief init a state to calculate MurmurHash3 x64_128
+ *        incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_murmur3_128_init(silk_hash_state_t* state, uint32_t seed)
+{
+    SILK_ASSERT(state != NULL);
+
+    state->value[0] = seed;
+    state->value[1] = seed;
+    state->length = 0;
+    state->pending = 0;
+}
+
+/*******************************************************
+ * @brief feed data into a MurmurHash3 x64_128 state
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_murmur3_128_update(silk_hash_state_t* state, const void* data, size_t len)
+{
+    SILK_ASSERT(state != NULL);
+    SILK_ASSERT(data != NULL || len == 0);
+
+    if (len == 0)
+        return;
+
+    const uint8_t* p = data;
+    state->length += len;
+
+    if (state->pending > 0)
+    {
+        size_t size = 16 - state->pending;
+        if (size > len)
+            size = len;
+
+        memcpy(state->buffer + state->pending, p, size);
+        state->pending += size;
+        p += size;
+        len -= size;
+        if (state->pending < 16)
+            return;
+
+        silk_hash_murmur3_128_block(state->value, state->buffer);
+        state->pending = 0;
+    }
+
+    for (; len >= 16; len -= 16, p += 16)
+        silk_hash_murmur3_128_block(state->value, p);
+
+    if (len > 0)
+        memcpy(state->buffer, p, len);
+    state->pending = len;
+}
+
+/*******************************************************
+ * @brief get the hash value of a MurmurHash3 x64_128 state,
+ *        the state is not changed
+ * @param state the state
+ * @param hash return the hash value, the lower 64 bits
+ *             in hash[0] and the upper in hash[1]
+ *******************************************************/
+void silk_hash_murmur3_128_final(const silk_hash_state_t* state, uint64_t hash[2])
+{
+    SILK_ASSERT(state != NULL);
+    SILK_ASSERT(hash != NULL);
+
+    silk_hash_murmur3_128_tail(state->value, state->buffer, state->pending, state->length, hash);
+}
+
+/*******************************************************
+ * @brief multiply and fold of wyhash
+ * @param a a value
+ * @param b a value
+ * @return the folded value
+ *******************************************************/
+static inline uint64_t silk_hash_wymix(uint64_t a, uint64_t b)
+{
+    uint64_t high;
+    uint64_t low = silk_mul128(a, b, &high);
+    return low ^ high;
+}
+
+/*******************************************************
+ * @brief mix a 48 bytes block into wyhash
+ * @param seed the three intermediate seeds
+ * @param p the block
+ *******************************************************/
+static inline void silk_hash_wyhash_block(uint64_t seed[3], const uint8_t* p)
+{
+    const uint64_t* secret = silk_hash_wyhash_secret;
+    seed[0] = silk_hash_wymix(silk_hash_read64(p) ^ secret[1], silk_hash_read64(p + 8) ^ seed[0]);
+    seed[1] = silk_hash_wymix(silk_hash_read64(p + 16) ^ secret[2], silk_hash_read64(p + 24) ^ seed[1]);
+    seed[2] = silk_hash_wymix(silk_hash_read64(p + 32) ^ secret[3], silk_hash_read64(p + 40) ^ seed[2]);
+}
+
+/*******************************************************
+ * @brief mix the remaining bytes and the length into
+ *        wyhash
+ * @param seed the intermediate seed
+ * @param p the remaining bytes, while len > 16 the 16
+ *          bytes before p must be readable, they are the
+ *          last consumed bytes
+ * @param i count of the remaining bytes, not more than 48
+ * @param len length of the whole data
+ * @return the hash value
+ *******************************************************/
+static inline uint64_t silk_hash_wyhash_tail(uint64_t seed, const uint8_t* p, size_t i, size_t len)
+{
+    const uint64_t* secret = silk_hash_wyhash_secret;
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            a = (silk_hash_read32(p) << 32) | silk_hash_read32(p + ((len >> 3) << 2));
+            b = (silk_hash_read32(p + len - 4) << 32) | silk_hash_read32(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+        }
+    }
+    else
+    {
+        while (i > 16)
+        {
+            seed = silk_hash_wymix(silk_hash_read64(p) ^ secret[1], silk_hash_read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        // the last 16 bytes, may overlap with the consumed bytes
+        a = silk_hash_read64(p + i - 16);
+        b = silk_hash_read64(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    a = silk_mul128(a, b, &b);
+    return silk_hash_wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/*******************************************************
+ * @brief calculate the 64 bits hash value by wyhash
+ *        final4 with the default secret
+ *        see: https://github.com/wangyi-fudan/wyhash
+ * @param data the data
+ * @param len length of the data
+ * @param seed seed of hash
+ * @return the hash value
+ *******************************************************/
+uint64_t silk_hash_wyhash(const void* data, size_t len, uint64_t seed)
+{
+    SILK_ASSERT(data != NULL || len == 0, seed);
+
+    const uint64_t* secret = silk_hash_wyhash_secret;
+    const uint8_t* p = data;
+    size_t i = len;
+    seed ^= silk_hash_wymix(seed ^ secret[0], secret[1]);
+
+    if (i > 48)
+    {
+        uint64_t see[3] = {seed, seed, seed};
+        do
+        {
+            silk_hash_wyhash_block(see, p);
+            p += 48;
+            i -= 48;
+        } while (i > 48);
+        seed = see[0] ^ see[1] ^ see[2];
+    }
+
+    return silk_hash_wyhash_tail(seed, p, i, len);
+}
+
+/*******************************************************
+ * @brief init a state to calculate wyhash incrementally
+ * @param state the state
+ * @param seed seed of hash
+ *******************************************************/
+void silk_hash_wyhash_init(silk_hash_state_t* state, uint64_t seed)
+{
+    SILK_ASSERT(state != NULL);
+
+    const uint64_t* secret = silk_hash_wyhash_secret;
+    seed ^= silk_hash_wymix(seed ^ secret[0], secret[1]);
+    state->value[0] = seed;
+    state->value[1] = seed;
+    state->value[2] = seed;
+    state->length = 0;
+    state->pending = 0;
+}
+
+/*******************************************************
+ * @brief feed data into a wyhash state
+ * @note  a full block is kept until more data comes, the
+ *        last bytes of data are hashed differently, the
+ *        last 16 consumed bytes are kept before the
+ *        pending bytes for the same reason
+ * @param state the state
+ * @param data the data
+ * @param len length of the data
+ *******************************************************/
+void silk_hash_wyhash_update(silk_hash_state_t* state, const void* data, size_t len)
+{
+    SILK_ASSERT(state != NULL);
+    SILK_ASSERT(data != NULL || len == 0);
+
+    if (len == 0)
+        return;
+
+    const uint8_t* p = data;
+    uint8_t* pending = state->buffer + 16;
+    state->length += len;
+
+    if (state->pending > 0)
+    {
+        size_t size = 48 - state->pending;
+        if (size > len)
+            size = len;
+
+        memcpy(pending + state->pending, p, size);
+        state->pending += size;
+        p += size;
+        len -= size;
+        if (len == 0)
+            return;
+
+        silk_hash_wyhash_block(state->value, pending);
+        memcpy(state->buffer, pending + 32, 16);
+        state->pending = 0;
+    }
+
+    if (len > 48)
+    {
+        do
+        {
+            silk_hash_wyhash_block(state->value, p);
+            p += 48;
+            len -= 48;
+        } while (len > 48);
+        memcpy(state->buffer, p - 16, 16);
+    }
+
+    if (len > 0)
+        memcpy(pending, p, len);
+    state->pending = len;
+}
+
+/*******************************************************
+ * @brief get the hash value of a wyhash state, the state
+ *        is not changed
+ * @param state the state
+ * @return the hash value
+ *******************************************************/
+uint64_t silk_hash_wyhash_final(const silk_hash_state_t* state)
+{
+    SILK_ASSERT(state != NULL, 0);
+
+    uint64_t seed = state->value[0];
+    if (state->length > 48)
+        seed ^= state->value[1] ^ state->value[2];
+
+    return silk_hash_wyhash_tail(seed, state->buffer + 16, state->pending, state->length);
+}
+
+/*******************************************************
+ * @brief map a key to a bucket by jump consistent hash,
+ *        when buckets grows to buckets + 1, only about
+ *        1 / (buckets + 1) of keys move, all to the new
+ *        bucket, it needs no memory and runs in O(log n)
+ *        see: https://arxiv.org/abs/1406.2294
+ * @param key the key, should be a hash value
+ * @param buckets count of buckets, must be positive
+ * @return the bucket, in [0, buckets)
+ *******************************************************/
+uint32_t silk_hash_jump(uint64_t key, uint32_t buckets)
+{
+    SILK_ASSERT(buckets > 0, 0);
+
+    // a linear congruential generator decides the next bucket to jump to
+    int64_t b = -1;
+    int64_t j = 0;
+    while (j < (int64_t)buckets)
+    {
+        b = j;
+        key = key * 2862933555777941757ULL + 1;
+        j = (int64_t)((double)(b + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+    }
+    return (uint32_t)b;
 }
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include <silk/hashring.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/vector.h>
+
+#include <stdlib.h>
+
+struct SilkHashringNode
+{
+    uint32_t hash;          // position on the ring
+    uint32_t shard;
+};
+
+struct SilkHashring
+{
+    silk_vector_t nodes;    // struct SilkHashringNode, sorted by position
+    size_t replicas;
+    size_t length;          // count of shards
+};
+
+/*******************************************************
+ * @brief compare two nodes by position, and by shard to
+ *        make the order of collided positions stable
+ * @param x a node
+ * @param y a node
+ * @param userdata unused
+ * @return negative value while x < y
+ *         positive value while x > y
+ *         0 while x == y
+ *******************************************************/
+static int silk_hashring_compare(const void* x, const void* y, const void* userdata)
+{
+    (void)userdata;
+    const struct SilkHashringNode* a = x;
+    const struct SilkHashringNode* b = y;
+    if (a->hash != b->hash)
+        return a->hash < b->hash ? -1 : 1;
+    if (a->shard != b->shard)
+        return a->shard < b->shard ? -1 : 1;
+    return 0;
+}
+
+/*******************************************************
+ * @brief compare two nodes for qsort
+ * @param x a node
+ * @param y a node
+ * @return same as silk_hashring_compare
+ *******************************************************/
+static int silk_hashring_sort_compare(const void* x, const void* y)
+{
+    return silk_hashring_compare(x, y, NULL);
+}
+
+/*******************************************************
+ * @brief get the position of a virtual node, it is the
+ *        hash of the shard and the replica in little-endian,
+ *        so rings on different machines are the same
+ * @param shard id of the shard
+ * @param replica index of the virtual node
+ * @return the position on the ring
+ *******************************************************/
+static uint32_t silk_hashring_position(uint32_t shard, uint32_t replica)
+{
+    uint8_t key[8];
+    for (size_t i = 0; i < 4; i++)
+    {
+        key[i] = (uint8_t)(shard >> (i * 8));
+        key[i + 4] = (uint8_t)(replica >> (i * 8));
+    }
+    return silk_hash_murmur3_32(key, sizeof(key), 0);
+}
+
+/*******************************************************
+ * @brief determine whether a shard is in a ring
+ * @param ring the ring
+ * @param shard id of the shard
+ * @return whether the shard is in the ring
+ *******************************************************/
+static bool silk_hashring_contains(silk_hashring_t ring, uint32_t shard)
+{
+    // the shard is in the ring if its first virtual node is
+    struct SilkHashringNode node;
+    node.hash = silk_hashring_position(shard, 0);
+    node.shard = shard;
+
+    const struct SilkHashringNode* nodes = silk_vector_const_data(ring->nodes);
+    size_t left = 0;
+    size_t right = silk_vector_length(ring->nodes);
+    while (left < right)
+    {
+        size_t mid = left + (right - left) / 2;
+        int result = silk_hashring_compare(&nodes[mid], &node, NULL);
+        if (result == 0)
+            return true;
+        if (result < 0)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+    return false;
+}
+
+/*******************************************************
+ * @brief create a consistent hashing ring
+ * @note  each shard is placed on the ring as many virtual
+ *        nodes, a key belongs to the first node clockwise
+ *        from its hash, so adding or removing a shard only
+ *        moves the keys of that shard, lookup is a binary
+ *        search over the sorted nodes
+ *        see: https://en.wikipedia.org/wiki/Consistent_hashing
+ * @param replicas count of virtual nodes of each shard,
+ *                 more nodes balance keys better, about
+ *                 100 to 200 is usual
+ * @return the ring
+ *******************************************************/
+silk_hashring_t silk_hashring_new(size_t replicas)
+{
+    SILK_ASSERT(replicas > 0 && replicas <= UINT32_MAX, NULL);
+
+    silk_hashring_t ring = silk_alloc(sizeof(struct SilkHashring));
+    SILK_ASSERT(ring != NULL, NULL);
+
+    ring->nodes = silk_vector_new(sizeof(struct SilkHashringNode));
+    SILK_ASSERT(ring->nodes != NULL, silk_free(ring), NULL);
+
+    ring->replicas = replicas;
+    ring->length = 0;
+    return ring;
+}
+
+/*******************************************************
+ * @brief delete a consistent hashing ring
+ * @param ring the ring to be deleted
+ *******************************************************/
+void silk_hashring_delete(silk_hashring_t ring)
+{
+    SILK_ASSERT(ring != NULL);
+
+    silk_vector_delete(ring->nodes);
+    silk_free(ring);
+}
+
+/*******************************************************
+ * @brief remove all shards of a consistent hashing ring
+ * @param ring the ring to be cleared
+ *******************************************************/
+void silk_hashring_clear(silk_hashring_t ring)
+{
+    SILK_ASSERT(ring != NULL);
+
+    silk_vector_clear(ring->nodes);
+    ring->length = 0;
+}
+
+/*******************************************************
+ * @brief get the count of shards in a ring
+ * @param ring the ring
+ * @return the count of shards
+ *******************************************************/
+size_t silk_hashring_length(silk_hashring_t ring)
+{
+    SILK_ASSERT(ring != NULL, 0);
+
+    return ring->length;
+}
+
+/*******************************************************
+ * @brief add a shard into a ring
+ * @param ring the ring
+ * @param shard id of the shard
+ * @return whether it is successful, false if the shard
+ *         is already in the ring
+ *******************************************************/
+bool silk_hashring_add(silk_hashring_t ring, uint32_t shard)
+{
+    SILK_ASSERT(ring != NULL, false);
+
+    if (silk_hashring_contains(ring, shard))
+        return false;
+
+    struct SilkHashringNode* added = silk_alloc(sizeof(struct SilkHashringNode) * ring->replicas);
+    SILK_ASSERT(added != NULL, false);
+
+    size_t length = silk_vector_length(ring->nodes);
+    SILK_ASSERT(silk_vector_resize(ring->nodes, length + ring->replicas), silk_free(added), false);
+
+    for (size_t i = 0; i < ring->replicas; i++)
+    {
+        added[i].hash = silk_hashring_position(shard, (uint32_t)i);
+        added[i].shard = shard;
+    }
+    qsort(added, ring->replicas, sizeof(struct SilkHashringNode), silk_hashring_sort_compare);
+
+    // merge from the back, the ring is sorted already, so it is not sorted again
+    struct SilkHashringNode* nodes = silk_vector_data(ring->nodes);
+    size_t i = length;
+    size_t j = ring->replicas;
+    size_t k = length + ring->replicas;
+    while (j > 0)
+    {
+        if (i > 0 && silk_hashring_compare(&nodes[i - 1], &added[j - 1], NULL) > 0)
+            nodes[--k] = nodes[--i];
+        else
+            nodes[--k] = added[--j];
+    }
+
+    silk_free(added);
+    ring->length++;
+    return true;
+}
+
+/*******************************************************
+ * @brief remove a shard from a ring, its keys move to
+ *        the other shards
+ * @param ring the ring
+ * @param shard id of the shard
+ * @return whether it is successful, false if the shard
+ *         is not in the ring
+ *******************************************************/
+bool silk_hashring_remove(silk_hashring_t ring, uint32_t shard)
+{
+    SILK_ASSERT(ring != NULL, false);
+
+    // compact in place, the order is kept
+    struct SilkHashringNode* nodes = silk_vector_data(ring->nodes);
+    size_t length = silk_vector_length(ring->nodes);
+    size_t count = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (nodes[i].shard != shard)
+            nodes[count++] = nodes[i];
+    }
+
+    if (count == length)
+        return false;
+
+    SILK_ASSERT(silk_vector_resize(ring->nodes, count), false);
+    ring->length--;
+    return true;
+}
+
+/*******************************************************
+ * @brief find the shard of a key
+ * @param ring the ring
+ * @param data the key
+ * @param len length of the key
+ * @return id of the shard, or SILK_INVALID_INDEX if the
+ *         ring is empty
+ *******************************************************/
+size_t silk_hashring_get(silk_hashring_t ring, const void* data, size_t len)
+{
+    SILK_ASSERT(data != NULL || len == 0, SILK_INVALID_INDEX);
+
+    if (data == NULL)
+        data = "";
+
+    return silk_hashring_get_hash(ring, silk_hash_murmur3_32(data, len, 0));
+}
+
+/*******************************************************
+ * @brief find the shard of a hash value
+ * @param ring the ring
+ * @param hash the hash value, silk_hashring_get uses
+ *             silk_hash_murmur3_32 with seed 0
+ * @return id of the shard, or SILK_INVALID_INDEX if the
+ *         ring is empty
+ *******************************************************/
+size_t silk_hashring_get_hash(silk_hashring_t ring, uint32_t hash)
+{
+    SILK_ASSERT(ring != NULL, SILK_INVALID_INDEX);
+
+    const struct SilkHashringNode* nodes = silk_vector_const_data(ring->nodes);
+    size_t length = silk_vector_length(ring->nodes);
+    if (length == 0)
+        return SILK_INVALID_INDEX;
+
+    // the first node not before the hash, branch-free to avoid mispredictions
+    const struct SilkHashringNode* base = nodes;
+    size_t n = length;
+    while (n > 1)
+    {
+        size_t half = n / 2;
+        base = base[half - 1].hash < hash ? base + half : base;
+        n -= half;
+    }
+    if (base->hash < hash)
+        base++;
+
+    // wrap around the ring
+    if (base == nodes + length)
+        base = nodes;
+
+    return base->shard;
+}
\ No newline at end of file
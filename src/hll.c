@@ -0,0 +1,550 @@
+#include <silk/hll.h>
+#include <silk/cpu.h>
+#include <silk/endian.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/utils.h>
+#include <silk/vector.h>
+
+#include <string.h>
+
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
+#define SILK_HLL_MIN_PRECISION  4
+#define SILK_HLL_MAX_PRECISION  18
+
+// serialized header: magic, version, precision, encoding, reserved, count
+#define SILK_HLL_HEADER_SIZE    12
+#define SILK_HLL_MAGIC          0x4c4c4853u // "SHLL" in little endian
+#define SILK_HLL_VERSION        1
+#define SILK_HLL_SPARSE         0
+#define SILK_HLL_DENSE          1
+
+// 1 / (2 * ln2), alpha of infinite registers
+#define SILK_HLL_ALPHA_INF      0.7213475204444817
+
+struct SilkHll
+{
+    uint8_t* registers;     // one byte of each register, NULL while sparse
+    silk_vector_t sparse;   // uint32_t of index << 8 | rank sorted by index, while sparse
+    uint32_t precision;
+};
+
+/*******************************************************
+ * @brief get count of registers
+ * @param hll the sketch
+ * @return count of registers
+ *******************************************************/
+static inline size_t silk_hll_registers(silk_hll_t hll)
+{
+    return (size_t)1 << hll->precision;
+}
+
+/*******************************************************
+ * @brief find the sparse entry of a register
+ * @param hll the sketch, sparse
+ * @param index index of the register
+ * @return position of the first entry not less than index
+ *******************************************************/
+static size_t silk_hll_sparse_find(silk_hll_t hll, uint32_t index)
+{
+    const uint32_t* entries = silk_vector_const_data(hll->sparse);
+    size_t low = 0;
+    size_t high = silk_vector_length(hll->sparse);
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if ((entries[mid] >> 8) < index)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+/*******************************************************
+ * @brief convert a sparse sketch to dense registers
+ * @param hll the sketch, sparse
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_hll_to_dense(silk_hll_t hll)
+{
+    size_t m = silk_hll_registers(hll);
+    hll->registers = silk_alloc(m);
+    SILK_ASSERT(hll->registers != NULL, false);
+    memset(hll->registers, 0, m);
+
+    const uint32_t* entries = silk_vector_const_data(hll->sparse);
+    for (size_t i = 0; i < silk_vector_length(hll->sparse); i++)
+        hll->registers[entries[i] >> 8] = (uint8_t)(entries[i] & 0xff);
+
+    silk_vector_clear(hll->sparse);
+    silk_vector_recycle(hll->sparse);
+    return true;
+}
+
+/*******************************************************
+ * @brief raise a register of a sketch
+ * @param hll the sketch
+ * @param index index of the register
+ * @param rank the new value, kept if it is larger
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_hll_set(silk_hll_t hll, uint32_t index, uint8_t rank)
+{
+    if (hll->registers == NULL)
+    {
+        size_t pos = silk_hll_sparse_find(hll, index);
+        uint32_t* entries = silk_vector_data(hll->sparse);
+        if (pos < silk_vector_length(hll->sparse) && (entries[pos] >> 8) == index)
+        {
+            if (rank > (entries[pos] & 0xff))
+                entries[pos] = (index << 8) | rank;
+            return true;
+        }
+
+        // the sparse list takes 4 bytes of each register, the dense registers 1 byte
+        if ((silk_vector_length(hll->sparse) + 1) * sizeof(uint32_t) <= silk_hll_registers(hll))
+        {
+            uint32_t entry = (index << 8) | rank;
+            return silk_vector_insert(hll->sparse, pos, &entry);
+        }
+
+        SILK_ASSERT(silk_hll_to_dense(hll), false);
+    }
+
+    if (rank > hll->registers[index])
+        hll->registers[index] = rank;
+    return true;
+}
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief byte-wise max of two arrays by AVX2
+ * @param dst the array to be updated
+ * @param src the other array
+ * @param n length of arrays
+ *******************************************************/
+SILK_TARGET("avx2")
+static void silk_hll_max_avx2(uint8_t* dst, const uint8_t* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_max_epu8(a, b));
+    }
+
+    for (; i < n; i++)
+        dst[i] = dst[i] > src[i] ? dst[i] : src[i];
+}
+
+/*******************************************************
+ * @brief byte-wise max of two arrays by SSE2
+ * @param dst the array to be updated
+ * @param src the other array
+ * @param n length of arrays
+ *******************************************************/
+SILK_TARGET("sse2")
+static void silk_hll_max_sse2(uint8_t* dst, const uint8_t* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_max_epu8(a, b));
+    }
+
+    for (; i < n; i++)
+        dst[i] = dst[i] > src[i] ? dst[i] : src[i];
+}
+#endif
+
+/*******************************************************
+ * @brief byte-wise max of two arrays
+ * @param dst the array to be updated
+ * @param src the other array
+ * @param n length of arrays
+ *******************************************************/
+static void silk_hll_max(uint8_t* dst, const uint8_t* src, size_t n)
+{
+#if defined(SILK_CPU_X86)
+    if (silk_cpu_supports(SILK_CPU_AVX2))
+    {
+        silk_hll_max_avx2(dst, src, n);
+        return;
+    }
+
+    if (silk_cpu_supports(SILK_CPU_SSE2))
+    {
+        silk_hll_max_sse2(dst, src, n);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < n; i++)
+        dst[i] = dst[i] > src[i] ? dst[i] : src[i];
+}
+
+/*******************************************************
+ * @brief square root by Newton's method, without linking
+ *        the math library
+ * @param x the value, in (0, 1)
+ * @return the square root
+ *******************************************************/
+static double silk_hll_sqrt(double x)
+{
+    // starting above the root, the iteration decreases until it converges
+    double y = 1;
+    for (;;)
+    {
+        double next = 0.5 * (y + x / y);
+        if (next >= y)
+            return y;
+        y = next;
+    }
+}
+
+/*******************************************************
+ * @brief the sigma function of Ertl's estimator, for the
+ *        registers which are 0
+ * @param x ratio of the registers which are 0, less than 1
+ * @return the value
+ *******************************************************/
+static double silk_hll_sigma(double x)
+{
+    double y = 1;
+    double z = x;
+    for (;;)
+    {
+        x *= x;
+        double old = z;
+        z += x * y;
+        y += y;
+        if (old == z)
+            return z;
+    }
+}
+
+/*******************************************************
+ * @brief the tau function of Ertl's estimator, for the
+ *        registers which are saturated
+ * @param x ratio of the registers which are not saturated
+ * @return the value
+ *******************************************************/
+static double silk_hll_tau(double x)
+{
+    if (x == 0 || x == 1)
+        return 0;
+
+    double y = 1;
+    double z = 1 - x;
+    for (;;)
+    {
+        x = silk_hll_sqrt(x);
+        double old = z;
+        y *= 0.5;
+        z -= (1 - x) * (1 - x) * y;
+        if (old == z)
+            return z / 3;
+    }
+}
+
+/*******************************************************
+ * @brief create a HyperLogLog sketch
+ * @note  it estimates the count of distinct keys with
+ *        2^precision registers, the standard error is
+ *        about 1.04 / sqrt(2^precision), 0.81% for 14,
+ *        it stays sparse until the sorted register list
+ *        would take more memory than the dense registers
+ *        see: https://arxiv.org/abs/1702.01284
+ * @param precision count of index bits, 4 to 18
+ * @return the sketch
+ *******************************************************/
+silk_hll_t silk_hll_new(uint32_t precision)
+{
+    SILK_ASSERT(precision >= SILK_HLL_MIN_PRECISION && precision <= SILK_HLL_MAX_PRECISION, NULL);
+
+    silk_hll_t hll = silk_alloc(sizeof(struct SilkHll));
+    SILK_ASSERT(hll != NULL, NULL);
+
+    hll->sparse = silk_vector_new(sizeof(uint32_t));
+    SILK_ASSERT(hll->sparse != NULL, silk_free(hll), NULL);
+
+    hll->registers = NULL;
+    hll->precision = precision;
+    return hll;
+}
+
+/*******************************************************
+ * @brief delete a HyperLogLog sketch
+ * @param hll the sketch to be deleted
+ *******************************************************/
+void silk_hll_delete(silk_hll_t hll)
+{
+    SILK_ASSERT(hll != NULL);
+
+    if (hll->registers != NULL)
+        silk_free(hll->registers);
+    silk_vector_delete(hll->sparse);
+    silk_free(hll);
+}
+
+/*******************************************************
+ * @brief clear a HyperLogLog sketch, it becomes sparse
+ * @param hll the sketch to be cleared
+ *******************************************************/
+void silk_hll_clear(silk_hll_t hll)
+{
+    SILK_ASSERT(hll != NULL);
+
+    if (hll->registers != NULL)
+        silk_free(hll->registers);
+    hll->registers = NULL;
+    silk_vector_clear(hll->sparse);
+}
+
+/*******************************************************
+ * @brief add a key into a HyperLogLog sketch
+ * @param hll the sketch
+ * @param data the key
+ * @param len length of the key
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_add(silk_hll_t hll, const void* data, size_t len)
+{
+    return silk_hll_add_hash(hll, silk_hash_wyhash(data, len, 0));
+}
+
+/*******************************************************
+ * @brief add a key by its 64 bits hash value, such as
+ *        silk_hash_wyhash, into a HyperLogLog sketch
+ * @param hll the sketch
+ * @param hash the hash value of the key
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_add_hash(silk_hll_t hll, uint64_t hash)
+{
+    SILK_ASSERT(hll != NULL, false);
+
+    // the upper bits select the register, the rank is 1 + leading zeros of the rest
+    uint32_t p = hll->precision;
+    uint32_t index = (uint32_t)(hash >> (64 - p));
+    uint64_t w = hash << p;
+    uint8_t rank = (uint8_t)(w == 0 ? 64 - p + 1 : (uint32_t)silk_clz64(w) + 1);
+    return silk_hll_set(hll, index, rank);
+}
+
+/*******************************************************
+ * @brief estimate the count of distinct keys
+ * @param hll the sketch
+ * @return the estimated count
+ *******************************************************/
+uint64_t silk_hll_count(silk_hll_t hll)
+{
+    SILK_ASSERT(hll != NULL, 0);
+
+    // histogram of register values
+    size_t m = silk_hll_registers(hll);
+    uint32_t q = 64 - hll->precision;
+    size_t histogram[66] = {0};
+    if (hll->registers == NULL)
+    {
+        const uint32_t* entries = silk_vector_const_data(hll->sparse);
+        size_t count = silk_vector_length(hll->sparse);
+        histogram[0] = m - count;
+        for (size_t i = 0; i < count; i++)
+            histogram[entries[i] & 0xff]++;
+    }
+    else
+    {
+        for (size_t i = 0; i < m; i++)
+            histogram[hll->registers[i]]++;
+    }
+
+    if (histogram[0] == m)
+        return 0;
+
+    double z = (double)m * silk_hll_tau(1 - (double)histogram[q + 1] / (double)m);
+    for (uint32_t k = q; k >= 1; k--)
+        z = 0.5 * (z + (double)histogram[k]);
+    z += (double)m * silk_hll_sigma((double)histogram[0] / (double)m);
+
+    return (uint64_t)(SILK_HLL_ALPHA_INF * (double)m * (double)m / z + 0.5);
+}
+
+/*******************************************************
+ * @brief merge a sketch into another, the result is the
+ *        sketch of the union of the keys, registers are
+ *        merged by SIMD max
+ * @param hll the sketch to be merged into
+ * @param other the other sketch, not changed
+ * @return whether it is successful, false if precisions
+ *         are different
+ *******************************************************/
+bool silk_hll_merge(silk_hll_t hll, silk_hll_t other)
+{
+    SILK_ASSERT(hll != NULL, false);
+    SILK_ASSERT(other != NULL, false);
+
+    if (hll->precision != other->precision)
+        return false;
+
+    if (other->registers == NULL)
+    {
+        const uint32_t* entries = silk_vector_const_data(other->sparse);
+        for (size_t i = 0; i < silk_vector_length(other->sparse); i++)
+        {
+            SILK_ASSERT(silk_hll_set(hll, entries[i] >> 8, (uint8_t)(entries[i] & 0xff)), false);
+        }
+        return true;
+    }
+
+    if (hll->registers == NULL)
+    {
+        SILK_ASSERT(silk_hll_to_dense(hll), false);
+    }
+
+    silk_hll_max(hll->registers, other->registers, silk_hll_registers(hll));
+    return true;
+}
+
+/*******************************************************
+ * @brief get the size of a serialized sketch
+ * @param hll the sketch
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_hll_serialized_size(silk_hll_t hll)
+{
+    SILK_ASSERT(hll != NULL, 0);
+
+    if (hll->registers == NULL)
+        return SILK_HLL_HEADER_SIZE + silk_vector_length(hll->sparse) * sizeof(uint32_t);
+
+    return SILK_HLL_HEADER_SIZE + silk_hll_registers(hll);
+}
+
+/*******************************************************
+ * @brief serialize a sketch, all values are little endian
+ * @param hll the sketch
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_hll_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_hll_serialize(silk_hll_t hll, void* buffer, size_t size)
+{
+    SILK_ASSERT(hll != NULL, false);
+    SILK_ASSERT(buffer != NULL, false);
+
+    if (size < silk_hll_serialized_size(hll))
+        return false;
+
+    uint8_t* p = buffer;
+    silk_endian_write_little32(p, SILK_HLL_MAGIC);
+    p[4] = SILK_HLL_VERSION;
+    p[5] = (uint8_t)hll->precision;
+    p[6] = hll->registers == NULL ? SILK_HLL_SPARSE : SILK_HLL_DENSE;
+    p[7] = 0;
+    p += 8;
+
+    if (hll->registers == NULL)
+    {
+        const uint32_t* entries = silk_vector_const_data(hll->sparse);
+        size_t count = silk_vector_length(hll->sparse);
+        silk_endian_write_little32(p, (uint32_t)count);
+        p += 4;
+        for (size_t i = 0; i < count; i++, p += 4)
+            silk_endian_write_little32(p, entries[i]);
+    }
+    else
+    {
+        silk_endian_write_little32(p, (uint32_t)silk_hll_registers(hll));
+        memcpy(p + 4, hll->registers, silk_hll_registers(hll));
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief create a sketch from serialized data
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the sketch, or NULL if data is invalid
+ *******************************************************/
+silk_hll_t silk_hll_deserialize(const void* data, size_t size)
+{
+    const uint8_t* p = data;
+    if (p == NULL || size < SILK_HLL_HEADER_SIZE)
+        return NULL;
+
+    uint32_t precision = p[5];
+    uint8_t encoding = p[6];
+    uint32_t count = silk_endian_read_little32(p + 8);
+    if (silk_endian_read_little32(p) != SILK_HLL_MAGIC || p[4] != SILK_HLL_VERSION)
+        return NULL;
+
+    if (precision < SILK_HLL_MIN_PRECISION || precision > SILK_HLL_MAX_PRECISION)
+        return NULL;
+
+    size_t m = (size_t)1 << precision;
+    uint32_t max_rank = 64 - precision + 1;
+    if (encoding == SILK_HLL_SPARSE)
+    {
+        if ((size_t)count * sizeof(uint32_t) > m || size - SILK_HLL_HEADER_SIZE < (size_t)count * sizeof(uint32_t))
+            return NULL;
+    }
+    else if (encoding == SILK_HLL_DENSE)
+    {
+        if (count != m || size - SILK_HLL_HEADER_SIZE < m)
+            return NULL;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    silk_hll_t hll = silk_hll_new(precision);
+    SILK_ASSERT(hll != NULL, NULL);
+
+    p += SILK_HLL_HEADER_SIZE;
+    if (encoding == SILK_HLL_SPARSE)
+    {
+        SILK_ASSERT(silk_vector_resize(hll->sparse, count), silk_hll_delete(hll), NULL);
+
+        // entries must be sorted by distinct indexes
+        uint32_t* entries = silk_vector_data(hll->sparse);
+        for (uint32_t i = 0; i < count; i++, p += 4)
+        {
+            entries[i] = silk_endian_read_little32(p);
+            uint32_t index = entries[i] >> 8;
+            uint32_t rank = entries[i] & 0xff;
+            if (index >= m || rank == 0 || rank > max_rank || (i > 0 && index <= (entries[i - 1] >> 8)))
+            {
+                silk_hll_delete(hll);
+                return NULL;
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < m; i++)
+        {
+            if (p[i] > max_rank)
+            {
+                silk_hll_delete(hll);
+                return NULL;
+            }
+        }
+
+        hll->registers = silk_alloc(m);
+        SILK_ASSERT(hll->registers != NULL, silk_hll_delete(hll), NULL);
+        memcpy(hll->registers, p, m);
+    }
+
+    return hll;
+}
\ No newline at end of file
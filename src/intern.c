@@ -0,0 +1,340 @@
+#include <silk/intern.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/vector.h>
+
+#include <string.h>
+
+// bytes of each arena chunk
+#define SILK_INTERN_CHUNK_SIZE      (64 * 1024)
+
+// strings longer than it get a chunk of their own
+#define SILK_INTERN_LARGE_SIZE      (SILK_INTERN_CHUNK_SIZE / 4)
+
+// initial slots of the hash table, must be power of 2
+#define SILK_INTERN_INIT_CAPACITY   64
+
+// slot value of empty
+#define SILK_INTERN_EMPTY           0
+
+struct SilkInternEntry
+{
+    const char* data;
+    size_t length;
+};
+
+struct SilkInternSlot
+{
+    uint32_t hash;
+    uint32_t index; // handle + 1, SILK_INTERN_EMPTY means empty
+};
+
+struct SilkIntern
+{
+    silk_vector_t entries;          // struct SilkInternEntry
+    silk_vector_t chunks;           // char*
+    char* cursor;                   // free space of the current chunk
+    size_t remain;                  // free bytes of the current chunk
+    struct SilkInternSlot* slots;
+    size_t capacity;                // count of slots, power of 2
+};
+
+/*******************************************************
+ * @brief alloc slots of the hash table
+ * @param capacity count of slots
+ * @return the slots
+ *******************************************************/
+static struct SilkInternSlot* silk_intern_alloc_slots(size_t capacity)
+{
+    struct SilkInternSlot* slots = silk_alloc(sizeof(struct SilkInternSlot) * capacity);
+    SILK_ASSERT(slots != NULL, NULL);
+
+    memset(slots, 0, sizeof(struct SilkInternSlot) * capacity);
+    return slots;
+}
+
+/*******************************************************
+ * @brief double the slots of the hash table and rehash
+ * @param intern the intern pool
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_intern_expand(silk_intern_t intern)
+{
+    size_t capacity = intern->capacity * 2;
+    struct SilkInternSlot* slots = silk_intern_alloc_slots(capacity);
+    SILK_ASSERT(slots != NULL, false);
+
+    for (size_t i = 0; i < intern->capacity; i++)
+    {
+        if (intern->slots[i].index == SILK_INTERN_EMPTY)
+            continue;
+
+        size_t pos = intern->slots[i].hash & (capacity - 1);
+        while (slots[pos].index != SILK_INTERN_EMPTY)
+            pos = (pos + 1) & (capacity - 1);
+        slots[pos] = intern->slots[i];
+    }
+
+    silk_free(intern->slots);
+    intern->slots = slots;
+    intern->capacity = capacity;
+    return true;
+}
+
+/*******************************************************
+ * @brief copy string data into the arena chunks
+ * @param intern the intern pool
+ * @param data the string data
+ * @param len the length of the string
+ * @return the stored c-style string, never moved
+ *******************************************************/
+static const char* silk_intern_store(silk_intern_t intern, const void* data, size_t len)
+{
+    char* dst = NULL;
+    if (len + 1 > SILK_INTERN_LARGE_SIZE)
+    {
+        // dedicated chunk, keep the current chunk for small strings
+        dst = silk_alloc(len + 1);
+        SILK_ASSERT(dst != NULL, NULL);
+        SILK_ASSERT(silk_vector_push_back(intern->chunks, &dst), silk_free(dst), NULL);
+    }
+    else
+    {
+        if (intern->remain < len + 1)
+        {
+            char* chunk = silk_alloc(SILK_INTERN_CHUNK_SIZE);
+            SILK_ASSERT(chunk != NULL, NULL);
+            SILK_ASSERT(silk_vector_push_back(intern->chunks, &chunk), silk_free(chunk), NULL);
+            intern->cursor = chunk;
+            intern->remain = SILK_INTERN_CHUNK_SIZE;
+        }
+        dst = intern->cursor;
+        intern->cursor += len + 1;
+        intern->remain -= len + 1;
+    }
+
+    if (len > 0)
+        silk_copy(dst, data, len);
+    dst[len] = '\0';
+    return dst;
+}
+
+/*******************************************************
+ * @brief find the slot of a string
+ * @param intern the intern pool
+ * @param data the string data
+ * @param len the length of the string
+ * @param hash the hash of the string
+ * @return position of the slot, empty if not found
+ *******************************************************/
+static size_t silk_intern_lookup(silk_intern_t intern, const void* data, size_t len, uint32_t hash)
+{
+    const struct SilkInternEntry* entries = silk_vector_const_data(intern->entries);
+    size_t mask = intern->capacity - 1;
+    size_t pos = hash & mask;
+    while (intern->slots[pos].index != SILK_INTERN_EMPTY)
+    {
+        if (intern->slots[pos].hash == hash)
+        {
+            const struct SilkInternEntry* entry = &entries[intern->slots[pos].index - 1];
+            if (entry->length == len && memcmp(entry->data, data, len) == 0)
+                break;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+/*******************************************************
+ * @brief create a string intern pool
+ * @note  every distinct string is stored once, interned
+ *        strings are never moved until the pool is
+ *        cleared or deleted, so both the returned index
+ *        and the pointer from silk_intern_get can be used
+ *        as a handle, equal handles means equal strings
+ * @return the intern pool
+ *******************************************************/
+silk_intern_t silk_intern_new(void)
+{
+    silk_intern_t intern = silk_alloc(sizeof(struct SilkIntern));
+    SILK_ASSERT(intern != NULL, NULL);
+
+    intern->entries = silk_vector_new(sizeof(struct SilkInternEntry));
+    SILK_ASSERT(intern->entries != NULL, silk_free(intern), NULL);
+
+    intern->chunks = silk_vector_new(sizeof(char*));
+    SILK_ASSERT(intern->chunks != NULL, silk_vector_delete(intern->entries), silk_free(intern), NULL);
+
+    intern->slots = silk_intern_alloc_slots(SILK_INTERN_INIT_CAPACITY);
+    SILK_ASSERT(intern->slots != NULL, silk_vector_delete(intern->chunks), silk_vector_delete(intern->entries), silk_free(intern), NULL);
+
+    intern->capacity = SILK_INTERN_INIT_CAPACITY;
+    intern->cursor = NULL;
+    intern->remain = 0;
+    return intern;
+}
+
+/*******************************************************
+ * @brief delete a string intern pool
+ * @param intern the intern pool to be deleted
+ *******************************************************/
+void silk_intern_delete(silk_intern_t intern)
+{
+    SILK_ASSERT(intern != NULL);
+
+    silk_intern_clear(intern);
+    silk_free(intern->slots);
+    silk_vector_delete(intern->chunks);
+    silk_vector_delete(intern->entries);
+    silk_free(intern);
+}
+
+/*******************************************************
+ * @brief clear a string intern pool
+ * @note  all handles got before become invalid
+ * @param intern the intern pool to be cleared
+ *******************************************************/
+void silk_intern_clear(silk_intern_t intern)
+{
+    SILK_ASSERT(intern != NULL);
+
+    char** chunks = silk_vector_data(intern->chunks);
+    for (size_t i = 0; i < silk_vector_length(intern->chunks); i++)
+    {
+        silk_free(chunks[i]);
+    }
+
+    silk_vector_clear(intern->chunks);
+    silk_vector_clear(intern->entries);
+    memset(intern->slots, 0, sizeof(struct SilkInternSlot) * intern->capacity);
+    intern->cursor = NULL;
+    intern->remain = 0;
+}
+
+/*******************************************************
+ * @brief get the count of distinct strings in a pool
+ * @param intern the intern pool
+ * @return the count of strings
+ *******************************************************/
+size_t silk_intern_length(silk_intern_t intern)
+{
+    SILK_ASSERT(intern != NULL, 0);
+
+    return silk_vector_length(intern->entries);
+}
+
+/*******************************************************
+ * @brief intern a string, store it if it is new
+ * @param intern the intern pool
+ * @param data the string data, could contain '\0'
+ * @param len the length of the string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_put(silk_intern_t intern, const void* data, size_t len)
+{
+    SILK_ASSERT(intern != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(data != NULL || len == 0, SILK_INVALID_INDEX);
+
+    if (data == NULL)
+        data = "";
+
+    uint32_t hash = silk_hash_murmur3_32(data, len, 0);
+    size_t pos = silk_intern_lookup(intern, data, len, hash);
+    if (intern->slots[pos].index != SILK_INTERN_EMPTY)
+        return intern->slots[pos].index - 1;
+
+    size_t handle = silk_vector_length(intern->entries);
+    SILK_ASSERT(handle < UINT32_MAX - 1, SILK_INVALID_INDEX);
+
+    // keep load factor below 1/2
+    if ((handle + 1) * 2 > intern->capacity)
+    {
+        SILK_ASSERT(silk_intern_expand(intern), SILK_INVALID_INDEX);
+        pos = silk_intern_lookup(intern, data, len, hash);
+    }
+
+    struct SilkInternEntry entry;
+    entry.data = silk_intern_store(intern, data, len);
+    entry.length = len;
+    SILK_ASSERT(entry.data != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_vector_push_back(intern->entries, &entry), SILK_INVALID_INDEX);
+
+    intern->slots[pos].hash = hash;
+    intern->slots[pos].index = (uint32_t)(handle + 1);
+    return handle;
+}
+
+/*******************************************************
+ * @brief intern a c-style string, store it if it is new
+ * @param intern the intern pool
+ * @param cstr the c-style string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_puts(silk_intern_t intern, const char* cstr)
+{
+    return silk_intern_put(intern, cstr, cstr == NULL ? 0 : strlen(cstr));
+}
+
+/*******************************************************
+ * @brief find an interned string without storing it
+ * @param intern the intern pool
+ * @param data the string data, could contain '\0'
+ * @param len the length of the string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_find(silk_intern_t intern, const void* data, size_t len)
+{
+    SILK_ASSERT(intern != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(data != NULL || len == 0, SILK_INVALID_INDEX);
+
+    if (data == NULL)
+        data = "";
+
+    uint32_t hash = silk_hash_murmur3_32(data, len, 0);
+    size_t pos = silk_intern_lookup(intern, data, len, hash);
+    if (intern->slots[pos].index == SILK_INTERN_EMPTY)
+        return SILK_INVALID_INDEX;
+
+    return intern->slots[pos].index - 1;
+}
+
+/*******************************************************
+ * @brief find an interned c-style string without storing it
+ * @param intern the intern pool
+ * @param cstr the c-style string
+ * @return the handle of the string, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_intern_finds(silk_intern_t intern, const char* cstr)
+{
+    return silk_intern_find(intern, cstr, cstr == NULL ? 0 : strlen(cstr));
+}
+
+/*******************************************************
+ * @brief get an interned string by handle
+ * @param intern the intern pool
+ * @param handle the handle of the string
+ * @return the stable c-style string, or NULL
+ *******************************************************/
+const char* silk_intern_get(silk_intern_t intern, size_t handle)
+{
+    SILK_ASSERT(intern != NULL, NULL);
+    SILK_ASSERT(handle < silk_vector_length(intern->entries), NULL);
+
+    const struct SilkInternEntry* entries = silk_vector_const_data(intern->entries);
+    return entries[handle].data;
+}
+
+/*******************************************************
+ * @brief get length of an interned string by handle
+ * @param intern the intern pool
+ * @param handle the handle of the string
+ * @return the length of the string
+ *******************************************************/
+size_t silk_intern_string_length(silk_intern_t intern, size_t handle)
+{
+    SILK_ASSERT(intern != NULL, 0);
+    SILK_ASSERT(handle < silk_vector_length(intern->entries), 0);
+
+    const struct SilkInternEntry* entries = silk_vector_const_data(intern->entries);
+    return entries[handle].length;
+}
\ No newline at end of file
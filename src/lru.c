@@ -0,0 +1,331 @@
+#include <silk/lru.h>
+#include <silk/log.h>
+#include <silk/map.h>
+
+#include <string.h>
+
+// offset of the value in the data of a node, keeps it aligned
+#define SILK_LRU_VALUE_OFFSET(KEY_SIZE) (((KEY_SIZE) + 7) / 8 * 8)
+
+// the key then the value, stored just after the node
+#define SILK_LRU_NODE_DATA(NODE)        ((uint8_t*)((NODE) + 1))
+
+struct SilkLruNode
+{
+    struct SilkLruNode* prev;   // toward the front, the most recent
+    struct SilkLruNode* next;   // toward the back, evicted first
+    size_t size;                // size of the value
+    bool referenced;            // hit since it is inserted or got a second chance, CLOCK only
+};
+
+struct SilkLru
+{
+    silk_map_t index;           // key -> struct SilkLruNode*
+    struct SilkLruNode* front;
+    struct SilkLruNode* back;
+    size_t key_size;
+    size_t overhead;            // bytes of each entry besides its value
+    size_t budget;
+    size_t bytes;
+    int policy;
+    silk_lru_stats_t stats;
+};
+
+/*******************************************************
+ * @brief link a node at the front of the list
+ * @param lru the cache
+ * @param node the node
+ *******************************************************/
+static inline void silk_lru_link(silk_lru_t lru, struct SilkLruNode* node)
+{
+    node->prev = NULL;
+    node->next = lru->front;
+    if (lru->front != NULL)
+        lru->front->prev = node;
+    else
+        lru->back = node;
+    lru->front = node;
+}
+
+/*******************************************************
+ * @brief unlink a node from the list
+ * @param lru the cache
+ * @param node the node
+ *******************************************************/
+static inline void silk_lru_unlink(silk_lru_t lru, struct SilkLruNode* node)
+{
+    if (node->prev != NULL)
+        node->prev->next = node->next;
+    else
+        lru->front = node->next;
+
+    if (node->next != NULL)
+        node->next->prev = node->prev;
+    else
+        lru->back = node->prev;
+}
+
+/*******************************************************
+ * @brief remove a node from the list and the index, and
+ *        free it
+ * @param lru the cache
+ * @param node the node
+ *******************************************************/
+static void silk_lru_remove(silk_lru_t lru, struct SilkLruNode* node)
+{
+    silk_lru_unlink(lru, node);
+    silk_map_erase(lru->index, SILK_LRU_NODE_DATA(node));
+    lru->bytes -= lru->overhead + node->size;
+    silk_free(node);
+}
+
+/*******************************************************
+ * @brief evict entries until size more bytes fit
+ * @param lru the cache
+ * @param size the bytes to fit
+ *******************************************************/
+static void silk_lru_evict(silk_lru_t lru, size_t size)
+{
+    while (lru->back != NULL && lru->bytes + size > lru->budget)
+    {
+        struct SilkLruNode* node = lru->back;
+
+        // the hand of CLOCK, a referenced node is moved to the front instead
+        if (node->referenced)
+        {
+            node->referenced = false;
+            silk_lru_unlink(lru, node);
+            silk_lru_link(lru, node);
+            continue;
+        }
+
+        silk_lru_remove(lru, node);
+        lru->stats.evictions++;
+    }
+}
+
+/*******************************************************
+ * @brief get the bytes an entry takes from the budget
+ * @note  besides the key and the value, it charges the
+ *        node of the entry and a slot of the index at its
+ *        max load of 3/4, the allocator overhead and the
+ *        spare slots of the index after it grows are not
+ *        counted
+ * @param key_size size of the key
+ * @param size size of the value
+ * @return the bytes of the entry
+ *******************************************************/
+size_t silk_lru_entry_bytes(size_t key_size, size_t size)
+{
+    size_t slot = SILK_LRU_VALUE_OFFSET(key_size) + sizeof(struct SilkLruNode*) + sizeof(uint32_t);
+    return sizeof(struct SilkLruNode) + SILK_LRU_VALUE_OFFSET(key_size) + (slot * 4 + 2) / 3 + size;
+}
+
+/*******************************************************
+ * @brief create a cache with a byte budget
+ * @note  each entry takes silk_lru_entry_bytes from the
+ *        budget, entries are evicted by the policy until a
+ *        new one fits, get and put are O(1)
+ * @param key_size size of each key
+ * @param budget max bytes of all entries
+ * @param policy SILK_LRU_POLICY_LRU or SILK_LRU_POLICY_CLOCK
+ * @return the cache
+ *******************************************************/
+silk_lru_t silk_lru_new(size_t key_size, size_t budget, int policy)
+{
+    SILK_ASSERT(key_size > 0, NULL);
+    SILK_ASSERT(policy == SILK_LRU_POLICY_LRU || policy == SILK_LRU_POLICY_CLOCK, NULL);
+
+    silk_lru_t lru = silk_alloc(sizeof(struct SilkLru));
+    SILK_ASSERT(lru != NULL, NULL);
+
+    // every eviction erases a key and inserts another, no deleted slot is left by robin hood
+    lru->index = silk_map_new_engine(key_size, sizeof(struct SilkLruNode*), SILK_MAP_ENGINE_ROBIN_HOOD);
+    SILK_ASSERT(lru->index != NULL, silk_free(lru), NULL);
+
+    lru->front = NULL;
+    lru->back = NULL;
+    lru->key_size = key_size;
+    lru->overhead = silk_lru_entry_bytes(key_size, 0);
+    lru->budget = budget;
+    lru->bytes = 0;
+    lru->policy = policy;
+    memset(&lru->stats, 0, sizeof(lru->stats));
+    return lru;
+}
+
+/*******************************************************
+ * @brief delete a cache
+ * @param lru the cache to be deleted
+ *******************************************************/
+void silk_lru_delete(silk_lru_t lru)
+{
+    SILK_ASSERT(lru != NULL);
+
+    silk_lru_clear(lru);
+    silk_map_delete(lru->index);
+    silk_free(lru);
+}
+
+/*******************************************************
+ * @brief remove all entries of a cache, the counters are
+ *        kept
+ * @param lru the cache to be cleared
+ *******************************************************/
+void silk_lru_clear(silk_lru_t lru)
+{
+    SILK_ASSERT(lru != NULL);
+
+    struct SilkLruNode* node = lru->front;
+    while (node != NULL)
+    {
+        struct SilkLruNode* next = node->next;
+        silk_free(node);
+        node = next;
+    }
+
+    silk_map_clear(lru->index);
+    lru->front = NULL;
+    lru->back = NULL;
+    lru->bytes = 0;
+}
+
+/*******************************************************
+ * @brief get the count of entries of a cache
+ * @param lru the cache
+ * @return the count of entries
+ *******************************************************/
+size_t silk_lru_length(silk_lru_t lru)
+{
+    SILK_ASSERT(lru != NULL, 0);
+
+    return silk_map_length(lru->index);
+}
+
+/*******************************************************
+ * @brief get the bytes of all entries of a cache
+ * @param lru the cache
+ * @return the bytes taken from the budget
+ *******************************************************/
+size_t silk_lru_bytes(silk_lru_t lru)
+{
+    SILK_ASSERT(lru != NULL, 0);
+
+    return lru->bytes;
+}
+
+/*******************************************************
+ * @brief put a copy of a value into a cache, the old
+ *        value of the key is replaced
+ * @param lru the cache
+ * @param key the key
+ * @param value the value
+ * @param size size of the value
+ * @return whether it is successful, false if the entry
+ *         is larger than the whole budget, the cache is
+ *         not changed if it fails
+ *******************************************************/
+bool silk_lru_put(silk_lru_t lru, const void* key, const void* value, size_t size)
+{
+    SILK_ASSERT(lru != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+    SILK_ASSERT(value != NULL || size == 0, false);
+
+    // a failed put keeps the cache as it is
+    if (size > lru->budget || lru->overhead > lru->budget - size)
+        return false;
+
+    size_t offset = SILK_LRU_VALUE_OFFSET(lru->key_size);
+    struct SilkLruNode* node = silk_alloc(sizeof(struct SilkLruNode) + offset + size);
+    SILK_ASSERT(node != NULL, false);
+    SILK_ASSERT(silk_map_reserve(lru->index, silk_map_length(lru->index) + 1), silk_free(node), false);
+
+    // the old value is dropped first, it must not be evicted in place of others
+    struct SilkLruNode** slot = silk_map_find(lru->index, key);
+    if (slot != NULL)
+        silk_lru_remove(lru, *slot);
+
+    silk_lru_evict(lru, lru->overhead + size);
+    slot = silk_map_emplace(lru->index, key, NULL);
+    SILK_ASSERT(slot != NULL, silk_free(node), false);
+
+    memcpy(SILK_LRU_NODE_DATA(node), key, lru->key_size);
+    if (size > 0)
+        memcpy(SILK_LRU_NODE_DATA(node) + offset, value, size);
+    node->size = size;
+    node->referenced = false;
+    silk_lru_link(lru, node);
+    *slot = node;
+    lru->bytes += lru->overhead + size;
+    return true;
+}
+
+/*******************************************************
+ * @brief get the value of a key, and count a hit or miss
+ * @param lru the cache
+ * @param key the key
+ * @param size return size of the value, nullable
+ * @return the value, or NULL if it is not cached, it is
+ *         valid until the cache is modified
+ *******************************************************/
+const void* silk_lru_get(silk_lru_t lru, const void* key, size_t* size)
+{
+    SILK_ASSERT(lru != NULL, NULL);
+    SILK_ASSERT(key != NULL, NULL);
+
+    struct SilkLruNode** slot = silk_map_find(lru->index, key);
+    if (slot == NULL)
+    {
+        lru->stats.misses++;
+        return NULL;
+    }
+
+    struct SilkLruNode* node = *slot;
+    if (lru->policy == SILK_LRU_POLICY_CLOCK)
+    {
+        node->referenced = true;
+    }
+    else if (node != lru->front)
+    {
+        silk_lru_unlink(lru, node);
+        silk_lru_link(lru, node);
+    }
+
+    lru->stats.hits++;
+    if (size != NULL)
+        *size = node->size;
+    return SILK_LRU_NODE_DATA(node) + SILK_LRU_VALUE_OFFSET(lru->key_size);
+}
+
+/*******************************************************
+ * @brief remove an entry from a cache, it is not counted
+ *        as an eviction
+ * @param lru the cache
+ * @param key the key
+ * @return whether it is removed, false if it is not cached
+ *******************************************************/
+bool silk_lru_erase(silk_lru_t lru, const void* key)
+{
+    SILK_ASSERT(lru != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+
+    struct SilkLruNode** slot = silk_map_find(lru->index, key);
+    if (slot == NULL)
+        return false;
+
+    silk_lru_remove(lru, *slot);
+    return true;
+}
+
+/*******************************************************
+ * @brief get the counters of a cache
+ * @param lru the cache
+ * @param stats return the counters
+ *******************************************************/
+void silk_lru_stats(silk_lru_t lru, silk_lru_stats_t* stats)
+{
+    SILK_ASSERT(lru != NULL);
+    SILK_ASSERT(stats != NULL);
+
+    *stats = lru->stats;
+}
\ No newline at end of file
@@ -0,0 +1,404 @@
+#include <silk/map.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+#include "map_inner.h"
+
+// initial slots of the hash table, must be power of 2
+#define SILK_MAP_INIT_CAPACITY  16
+
+/*******************************************************
+ * @brief rehash all entries into new slots, removed slots
+ *        are dropped
+ * @param map the map
+ * @param capacity count of the new slots, power of 2
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_map_rehash(silk_map_t map, size_t capacity)
+{
+    uint8_t* entries = silk_alloc(map->entry_size * capacity);
+    SILK_ASSERT(entries != NULL, false);
+    uint32_t* hashes = silk_alloc(sizeof(uint32_t) * capacity);
+    SILK_ASSERT(hashes != NULL, silk_free(entries), false);
+    memset(hashes, 0, sizeof(uint32_t) * capacity);
+
+    uint8_t* old_entries = map->entries;
+    uint32_t* old_hashes = map->hashes;
+    size_t old_capacity = map->capacity;
+    map->entries = entries;
+    map->hashes = hashes;
+    map->capacity = capacity;
+    map->length = 0;
+    map->used = 0;
+
+    // the hashes are kept, keys are not hashed again
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_hashes[i] <= SILK_MAP_DELETED)
+            continue;
+
+        const uint8_t* entry = old_entries + i * map->entry_size;
+        size_t pos = silk_map_place(map, entry, old_hashes[i]);
+        memcpy(SILK_MAP_ENTRY(map, pos) + map->value_offset, entry + map->value_offset, map->value_size);
+    }
+
+    silk_free(old_entries);
+    silk_free(old_hashes);
+    return true;
+}
+
+/*******************************************************
+ * @brief make sure count more entries could be inserted
+ *        without rehashing, load factor is kept below 3/4
+ * @param map the map
+ * @param count count of entries to be inserted
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_prepare(silk_map_t map, size_t count)
+{
+    if ((map->used + count) * 4 <= map->capacity * 3)
+        return true;
+
+    // removed slots are dropped by rehashing, so the capacity is decided by length
+    size_t capacity = map->capacity;
+    while ((map->length + count) * 4 > capacity * 3)
+        capacity *= 2;
+    return silk_map_rehash(map, capacity);
+}
+
+/*******************************************************
+ * @brief create a hash map
+ * @note  keys are compared and hashed byte by byte, it is
+ *        open addressing with linear probing, keys and
+ *        values are stored in the slots
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @return the map
+ *******************************************************/
+silk_map_t silk_map_new(size_t key_size, size_t value_size)
+{
+    return silk_map_new_engine(key_size, value_size, SILK_MAP_ENGINE_LINEAR);
+}
+
+/*******************************************************
+ * @brief create a hash map with an engine
+ * @note  SILK_MAP_ENGINE_ROBIN_HOOD keeps entries ordered
+ *        by their home slots, a lookup stops as soon as
+ *        it meets an entry closer to its home, and erasing
+ *        leaves no deleted slot, so probes stay short
+ *        under heavy insert and erase churn
+ *        see: https://en.wikipedia.org/wiki/Hash_table#Robin_Hood_hashing
+ * @param key_size size of each key
+ * @param value_size size of each value, could be 0
+ * @param engine SILK_MAP_ENGINE_LINEAR or SILK_MAP_ENGINE_ROBIN_HOOD
+ * @return the map
+ *******************************************************/
+silk_map_t silk_map_new_engine(size_t key_size, size_t value_size, int engine)
+{
+    SILK_ASSERT(key_size > 0, NULL);
+    SILK_ASSERT(engine == SILK_MAP_ENGINE_LINEAR || engine == SILK_MAP_ENGINE_ROBIN_HOOD, NULL);
+
+    silk_map_t map = silk_alloc(sizeof(struct SilkMap));
+    SILK_ASSERT(map != NULL, NULL);
+
+    // values are aligned as the largest power of 2 dividing their size, up to 8
+    size_t align = 1;
+    while (align < 8 && value_size % (align * 2) == 0 && value_size >= align * 2)
+        align *= 2;
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->value_offset = (key_size + align - 1) / align * align;
+    map->entry_size = (map->value_offset + value_size + align - 1) / align * align;
+
+    map->entries = silk_alloc(map->entry_size * SILK_MAP_INIT_CAPACITY);
+    SILK_ASSERT(map->entries != NULL, silk_free(map), NULL);
+
+    map->hashes = silk_alloc(sizeof(uint32_t) * SILK_MAP_INIT_CAPACITY);
+    SILK_ASSERT(map->hashes != NULL, silk_free(map->entries), silk_free(map), NULL);
+
+    memset(map->hashes, 0, sizeof(uint32_t) * SILK_MAP_INIT_CAPACITY);
+    map->capacity = SILK_MAP_INIT_CAPACITY;
+    map->length = 0;
+    map->used = 0;
+    map->engine = engine;
+    return map;
+}
+
+/*******************************************************
+ * @brief delete a hash map
+ * @param map the map to be deleted
+ *******************************************************/
+void silk_map_delete(silk_map_t map)
+{
+    SILK_ASSERT(map != NULL);
+
+    silk_free(map->hashes);
+    silk_free(map->entries);
+    silk_free(map);
+}
+
+/*******************************************************
+ * @brief clear a hash map, the capacity is kept
+ * @param map the map to be cleared
+ *******************************************************/
+void silk_map_clear(silk_map_t map)
+{
+    SILK_ASSERT(map != NULL);
+
+    memset(map->hashes, 0, sizeof(uint32_t) * map->capacity);
+    map->length = 0;
+    map->used = 0;
+}
+
+/*******************************************************
+ * @brief get the count of entries of a hash map
+ * @param map the map
+ * @return the count of entries
+ *******************************************************/
+size_t silk_map_length(silk_map_t map)
+{
+    SILK_ASSERT(map != NULL, 0);
+
+    return map->length;
+}
+
+/*******************************************************
+ * @brief reserve enough memory of a hash map
+ * @param map the map
+ * @param count the count of entries could be held
+ *              without rehashing
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_reserve(silk_map_t map, size_t count)
+{
+    SILK_ASSERT(map != NULL, false);
+
+    if (count <= map->length)
+        return true;
+    return silk_map_prepare(map, count - map->length);
+}
+
+/*******************************************************
+ * @brief insert an entry into a hash map, the value is
+ *        replaced if the key is already in the map
+ * @param map the map
+ * @param key the key
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_put(silk_map_t map, const void* key, const void* value)
+{
+    SILK_ASSERT(map != NULL, false);
+    SILK_ASSERT(value != NULL || map->value_size == 0, false);
+
+    void* slot = silk_map_emplace(map, key, NULL);
+    SILK_ASSERT(slot != NULL, false);
+
+    if (map->value_size > 0)
+        memcpy(slot, value, map->value_size);
+    return true;
+}
+
+/*******************************************************
+ * @brief get the value of a key
+ * @param map the map
+ * @param key the key
+ * @param value return the value, nullable
+ * @return whether the key is in the map
+ *******************************************************/
+bool silk_map_get(silk_map_t map, const void* key, void* value)
+{
+    const void* slot = silk_map_find(map, key);
+    if (slot == NULL)
+        return false;
+
+    if (value != NULL && map->value_size > 0)
+        memcpy(value, slot, map->value_size);
+    return true;
+}
+
+/*******************************************************
+ * @brief silk_map_find with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @return the value, or NULL if the key is not in the map
+ *******************************************************/
+void* silk_map_find_hashed(silk_map_t map, const void* key, uint32_t hash)
+{
+    size_t pos = silk_map_lookup(map, key, hash);
+    if (pos == SILK_INVALID_INDEX)
+        return NULL;
+    return SILK_MAP_ENTRY(map, pos) + map->value_offset;
+}
+
+/*******************************************************
+ * @brief silk_map_emplace with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @param inserted return whether the key is inserted, nullable
+ * @return the value, or NULL if it fails
+ *******************************************************/
+void* silk_map_emplace_hashed(silk_map_t map, const void* key, uint32_t hash, bool* inserted)
+{
+    size_t pos = silk_map_lookup(map, key, hash);
+    if (inserted != NULL)
+        *inserted = pos == SILK_INVALID_INDEX;
+
+    if (pos == SILK_INVALID_INDEX)
+    {
+        SILK_ASSERT(silk_map_prepare(map, 1), NULL);
+        pos = silk_map_place(map, key, hash);
+    }
+    return SILK_MAP_ENTRY(map, pos) + map->value_offset;
+}
+
+/*******************************************************
+ * @brief silk_map_erase with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @return whether it is removed
+ *******************************************************/
+bool silk_map_erase_hashed(silk_map_t map, const void* key, uint32_t hash)
+{
+    size_t pos = silk_map_lookup(map, key, hash);
+    if (pos == SILK_INVALID_INDEX)
+        return false;
+
+    map->length--;
+    if (map->engine == SILK_MAP_ENGINE_ROBIN_HOOD)
+    {
+        // shift the following entries back until one is at its home
+        size_t mask = map->capacity - 1;
+        size_t next = (pos + 1) & mask;
+        while (map->hashes[next] != SILK_MAP_EMPTY && SILK_MAP_DISTANCE(map, next) > 0)
+        {
+            map->hashes[pos] = map->hashes[next];
+            memcpy(SILK_MAP_ENTRY(map, pos), SILK_MAP_ENTRY(map, next), map->entry_size);
+            pos = next;
+            next = (next + 1) & mask;
+        }
+        map->hashes[pos] = SILK_MAP_EMPTY;
+        map->used--;
+        return true;
+    }
+
+    // an empty slot would break the probing of the following entries
+    map->hashes[pos] = SILK_MAP_DELETED;
+    return true;
+}
+
+/*******************************************************
+ * @brief find the value of a key in place
+ * @param map the map
+ * @param key the key
+ * @return the value, or NULL if the key is not in the
+ *         map, it is valid until the map is modified
+ *******************************************************/
+void* silk_map_find(silk_map_t map, const void* key)
+{
+    SILK_ASSERT(map != NULL, NULL);
+    SILK_ASSERT(key != NULL, NULL);
+
+    return silk_map_find_hashed(map, key, silk_map_hash(map, key));
+}
+
+/*******************************************************
+ * @brief find the value of a key in place, insert the key
+ *        if it is not in the map
+ * @param map the map
+ * @param key the key
+ * @param inserted return whether the key is inserted,
+ *                 the value is uninitialized if so, nullable
+ * @return the value, or NULL if it fails, it is valid
+ *         until the map is modified
+ *******************************************************/
+void* silk_map_emplace(silk_map_t map, const void* key, bool* inserted)
+{
+    SILK_ASSERT(map != NULL, NULL);
+    SILK_ASSERT(key != NULL, NULL);
+
+    return silk_map_emplace_hashed(map, key, silk_map_hash(map, key), inserted);
+}
+
+/*******************************************************
+ * @brief remove an entry from a hash map
+ * @param map the map
+ * @param key the key
+ * @return whether it is removed, false if the key is not
+ *         in the map
+ *******************************************************/
+bool silk_map_erase(silk_map_t map, const void* key)
+{
+    SILK_ASSERT(map != NULL, false);
+    SILK_ASSERT(key != NULL, false);
+
+    return silk_map_erase_hashed(map, key, silk_map_hash(map, key));
+}
+
+/*******************************************************
+ * @brief invoke callback for every entries
+ * @param map the map
+ * @param callback the callback function
+ * @param data the data passed to callback
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_foreach(silk_map_t map, silk_map_visit_t callback, void* data)
+{
+    SILK_ASSERT(map != NULL, false);
+    SILK_ASSERT(callback != NULL, false);
+
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->hashes[i] > SILK_MAP_DELETED)
+            callback(data, SILK_MAP_ENTRY(map, i), SILK_MAP_ENTRY(map, i) + map->value_offset);
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief measure the probe lengths of a hash map, it
+ *        walks all slots
+ * @param map the map
+ * @param stats return the probe lengths
+ *******************************************************/
+void silk_map_probe_stats(silk_map_t map, silk_map_probe_stats_t* stats)
+{
+    SILK_ASSERT(map != NULL);
+    SILK_ASSERT(stats != NULL);
+
+    size_t mask = map->capacity - 1;
+    size_t hit = 0;
+    size_t miss = 0;
+    stats->max = 0;
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->hashes[i] > SILK_MAP_DELETED)
+        {
+            size_t probe = SILK_MAP_DISTANCE(map, i) + 1;
+            hit += probe;
+            if (probe > stats->max)
+                stats->max = probe;
+        }
+
+        // a miss probes until the same stop condition as silk_map_lookup
+        size_t pos = i;
+        size_t distance = 0;
+        while (map->hashes[pos] != SILK_MAP_EMPTY)
+        {
+            if (map->engine == SILK_MAP_ENGINE_ROBIN_HOOD && SILK_MAP_DISTANCE(map, pos) < distance)
+                break;
+            pos = (pos + 1) & mask;
+            distance++;
+        }
+        miss += distance + 1;
+    }
+
+    stats->hit = map->length > 0 ? (double)hit / (double)map->length : 0;
+    stats->miss = (double)miss / (double)map->capacity;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef SILK_MAP_INNER_H
+#define SILK_MAP_INNER_H
+
+/* 
+ * The open addressing core shared by silk_map, silk_set and silk_cmap,
+ * it is not installed, the layout could be changed at any time.
+ */
+
+#include <silk/map.h>
+#include <silk/hash.h>
+
+#include <string.h>
+
+// hash of an empty slot, and of a removed one, hashes of keys are never them
+#define SILK_MAP_EMPTY          0
+#define SILK_MAP_DELETED        1
+
+// entry of a slot, the key and then the value
+#define SILK_MAP_ENTRY(MAP, INDEX) ((MAP)->entries + (INDEX) * (MAP)->entry_size)
+
+// distance of the entry at a slot from its home slot
+#define SILK_MAP_DISTANCE(MAP, INDEX) (((INDEX) - (MAP)->hashes[INDEX]) & ((MAP)->capacity - 1))
+
+struct SilkMap
+{
+    uint8_t* entries;
+    uint32_t* hashes;       // hash of each slot
+    size_t key_size;
+    size_t value_size;
+    size_t value_offset;    // offset of the value in an entry, aligned by the value size
+    size_t entry_size;
+    size_t capacity;        // count of slots, power of 2
+    size_t length;          // count of entries
+    size_t used;            // count of entries and removed slots
+    int engine;             // SILK_MAP_ENGINE_*
+};
+
+/*******************************************************
+ * @brief fold a 64-bit wyhash of a key into the hash
+ *        stored by the map, the low 32 bits are used
+ * @param hash the wyhash of the key with seed 0
+ * @return the hash, never SILK_MAP_EMPTY or SILK_MAP_DELETED
+ *******************************************************/
+static inline uint32_t silk_map_hash_fold(uint64_t hash)
+{
+    uint32_t low = (uint32_t)hash;
+    return low > SILK_MAP_DELETED ? low : low + 2;
+}
+
+/*******************************************************
+ * @brief get the hash of a key
+ * @param map the map
+ * @param key the key
+ * @return the hash, never SILK_MAP_EMPTY or SILK_MAP_DELETED
+ *******************************************************/
+static inline uint32_t silk_map_hash(silk_map_t map, const void* key)
+{
+    return silk_map_hash_fold(silk_hash_wyhash(key, map->key_size, 0));
+}
+
+/*******************************************************
+ * @brief find the slot of a key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key
+ * @return index of the slot, or SILK_INVALID_INDEX
+ *******************************************************/
+static inline size_t silk_map_lookup(silk_map_t map, const void* key, uint32_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t pos = hash & mask;
+    if (map->engine == SILK_MAP_ENGINE_ROBIN_HOOD)
+    {
+        // the key would have displaced an entry closer to its home
+        for (size_t distance = 0; map->hashes[pos] != SILK_MAP_EMPTY; distance++)
+        {
+            if (SILK_MAP_DISTANCE(map, pos) < distance)
+                break;
+            if (map->hashes[pos] == hash && memcmp(SILK_MAP_ENTRY(map, pos), key, map->key_size) == 0)
+                return pos;
+            pos = (pos + 1) & mask;
+        }
+        return SILK_INVALID_INDEX;
+    }
+
+    while (map->hashes[pos] != SILK_MAP_EMPTY)
+    {
+        if (map->hashes[pos] == hash && memcmp(SILK_MAP_ENTRY(map, pos), key, map->key_size) == 0)
+            return pos;
+        pos = (pos + 1) & mask;
+    }
+    return SILK_INVALID_INDEX;
+}
+
+/*******************************************************
+ * @brief put a key into the first free slot, the key must
+ *        not be in the map
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key
+ * @return index of the slot
+ *******************************************************/
+static inline size_t silk_map_place(silk_map_t map, const void* key, uint32_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t pos = hash & mask;
+    if (map->engine == SILK_MAP_ENGINE_ROBIN_HOOD)
+    {
+        // take the first slot whose entry is closer to its home
+        size_t distance = 0;
+        while (map->hashes[pos] != SILK_MAP_EMPTY && SILK_MAP_DISTANCE(map, pos) >= distance)
+        {
+            pos = (pos + 1) & mask;
+            distance++;
+        }
+
+        // entries are ordered by home slots, so the rest of the run just moves forward by one
+        size_t end = pos;
+        while (map->hashes[end] != SILK_MAP_EMPTY)
+            end = (end + 1) & mask;
+        while (end != pos)
+        {
+            size_t prev = (end - 1) & mask;
+            map->hashes[end] = map->hashes[prev];
+            memcpy(SILK_MAP_ENTRY(map, end), SILK_MAP_ENTRY(map, prev), map->entry_size);
+            end = prev;
+        }
+
+        map->hashes[pos] = hash;
+        memcpy(SILK_MAP_ENTRY(map, pos), key, map->key_size);
+        map->used++;
+        map->length++;
+        return pos;
+    }
+
+    while (map->hashes[pos] > SILK_MAP_DELETED)
+        pos = (pos + 1) & mask;
+
+    if (map->hashes[pos] == SILK_MAP_EMPTY)
+        map->used++;
+    map->hashes[pos] = hash;
+    memcpy(SILK_MAP_ENTRY(map, pos), key, map->key_size);
+    map->length++;
+    return pos;
+}
+
+/*******************************************************
+ * @brief make sure count more entries could be inserted
+ *        without rehashing, load factor is kept below 3/4
+ * @param map the map
+ * @param count count of entries to be inserted
+ * @return whether it is successful
+ *******************************************************/
+bool silk_map_prepare(silk_map_t map, size_t count);
+
+/*******************************************************
+ * @brief silk_map_find with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @return the value, or NULL if the key is not in the map
+ *******************************************************/
+void* silk_map_find_hashed(silk_map_t map, const void* key, uint32_t hash);
+
+/*******************************************************
+ * @brief silk_map_emplace with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @param inserted return whether the key is inserted, nullable
+ * @return the value, or NULL if it fails
+ *******************************************************/
+void* silk_map_emplace_hashed(silk_map_t map, const void* key, uint32_t hash, bool* inserted);
+
+/*******************************************************
+ * @brief silk_map_erase with the hash of the key
+ * @param map the map
+ * @param key the key
+ * @param hash the hash of the key, by silk_map_hash
+ * @return whether it is removed
+ *******************************************************/
+bool silk_map_erase_hashed(silk_map_t map, const void* key, uint32_t hash);
+
+#endif // SILK_MAP_INNER_H
\ No newline at end of file
@@ -0,0 +1,396 @@
+#include <silk/matcher.h>
+#include <silk/log.h>
+#include <silk/vector.h>
+
+#include <string.h>
+
+// transition of a state which has output, directly or by suffix
+#define SILK_MATCHER_OUTPUT     0x80000000u
+
+// no transition while building the trie, no pattern in output lists
+#define SILK_MATCHER_NONE       UINT32_MAX
+
+struct SilkMatcherPattern
+{
+    size_t offset;                  // offset in the text of patterns
+    size_t length;
+};
+
+struct SilkMatcher
+{
+    silk_vector_t patterns;         // struct SilkMatcherPattern
+    silk_vector_t text;             // char, all patterns
+    bool compiled;
+
+    /*
+     * The automaton is a dense DFA, bytes are mapped into classes first, 
+     * bytes not in any pattern share one class, so a row is short.
+     * A transition is the row offset of the next state, SILK_MATCHER_OUTPUT
+     * is set if the next state reports any pattern.
+     */
+    uint8_t classes[256];
+    size_t class_count;
+    uint32_t* transitions;          // state_count * class_count
+    uint32_t* outputs;              // first pattern ending at each state
+    uint32_t* dictionary;           // nearest suffix state which has output
+    uint32_t* next_pattern;         // next pattern ending at the same state
+    size_t state_count;
+};
+
+/*******************************************************
+ * @brief free the automaton
+ * @param matcher the matcher
+ *******************************************************/
+static void silk_matcher_release(silk_matcher_t matcher)
+{
+    silk_free(matcher->transitions);
+    silk_free(matcher->outputs);
+    silk_free(matcher->dictionary);
+    silk_free(matcher->next_pattern);
+    matcher->transitions = NULL;
+    matcher->outputs = NULL;
+    matcher->dictionary = NULL;
+    matcher->next_pattern = NULL;
+    matcher->state_count = 0;
+    matcher->compiled = false;
+}
+
+/*******************************************************
+ * @brief create a multi-pattern matcher
+ * @note  patterns are compiled into an Aho-Corasick
+ *        automaton, all matches are found in one pass
+ *        see: https://en.wikipedia.org/wiki/Aho%E2%80%93Corasick_algorithm
+ * @return the matcher
+ *******************************************************/
+silk_matcher_t silk_matcher_new(void)
+{
+    silk_matcher_t matcher = silk_alloc(sizeof(struct SilkMatcher));
+    SILK_ASSERT(matcher != NULL, NULL);
+
+    matcher->patterns = silk_vector_new(sizeof(struct SilkMatcherPattern));
+    SILK_ASSERT(matcher->patterns != NULL, silk_free(matcher), NULL);
+
+    matcher->text = silk_vector_new(sizeof(char));
+    SILK_ASSERT(matcher->text != NULL, silk_vector_delete(matcher->patterns), silk_free(matcher), NULL);
+
+    memset(matcher->classes, 0, sizeof(matcher->classes));
+    matcher->class_count = 0;
+    matcher->transitions = NULL;
+    matcher->outputs = NULL;
+    matcher->dictionary = NULL;
+    matcher->next_pattern = NULL;
+    matcher->state_count = 0;
+    matcher->compiled = false;
+    return matcher;
+}
+
+/*******************************************************
+ * @brief delete a matcher
+ * @param matcher the matcher to be deleted
+ *******************************************************/
+void silk_matcher_delete(silk_matcher_t matcher)
+{
+    SILK_ASSERT(matcher != NULL);
+
+    silk_matcher_release(matcher);
+    silk_vector_delete(matcher->text);
+    silk_vector_delete(matcher->patterns);
+    silk_free(matcher);
+}
+
+/*******************************************************
+ * @brief remove all patterns of a matcher
+ * @param matcher the matcher to be cleared
+ *******************************************************/
+void silk_matcher_clear(silk_matcher_t matcher)
+{
+    SILK_ASSERT(matcher != NULL);
+
+    silk_matcher_release(matcher);
+    silk_vector_clear(matcher->text);
+    silk_vector_clear(matcher->patterns);
+}
+
+/*******************************************************
+ * @brief get count of patterns in a matcher
+ * @param matcher the matcher
+ * @return the count of patterns
+ *******************************************************/
+size_t silk_matcher_length(silk_matcher_t matcher)
+{
+    SILK_ASSERT(matcher != NULL, 0);
+
+    return silk_vector_length(matcher->patterns);
+}
+
+/*******************************************************
+ * @brief add a pattern into a matcher
+ * @param matcher the matcher
+ * @param data the pattern, could contain '\0'
+ * @param len length of the pattern, must not be 0
+ * @return the id of the pattern, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_add(silk_matcher_t matcher, const void* data, size_t len)
+{
+    SILK_ASSERT(matcher != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(data != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(len > 0, SILK_INVALID_INDEX);
+
+    size_t id = silk_vector_length(matcher->patterns);
+    SILK_ASSERT(id < SILK_MATCHER_NONE, SILK_INVALID_INDEX);
+
+    struct SilkMatcherPattern pattern;
+    pattern.offset = silk_vector_length(matcher->text);
+    pattern.length = len;
+    SILK_ASSERT(silk_vector_inserts(matcher->text, pattern.offset, data, len), SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_vector_push_back(matcher->patterns, &pattern), silk_vector_resize(matcher->text, pattern.offset), SILK_INVALID_INDEX);
+
+    matcher->compiled = false;
+    return id;
+}
+
+/*******************************************************
+ * @brief add a c-style string pattern into a matcher
+ * @param matcher the matcher
+ * @param cstr the pattern
+ * @return the id of the pattern, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_adds(silk_matcher_t matcher, const char* cstr)
+{
+    SILK_ASSERT(cstr != NULL, SILK_INVALID_INDEX);
+
+    return silk_matcher_add(matcher, cstr, strlen(cstr));
+}
+
+/*******************************************************
+ * @brief build the trie of patterns
+ * @param matcher the matcher
+ * @param max_states the max count of states
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_matcher_build_trie(silk_matcher_t matcher, size_t max_states)
+{
+    size_t width = matcher->class_count;
+    size_t pattern_count = silk_vector_length(matcher->patterns);
+    const struct SilkMatcherPattern* patterns = silk_vector_const_data(matcher->patterns);
+    const uint8_t* text = silk_vector_const_data(matcher->text);
+
+    matcher->transitions = silk_alloc(sizeof(uint32_t) * max_states * width);
+    matcher->outputs = silk_alloc(sizeof(uint32_t) * max_states);
+    matcher->next_pattern = silk_alloc(sizeof(uint32_t) * (pattern_count > 0 ? pattern_count : 1));
+    SILK_ASSERT(matcher->transitions != NULL && matcher->outputs != NULL && matcher->next_pattern != NULL, false);
+
+    memset(matcher->transitions, 0xFF, sizeof(uint32_t) * max_states * width);
+    memset(matcher->outputs, 0xFF, sizeof(uint32_t) * max_states);
+    matcher->state_count = 1;
+
+    for (size_t i = 0; i < pattern_count; i++)
+    {
+        // transitions hold state ids until the trie is done
+        uint32_t state = 0;
+        for (size_t k = 0; k < patterns[i].length; k++)
+        {
+            uint32_t* next = &matcher->transitions[state * width + matcher->classes[text[patterns[i].offset + k]]];
+            if (*next == SILK_MATCHER_NONE)
+                *next = (uint32_t)matcher->state_count++;
+            state = *next;
+        }
+
+        // same pattern added twice, both are reported
+        matcher->next_pattern[i] = matcher->outputs[state];
+        matcher->outputs[state] = (uint32_t)i;
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief fill failure transitions in breadth-first order,
+ *        then renumber states in that order, so the hot
+ *        states near the root are close in memory
+ * @param matcher the matcher
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_matcher_build_links(silk_matcher_t matcher)
+{
+    size_t width = matcher->class_count;
+    size_t state_count = matcher->state_count;
+    uint32_t* transitions = matcher->transitions;
+    uint32_t* queue = silk_alloc(sizeof(uint32_t) * state_count);
+    uint32_t* failure = silk_alloc(sizeof(uint32_t) * state_count);
+    uint32_t* dictionary = silk_alloc(sizeof(uint32_t) * state_count);
+    SILK_ASSERT(queue != NULL && failure != NULL && dictionary != NULL, 
+                silk_free(queue), silk_free(failure), silk_free(dictionary), false);
+
+    size_t head = 0;
+    size_t tail = 0;
+    queue[tail++] = 0;
+    failure[0] = 0;
+    dictionary[0] = SILK_MATCHER_NONE;
+    while (head < tail)
+    {
+        uint32_t state = queue[head++];
+        uint32_t* row = &transitions[state * width];
+        const uint32_t* fail_row = &transitions[failure[state] * width];
+        for (size_t c = 0; c < width; c++)
+        {
+            if (row[c] == SILK_MATCHER_NONE)
+            {
+                // the root stays at the root, the others follow the failure
+                row[c] = state == 0 ? 0 : fail_row[c];
+                continue;
+            }
+
+            uint32_t next = row[c];
+            uint32_t fail = state == 0 ? 0 : fail_row[c];
+            failure[next] = fail;
+            dictionary[next] = matcher->outputs[fail] != SILK_MATCHER_NONE ? fail : dictionary[fail];
+            queue[tail++] = next;
+        }
+    }
+
+    // queue is the new order of states, failure is reused as the new id of states
+    for (size_t i = 0; i < state_count; i++)
+        failure[queue[i]] = (uint32_t)i;
+
+    uint32_t* ordered = silk_alloc(sizeof(uint32_t) * state_count * width);
+    uint32_t* outputs = silk_alloc(sizeof(uint32_t) * state_count);
+    SILK_ASSERT(ordered != NULL && outputs != NULL, silk_free(ordered), silk_free(outputs), 
+                silk_free(queue), silk_free(failure), silk_free(dictionary), false);
+
+    for (size_t i = 0; i < state_count; i++)
+    {
+        uint32_t old = queue[i];
+        for (size_t c = 0; c < width; c++)
+            ordered[i * width + c] = failure[transitions[old * width + c]];
+        outputs[i] = matcher->outputs[old];
+        queue[i] = dictionary[old] == SILK_MATCHER_NONE ? SILK_MATCHER_NONE : failure[dictionary[old]];
+    }
+
+    silk_free(matcher->transitions);
+    silk_free(matcher->outputs);
+    silk_free(failure);
+    silk_free(dictionary);
+    matcher->transitions = ordered;
+    matcher->outputs = outputs;
+    matcher->dictionary = queue;
+    return true;
+}
+
+/*******************************************************
+ * @brief compile the patterns into the automaton
+ * @note  it is called by silk_matcher_match if patterns
+ *        are added after the last compiling
+ * @param matcher the matcher
+ * @return whether it is successful
+ *******************************************************/
+bool silk_matcher_compile(silk_matcher_t matcher)
+{
+    SILK_ASSERT(matcher != NULL, false);
+
+    silk_matcher_release(matcher);
+
+    // bytes in patterns get their own classes, the others share the last class
+    const uint8_t* text = silk_vector_const_data(matcher->text);
+    size_t text_length = silk_vector_length(matcher->text);
+    bool used[256] = {false};
+    for (size_t i = 0; i < text_length; i++)
+        used[text[i]] = true;
+
+    size_t used_count = 0;
+    for (size_t c = 0; c < 256; c++)
+        used_count += used[c];
+
+    matcher->class_count = 0;
+    for (size_t c = 0; c < 256; c++)
+        matcher->classes[c] = (uint8_t)(used[c] ? matcher->class_count++ : used_count);
+    if (used_count < 256)
+        matcher->class_count++;
+
+    // a row offset and the output flag must fit in a transition
+    size_t max_states = text_length + 1;
+    SILK_ASSERT(max_states <= (SILK_MATCHER_OUTPUT - 1) / matcher->class_count, false);
+
+    SILK_ASSERT(silk_matcher_build_trie(matcher, max_states), silk_matcher_release(matcher), false);
+    SILK_ASSERT(silk_matcher_build_links(matcher), silk_matcher_release(matcher), false);
+
+    size_t width = matcher->class_count;
+    // state ids to row offsets with the output flag
+    for (size_t i = 0; i < matcher->state_count * width; i++)
+    {
+        uint32_t next = matcher->transitions[i];
+        bool output = matcher->outputs[next] != SILK_MATCHER_NONE || matcher->dictionary[next] != SILK_MATCHER_NONE;
+        matcher->transitions[i] = (uint32_t)(next * width) | (output ? SILK_MATCHER_OUTPUT : 0);
+    }
+
+    matcher->compiled = true;
+    return true;
+}
+
+/*******************************************************
+ * @brief find all patterns in data, overlapped matches
+ *        are all reported, ordered by their end
+ * @param matcher the matcher
+ * @param data the data
+ * @param len length of the data
+ * @param callback called for each match, could be NULL
+ * @param userdata the user data passed to callback
+ * @return count of reported matches, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_match(silk_matcher_t matcher, const void* data, size_t len, silk_matcher_callback_t callback, void* userdata)
+{
+    SILK_ASSERT(matcher != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(data != NULL || len == 0, SILK_INVALID_INDEX);
+
+    if (!matcher->compiled)
+    {
+        SILK_ASSERT(silk_matcher_compile(matcher), SILK_INVALID_INDEX);
+    }
+
+    const uint8_t* p = data;
+    const uint8_t* classes = matcher->classes;
+    const uint32_t* transitions = matcher->transitions;
+    const struct SilkMatcherPattern* patterns = silk_vector_const_data(matcher->patterns);
+    size_t width = matcher->class_count;
+    size_t count = 0;
+    uint32_t row = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        uint32_t next = transitions[row + classes[p[i]]];
+        row = next & ~SILK_MATCHER_OUTPUT;
+        if ((next & SILK_MATCHER_OUTPUT) == 0)
+            continue;
+
+        // patterns ending at this state, then at its suffix states
+        uint32_t state = (uint32_t)(row / width);
+        if (matcher->outputs[state] == SILK_MATCHER_NONE)
+            state = matcher->dictionary[state];
+
+        for (; state != SILK_MATCHER_NONE; state = matcher->dictionary[state])
+        {
+            for (uint32_t id = matcher->outputs[state]; id != SILK_MATCHER_NONE; id = matcher->next_pattern[id])
+            {
+                count++;
+                if (callback != NULL && !callback(id, i + 1 - patterns[id].length, userdata))
+                    return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************
+ * @brief find all patterns in a string
+ * @param matcher the matcher
+ * @param str the string
+ * @param callback called for each match, could be NULL
+ * @param userdata the user data passed to callback
+ * @return count of reported matches, or SILK_INVALID_INDEX
+ *******************************************************/
+size_t silk_matcher_match_string(silk_matcher_t matcher, silk_string_t str, silk_matcher_callback_t callback, void* userdata)
+{
+    SILK_ASSERT(str != NULL, SILK_INVALID_INDEX);
+
+    return silk_matcher_match(matcher, silk_string_get(str), silk_string_length(str), callback, userdata);
+}
\ No newline at end of file
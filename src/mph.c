@@ -0,0 +1,609 @@
+#include <silk/mph.h>
+#include <silk/endian.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/utils.h>
+
+#include <string.h>
+
+// count of buckets is SILK_MPH_C * count / log2(count), fewer buckets take less memory but build slower
+#define SILK_MPH_C                  5
+
+// count of slots is count / 0.99, keys are placed easier, positions beyond count are remapped
+#define SILK_MPH_LOAD_PERCENT       99
+
+// 60% of keys are put into 30% of buckets, dense buckets are placed first while most slots are free
+#define SILK_MPH_DENSE_KEYS         0x9999999aull
+#define SILK_MPH_DENSE_PERCENT      30
+
+// a bucket gives up after so many pilots, then another seed is tried
+#define SILK_MPH_MAX_PILOT          (1u << 20)
+
+// seeds tried before the keys are considered duplicated
+#define SILK_MPH_MAX_ITERATIONS     8
+
+// size of the serialized header, keeps the serialized pilots aligned
+#define SILK_MPH_HEADER_SIZE        64
+
+// "SKMPH001" in little endian
+#define SILK_MPH_MAGIC              0x31303048504d4b53ull
+
+struct SilkMph
+{
+    const uint64_t* pilots;     // bit-packed pilot of each bucket, with a padding word
+    const uint32_t* remap;      // slots of positions beyond count
+    void* memory;               // allocated memory of pilots and remap, NULL if they are in a view
+    uint64_t seed;
+    size_t count;               // count of keys
+    size_t size;                // count of slots
+    size_t buckets;
+    size_t dense_buckets;       // count of buckets which hold 60% of keys
+    uint32_t width;             // bits of each pilot
+};
+
+struct SilkMphBuilder
+{
+    uint64_t* hashes;           // hash of each key
+    uint64_t* sorted;           // position hash of each key, grouped by bucket
+    uint32_t* starts;           // first key of each bucket in sorted, buckets + 1
+    uint32_t* order;            // buckets by size descending
+    uint32_t* pilots;           // pilot of each bucket
+    uint64_t* taken;            // bitmap of taken slots
+    uint32_t* counts;           // count of buckets of each size
+    size_t* positions;          // positions of the bucket being placed
+};
+
+/*******************************************************
+ * @brief the finalizer of MurmurHash3 x64
+ * @param h the value
+ * @return the mixed value
+ *******************************************************/
+static inline uint64_t silk_mph_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/*******************************************************
+ * @brief get the bucket of a key, the low 32 bits of
+ *        hash choose dense or sparse buckets, the high 32
+ *        bits choose the bucket
+ * @param mph the minimal perfect hash function
+ * @param hash hash of the key
+ * @return the bucket
+ *******************************************************/
+static inline size_t silk_mph_bucket(silk_mph_t mph, uint64_t hash)
+{
+    uint64_t high = hash >> 32;
+    if ((hash & 0xffffffffull) < SILK_MPH_DENSE_KEYS)
+        return (size_t)((high * mph->dense_buckets) >> 32);
+    return mph->dense_buckets + (size_t)((high * (mph->buckets - mph->dense_buckets)) >> 32);
+}
+
+/*******************************************************
+ * @brief get the position of a key
+ * @param mph the minimal perfect hash function
+ * @param hash the mixed hash of the key
+ * @param pilot_hash the mixed pilot of the bucket
+ * @return the position in [0, size)
+ *******************************************************/
+static inline size_t silk_mph_position(silk_mph_t mph, uint64_t hash, uint64_t pilot_hash)
+{
+    uint64_t high;
+    silk_mul128(hash ^ pilot_hash, mph->size, &high);
+    return (size_t)high;
+}
+
+/*******************************************************
+ * @brief read the pilot of a bucket
+ * @param mph the minimal perfect hash function
+ * @param bucket the bucket
+ * @return the pilot
+ *******************************************************/
+static inline uint64_t silk_mph_pilot(silk_mph_t mph, size_t bucket)
+{
+    uint64_t bit = (uint64_t)bucket * mph->width;
+    size_t word = (size_t)(bit / 64);
+    uint32_t shift = (uint32_t)(bit % 64);
+    uint64_t value = mph->pilots[word] >> shift;
+    if (shift + mph->width > 64)
+        value |= mph->pilots[word + 1] << (64 - shift);
+    return value & ((1ull << mph->width) - 1);
+}
+
+/*******************************************************
+ * @brief get the count of words of the bit-packed pilots
+ * @param buckets count of buckets
+ * @param width bits of each pilot
+ * @return count of words, with a padding word
+ *******************************************************/
+static inline size_t silk_mph_pilot_words(size_t buckets, uint32_t width)
+{
+    return (buckets * width + 63) / 64 + 1;
+}
+
+/*******************************************************
+ * @brief free the scratch memory of building
+ * @param builder the builder
+ *******************************************************/
+static void silk_mph_builder_free(struct SilkMphBuilder* builder)
+{
+    void* memories[] = {builder->hashes, builder->sorted, builder->starts, builder->order,
+                        builder->pilots, builder->taken, builder->counts, builder->positions};
+    for (size_t i = 0; i < sizeof(memories) / sizeof(memories[0]); i++)
+    {
+        if (memories[i] != NULL)
+            silk_free(memories[i]);
+    }
+}
+
+/*******************************************************
+ * @brief group the keys by bucket, and order the buckets
+ *        by size descending
+ * @param mph the minimal perfect hash function
+ * @param builder the builder, hashes are calculated
+ * @return whether it is successful, false if two keys
+ *         have the same hash
+ *******************************************************/
+static bool silk_mph_group(silk_mph_t mph, struct SilkMphBuilder* builder)
+{
+    // counting sort by bucket, order is the cursor of each bucket here
+    memset(builder->starts, 0, sizeof(uint32_t) * (mph->buckets + 1));
+    for (size_t i = 0; i < mph->count; i++)
+        builder->starts[silk_mph_bucket(mph, builder->hashes[i]) + 1]++;
+    for (size_t i = 0; i < mph->buckets; i++)
+    {
+        builder->starts[i + 1] += builder->starts[i];
+        builder->order[i] = builder->starts[i];
+    }
+    for (size_t i = 0; i < mph->count; i++)
+    {
+        size_t bucket = silk_mph_bucket(mph, builder->hashes[i]);
+        builder->sorted[builder->order[bucket]++] = silk_mph_mix(builder->hashes[i]);
+    }
+
+    // keys of the same hash cannot be placed
+    uint32_t max = 0;
+    for (size_t i = 0; i < mph->buckets; i++)
+    {
+        uint32_t begin = builder->starts[i];
+        uint32_t end = builder->starts[i + 1];
+        for (uint32_t j = begin; j < end; j++)
+        {
+            for (uint32_t k = begin; k < j; k++)
+            {
+                if (builder->sorted[j] == builder->sorted[k])
+                    return false;
+            }
+        }
+        if (end - begin > max)
+            max = end - begin;
+    }
+
+    if (builder->counts != NULL)
+        silk_free(builder->counts);
+    if (builder->positions != NULL)
+        silk_free(builder->positions);
+    builder->counts = silk_alloc(sizeof(uint32_t) * (max + 2));
+    builder->positions = silk_alloc(sizeof(size_t) * (max + 1));
+    SILK_ASSERT(builder->counts != NULL && builder->positions != NULL, false);
+
+    // counting sort by size descending
+    memset(builder->counts, 0, sizeof(uint32_t) * (max + 2));
+    for (size_t i = 0; i < mph->buckets; i++)
+        builder->counts[max - (builder->starts[i + 1] - builder->starts[i]) + 1]++;
+    for (uint32_t i = 0; i < max; i++)
+        builder->counts[i + 1] += builder->counts[i];
+    for (size_t i = 0; i < mph->buckets; i++)
+        builder->order[builder->counts[max - (builder->starts[i + 1] - builder->starts[i])]++] = (uint32_t)i;
+
+    return true;
+}
+
+/*******************************************************
+ * @brief search the pilot of each bucket, the largest
+ *        bucket first
+ * @param mph the minimal perfect hash function
+ * @param builder the builder, keys are grouped
+ * @return whether it is successful, false if a bucket
+ *         could not be placed
+ *******************************************************/
+static bool silk_mph_search(silk_mph_t mph, struct SilkMphBuilder* builder)
+{
+    memset(builder->taken, 0, sizeof(uint64_t) * ((mph->size + 63) / 64));
+    memset(builder->pilots, 0, sizeof(uint32_t) * mph->buckets);
+
+    for (size_t i = 0; i < mph->buckets; i++)
+    {
+        uint32_t bucket = builder->order[i];
+        uint32_t begin = builder->starts[bucket];
+        uint32_t end = builder->starts[bucket + 1];
+        if (begin == end)
+            break;
+
+        uint32_t pilot = 0;
+        for (; pilot < SILK_MPH_MAX_PILOT; pilot++)
+        {
+            // all keys of the bucket go to free and distinct slots
+            uint64_t pilot_hash = silk_mph_mix(pilot ^ mph->seed);
+            uint32_t j = begin;
+            for (; j < end; j++)
+            {
+                size_t position = silk_mph_position(mph, builder->sorted[j], pilot_hash);
+                if (builder->taken[position / 64] & (1ull << (position % 64)))
+                    break;
+
+                uint32_t k = begin;
+                while (k < j && builder->positions[k - begin] != position)
+                    k++;
+                if (k < j)
+                    break;
+
+                builder->positions[j - begin] = position;
+            }
+            if (j == end)
+                break;
+        }
+
+        if (pilot == SILK_MPH_MAX_PILOT)
+            return false;
+
+        for (uint32_t j = 0; j < end - begin; j++)
+            builder->taken[builder->positions[j] / 64] |= 1ull << (builder->positions[j] % 64);
+        builder->pilots[bucket] = pilot;
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief pack the pilots and fill the remap table
+ * @param mph the minimal perfect hash function
+ * @param builder the builder, pilots are found
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_mph_pack(silk_mph_t mph, struct SilkMphBuilder* builder)
+{
+    uint32_t max = 0;
+    for (size_t i = 0; i < mph->buckets; i++)
+    {
+        if (builder->pilots[i] > max)
+            max = builder->pilots[i];
+    }
+    mph->width = max == 0 ? 1 : (uint32_t)(64 - silk_clz64(max));
+
+    size_t words = silk_mph_pilot_words(mph->buckets, mph->width);
+    mph->memory = silk_alloc(sizeof(uint64_t) * words + sizeof(uint32_t) * (mph->size - mph->count));
+    SILK_ASSERT(mph->memory != NULL, false);
+
+    uint64_t* pilots = mph->memory;
+    memset(pilots, 0, sizeof(uint64_t) * words);
+    for (size_t i = 0; i < mph->buckets; i++)
+    {
+        uint64_t bit = (uint64_t)i * mph->width;
+        uint32_t shift = (uint32_t)(bit % 64);
+        pilots[bit / 64] |= (uint64_t)builder->pilots[i] << shift;
+        if (shift + mph->width > 64)
+            pilots[bit / 64 + 1] |= (uint64_t)builder->pilots[i] >> (64 - shift);
+    }
+
+    // a key beyond count goes to a free slot below count, the counts of both are equal
+    uint32_t* remap = (uint32_t*)(pilots + words);
+    size_t slot = 0;
+    for (size_t i = mph->count; i < mph->size; i++)
+    {
+        remap[i - mph->count] = 0;
+        if ((builder->taken[i / 64] & (1ull << (i % 64))) == 0)
+            continue;
+
+        while (builder->taken[slot / 64] & (1ull << (slot % 64)))
+            slot++;
+        remap[i - mph->count] = (uint32_t)slot;
+        slot++;
+    }
+
+    mph->pilots = pilots;
+    mph->remap = remap;
+    return true;
+}
+
+/*******************************************************
+ * @brief build a minimal perfect hash function of keys,
+ *        it maps the keys to distinct indexes in
+ *        [0, count), so a table of count entries needs no
+ *        collision handling, it takes about 3.3 bits per key
+ *        for large key sets, more for small ones
+ * @note  keys are placed into buckets, each bucket gets a
+ *        pilot value which moves its keys to free slots,
+ *        a lookup reads the pilot, and the remap table
+ *        for about 1% of keys
+ *        see: https://arxiv.org/abs/2104.10402 (PTHash)
+ * @param keys the keys, must be distinct
+ * @param count count of keys, must be less than 2^32
+ * @return the minimal perfect hash function, or NULL if
+ *         keys are empty or duplicated
+ *******************************************************/
+silk_mph_t silk_mph_build(const silk_mph_key_t* keys, size_t count)
+{
+    SILK_ASSERT(keys != NULL || count == 0, NULL);
+
+    if (count == 0 || count >= UINT32_MAX / 2)
+        return NULL;
+
+    silk_mph_t mph = silk_alloc(sizeof(struct SilkMph));
+    SILK_ASSERT(mph != NULL, NULL);
+
+    size_t log2 = (size_t)(64 - silk_clz64(count));
+    mph->count = count;
+    mph->size = (count * 100 + SILK_MPH_LOAD_PERCENT - 1) / SILK_MPH_LOAD_PERCENT;
+    mph->buckets = (SILK_MPH_C * count + log2 - 1) / log2;
+    mph->dense_buckets = mph->buckets * SILK_MPH_DENSE_PERCENT / 100;
+    if (mph->dense_buckets == 0)
+        mph->dense_buckets = 1;
+    if (mph->buckets <= mph->dense_buckets)
+        mph->buckets = mph->dense_buckets + 1;
+    mph->memory = NULL;
+
+    struct SilkMphBuilder builder = {0};
+    builder.hashes = silk_alloc(sizeof(uint64_t) * count);
+    builder.sorted = silk_alloc(sizeof(uint64_t) * count);
+    builder.starts = silk_alloc(sizeof(uint32_t) * (mph->buckets + 1));
+    builder.order = silk_alloc(sizeof(uint32_t) * mph->buckets);
+    builder.pilots = silk_alloc(sizeof(uint32_t) * mph->buckets);
+    builder.taken = silk_alloc(sizeof(uint64_t) * ((mph->size + 63) / 64));
+    bool allocated = builder.hashes != NULL && builder.sorted != NULL && builder.starts != NULL &&
+                     builder.order != NULL && builder.pilots != NULL && builder.taken != NULL;
+    SILK_ASSERT(allocated, silk_mph_builder_free(&builder), silk_free(mph), NULL);
+
+    bool built = false;
+    for (uint64_t i = 0; i < SILK_MPH_MAX_ITERATIONS && !built; i++)
+    {
+        mph->seed = silk_mph_mix(i + 1);
+        for (size_t j = 0; j < count; j++)
+            builder.hashes[j] = silk_hash_wyhash(keys[j].data, keys[j].len, mph->seed);
+
+        built = silk_mph_group(mph, &builder) && silk_mph_search(mph, &builder);
+    }
+
+    built = built && silk_mph_pack(mph, &builder);
+    silk_mph_builder_free(&builder);
+    if (!built)
+    {
+        silk_free(mph);
+        return NULL;
+    }
+    return mph;
+}
+
+/*******************************************************
+ * @brief delete a minimal perfect hash function
+ * @param mph the minimal perfect hash function
+ *******************************************************/
+void silk_mph_delete(silk_mph_t mph)
+{
+    SILK_ASSERT(mph != NULL);
+
+    if (mph->memory != NULL)
+        silk_free(mph->memory);
+    silk_free(mph);
+}
+
+/*******************************************************
+ * @brief get the count of keys of a minimal perfect hash
+ *        function
+ * @param mph the minimal perfect hash function
+ * @return the count of keys
+ *******************************************************/
+size_t silk_mph_count(silk_mph_t mph)
+{
+    SILK_ASSERT(mph != NULL, 0);
+
+    return mph->count;
+}
+
+/*******************************************************
+ * @brief get the index of a key
+ * @param mph the minimal perfect hash function
+ * @param data the key
+ * @param len length of the key
+ * @return the index in [0, count), an index in range is
+ *         returned for keys not built as well, so the
+ *         table entry should be checked if such keys
+ *         could be queried
+ *******************************************************/
+size_t silk_mph_get(silk_mph_t mph, const void* data, size_t len)
+{
+    SILK_ASSERT(mph != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(data != NULL || len == 0, SILK_INVALID_INDEX);
+
+    uint64_t hash = silk_hash_wyhash(data, len, mph->seed);
+    uint64_t pilot = silk_mph_pilot(mph, silk_mph_bucket(mph, hash));
+    size_t position = silk_mph_position(mph, silk_mph_mix(hash), silk_mph_mix(pilot ^ mph->seed));
+    if (position < mph->count)
+        return position;
+    return mph->remap[position - mph->count];
+}
+
+/*******************************************************
+ * @brief get the size of a serialized minimal perfect
+ *        hash function
+ * @param mph the minimal perfect hash function
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_mph_serialized_size(silk_mph_t mph)
+{
+    SILK_ASSERT(mph != NULL, 0);
+
+    return SILK_MPH_HEADER_SIZE + sizeof(uint64_t) * silk_mph_pilot_words(mph->buckets, mph->width) +
+           sizeof(uint32_t) * (mph->size - mph->count);
+}
+
+/*******************************************************
+ * @brief serialize a minimal perfect hash function, all
+ *        values are little endian, the pilots start at
+ *        offset 64
+ * @param mph the minimal perfect hash function
+ * @param buffer the buffer
+ * @param size size of the buffer, not less than
+ *             silk_mph_serialized_size
+ * @return whether it is successful
+ *******************************************************/
+bool silk_mph_serialize(silk_mph_t mph, void* buffer, size_t size)
+{
+    SILK_ASSERT(mph != NULL, false);
+    SILK_ASSERT(buffer != NULL, false);
+
+    if (size < silk_mph_serialized_size(mph))
+        return false;
+
+    // header: magic, count, size, buckets, dense buckets, seed, width, then zero padding
+    uint8_t* p = buffer;
+    memset(p, 0, SILK_MPH_HEADER_SIZE);
+    silk_endian_write_little64(p, SILK_MPH_MAGIC);
+    silk_endian_write_little64(p + 8, mph->count);
+    silk_endian_write_little64(p + 16, mph->size);
+    silk_endian_write_little64(p + 24, mph->buckets);
+    silk_endian_write_little64(p + 32, mph->dense_buckets);
+    silk_endian_write_little64(p + 40, mph->seed);
+    silk_endian_write_little32(p + 48, mph->width);
+    p += SILK_MPH_HEADER_SIZE;
+
+    size_t words = silk_mph_pilot_words(mph->buckets, mph->width);
+    size_t remaps = mph->size - mph->count;
+    if (silk_endian_is_little())
+    {
+        memcpy(p, mph->pilots, sizeof(uint64_t) * words);
+        memcpy(p + sizeof(uint64_t) * words, mph->remap, sizeof(uint32_t) * remaps);
+    }
+    else
+    {
+        for (size_t i = 0; i < words; i++)
+            silk_endian_write_little64(p + i * sizeof(uint64_t), mph->pilots[i]);
+        p += sizeof(uint64_t) * words;
+        for (size_t i = 0; i < remaps; i++)
+            silk_endian_write_little32(p + i * sizeof(uint32_t), mph->remap[i]);
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief parse the header of a serialized minimal
+ *        perfect hash function
+ * @param data the serialized data
+ * @param size size of the data
+ * @param mph return the fields of the header
+ * @return whether the data is valid
+ *******************************************************/
+static bool silk_mph_parse(const uint8_t* data, size_t size, struct SilkMph* mph)
+{
+    if (data == NULL || size < SILK_MPH_HEADER_SIZE)
+        return false;
+
+    if (silk_endian_read_little64(data) != SILK_MPH_MAGIC)
+        return false;
+
+    uint64_t count = silk_endian_read_little64(data + 8);
+    uint64_t slots = silk_endian_read_little64(data + 16);
+    uint64_t buckets = silk_endian_read_little64(data + 24);
+    uint64_t dense = silk_endian_read_little64(data + 32);
+    uint32_t width = silk_endian_read_little32(data + 48);
+    if (count == 0 || count >= UINT32_MAX / 2 || slots < count || slots - count > count)
+        return false;
+    if (dense == 0 || buckets <= dense || buckets > UINT32_MAX || width == 0 || width > 32)
+        return false;
+
+    // check the size by the remaining size, so nothing overflows
+    size_t remain = size - SILK_MPH_HEADER_SIZE;
+    size_t words = silk_mph_pilot_words((size_t)buckets, width);
+    if (words > remain / sizeof(uint64_t) || slots - count > (remain - words * sizeof(uint64_t)) / sizeof(uint32_t))
+        return false;
+
+    // a remapped slot must be below count
+    const uint8_t* remap = data + SILK_MPH_HEADER_SIZE + words * sizeof(uint64_t);
+    for (size_t i = 0; i < slots - count; i++)
+    {
+        if (silk_endian_read_little32(remap + i * sizeof(uint32_t)) >= count)
+            return false;
+    }
+
+    mph->count = (size_t)count;
+    mph->size = (size_t)slots;
+    mph->buckets = (size_t)buckets;
+    mph->dense_buckets = (size_t)dense;
+    mph->seed = silk_endian_read_little64(data + 40);
+    mph->width = width;
+    return true;
+}
+
+/*******************************************************
+ * @brief create a minimal perfect hash function from
+ *        serialized data, the data is copied
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the minimal perfect hash function, or NULL if
+ *         data is invalid
+ *******************************************************/
+silk_mph_t silk_mph_deserialize(const void* data, size_t size)
+{
+    struct SilkMph header;
+    if (!silk_mph_parse(data, size, &header))
+        return NULL;
+
+    silk_mph_t mph = silk_alloc(sizeof(struct SilkMph));
+    SILK_ASSERT(mph != NULL, NULL);
+    *mph = header;
+
+    size_t words = silk_mph_pilot_words(mph->buckets, mph->width);
+    size_t remaps = mph->size - mph->count;
+    mph->memory = silk_alloc(sizeof(uint64_t) * words + sizeof(uint32_t) * remaps);
+    SILK_ASSERT(mph->memory != NULL, silk_free(mph), NULL);
+
+    uint64_t* pilots = mph->memory;
+    uint32_t* remap = (uint32_t*)(pilots + words);
+    const uint8_t* p = (const uint8_t*)data + SILK_MPH_HEADER_SIZE;
+    for (size_t i = 0; i < words; i++)
+        pilots[i] = silk_endian_read_little64(p + i * sizeof(uint64_t));
+    p += sizeof(uint64_t) * words;
+    for (size_t i = 0; i < remaps; i++)
+        remap[i] = silk_endian_read_little32(p + i * sizeof(uint32_t));
+
+    mph->pilots = pilots;
+    mph->remap = remap;
+    return mph;
+}
+
+/*******************************************************
+ * @brief create a minimal perfect hash function on
+ *        serialized data, such as a mmap'd file, the data
+ *        is used in place on little endian cpus if it is
+ *        8 bytes aligned, otherwise it is copied
+ * @note  data must be kept until the function is deleted
+ * @param data the serialized data
+ * @param size size of the data
+ * @return the minimal perfect hash function, or NULL if
+ *         data is invalid
+ *******************************************************/
+silk_mph_t silk_mph_view(const void* data, size_t size)
+{
+    if (!silk_endian_is_little() || ((uintptr_t)data & (sizeof(uint64_t) - 1)) != 0)
+        return silk_mph_deserialize(data, size);
+
+    struct SilkMph header;
+    if (!silk_mph_parse(data, size, &header))
+        return NULL;
+
+    silk_mph_t mph = silk_alloc(sizeof(struct SilkMph));
+    SILK_ASSERT(mph != NULL, NULL);
+    *mph = header;
+
+    size_t words = silk_mph_pilot_words(mph->buckets, mph->width);
+    mph->pilots = (const uint64_t*)((uintptr_t)data + SILK_MPH_HEADER_SIZE);
+    mph->remap = (const uint32_t*)(mph->pilots + words);
+    mph->memory = NULL;
+    return mph;
+}
\ No newline at end of file
@@ -0,0 +1,580 @@
+#include <silk/rope.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+// max bytes of a chunk
+#define SILK_ROPE_CHUNK_SIZE    1024
+
+// bytes filled into a new chunk, keep some room for in-place insertion
+#define SILK_ROPE_FILL_SIZE     (SILK_ROPE_CHUNK_SIZE * 3 / 4)
+
+// initial seed of the priority generator
+#define SILK_ROPE_SEED          2463534242u
+
+/* The rope is an implicit treap, nodes are ordered by position and
+ * balanced by random priorities. Every node holds a chunk of text and
+ * the total length of its subtree. */
+struct SilkRopeNode
+{
+    struct SilkRopeNode* left;
+    struct SilkRopeNode* right;
+    uint32_t priority;
+    size_t size;                // length of the subtree
+    size_t length;              // length of this chunk
+    char data[SILK_ROPE_CHUNK_SIZE];
+};
+
+struct SilkRope
+{
+    struct SilkRopeNode* root;
+    struct SilkRopeNode* spare[2];  // split never allocates, it takes these
+    uint32_t seed;
+};
+
+/*******************************************************
+ * @brief get length of a subtree
+ * @param node the root of subtree, could be NULL
+ * @return the length
+ *******************************************************/
+static size_t silk_rope_size(const struct SilkRopeNode* node)
+{
+    return node == NULL ? 0 : node->size;
+}
+
+/*******************************************************
+ * @brief recalculate length of a subtree
+ * @param node the root of subtree
+ *******************************************************/
+static void silk_rope_update(struct SilkRopeNode* node)
+{
+    node->size = silk_rope_size(node->left) + node->length + silk_rope_size(node->right);
+}
+
+/*******************************************************
+ * @brief create an empty chunk node
+ * @param rope the rope
+ * @return the node
+ *******************************************************/
+static struct SilkRopeNode* silk_rope_node_new(silk_rope_t rope)
+{
+    struct SilkRopeNode* node = silk_alloc(sizeof(struct SilkRopeNode));
+    SILK_ASSERT(node != NULL, NULL);
+
+    // xorshift32
+    rope->seed ^= rope->seed << 13;
+    rope->seed ^= rope->seed >> 17;
+    rope->seed ^= rope->seed << 5;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->priority = rope->seed;
+    node->size = 0;
+    node->length = 0;
+    return node;
+}
+
+/*******************************************************
+ * @brief delete a subtree
+ * @param node the root of subtree, could be NULL
+ *******************************************************/
+static void silk_rope_node_delete(struct SilkRopeNode* node)
+{
+    if (node == NULL)
+        return;
+
+    silk_rope_node_delete(node->left);
+    silk_rope_node_delete(node->right);
+    silk_free(node);
+}
+
+/*******************************************************
+ * @brief make sure there are spare nodes for split
+ * @param rope the rope
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_rope_prepare(silk_rope_t rope)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (rope->spare[i] == NULL)
+        {
+            rope->spare[i] = silk_rope_node_new(rope);
+            SILK_ASSERT(rope->spare[i] != NULL, false);
+        }
+    }
+    return true;
+}
+
+/*******************************************************
+ * @brief merge two subtrees, all of left are before right
+ * @param left the left subtree, could be NULL
+ * @param right the right subtree, could be NULL
+ * @return the root of merged tree
+ *******************************************************/
+static struct SilkRopeNode* silk_rope_merge(struct SilkRopeNode* left, struct SilkRopeNode* right)
+{
+    if (left == NULL)
+        return right;
+
+    if (right == NULL)
+        return left;
+
+    if (left->priority > right->priority)
+    {
+        left->right = silk_rope_merge(left->right, right);
+        silk_rope_update(left);
+        return left;
+    }
+    else
+    {
+        right->left = silk_rope_merge(left, right->left);
+        silk_rope_update(right);
+        return right;
+    }
+}
+
+/*******************************************************
+ * @brief split a subtree by position
+ * @note  a chunk across the position is cut into two,
+ *        the new node is taken from the spare nodes
+ * @param rope the rope
+ * @param node the root of subtree, could be NULL
+ * @param pos the position
+ * @param left return the subtree of [0, pos)
+ * @param right return the subtree of [pos, end)
+ *******************************************************/
+static void silk_rope_split(silk_rope_t rope, struct SilkRopeNode* node, size_t pos,
+                            struct SilkRopeNode** left, struct SilkRopeNode** right)
+{
+    if (node == NULL)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    size_t left_size = silk_rope_size(node->left);
+    if (pos <= left_size)
+    {
+        silk_rope_split(rope, node->left, pos, left, &node->left);
+        silk_rope_update(node);
+        *right = node;
+    }
+    else if (pos >= left_size + node->length)
+    {
+        silk_rope_split(rope, node->right, pos - left_size - node->length, &node->right, right);
+        silk_rope_update(node);
+        *left = node;
+    }
+    else
+    {
+        struct SilkRopeNode* tail = rope->spare[0] != NULL ? rope->spare[0] : rope->spare[1];
+        if (tail == rope->spare[0])
+            rope->spare[0] = NULL;
+        else
+            rope->spare[1] = NULL;
+
+        size_t offset = pos - left_size;
+        tail->length = node->length - offset;
+        silk_copy(tail->data, node->data + offset, tail->length);
+        silk_rope_update(tail);
+
+        struct SilkRopeNode* sub = node->right;
+        node->length = offset;
+        node->right = NULL;
+        silk_rope_update(node);
+
+        *left = node;
+        *right = silk_rope_merge(tail, sub);
+    }
+}
+
+/*******************************************************
+ * @brief insert into the chunk at index if it has room
+ * @param node the root of subtree, could be NULL
+ * @param index the index
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is inserted
+ *******************************************************/
+static bool silk_rope_insert_inplace(struct SilkRopeNode* node, size_t index, const char* data, size_t len)
+{
+    if (node == NULL)
+        return false;
+
+    bool inserted = false;
+    size_t left_size = silk_rope_size(node->left);
+    if (index < left_size)
+    {
+        inserted = silk_rope_insert_inplace(node->left, index, data, len);
+    }
+    else if (index <= left_size + node->length)
+    {
+        if (node->length + len > SILK_ROPE_CHUNK_SIZE)
+            return false;
+
+        size_t offset = index - left_size;
+        silk_overlap_copy(node->data + offset + len, node->data + offset, node->length - offset);
+        silk_copy(node->data + offset, data, len);
+        node->length += len;
+        inserted = true;
+    }
+    else
+    {
+        inserted = silk_rope_insert_inplace(node->right, index - left_size - node->length, data, len);
+    }
+
+    if (inserted)
+        node->size += len;
+    return inserted;
+}
+
+/*******************************************************
+ * @brief get the free bytes of the chunk at index, it is
+ *        the chunk silk_rope_insert_inplace inserts into
+ * @param node the root of subtree, could be NULL
+ * @param index the index
+ * @return the free bytes, 0 if the subtree is empty
+ *******************************************************/
+static size_t silk_rope_room(const struct SilkRopeNode* node, size_t index)
+{
+    while (node != NULL)
+    {
+        size_t left_size = silk_rope_size(node->left);
+        if (index < left_size)
+        {
+            node = node->left;
+        }
+        else if (index <= left_size + node->length)
+        {
+            return SILK_ROPE_CHUNK_SIZE - node->length;
+        }
+        else
+        {
+            index -= left_size + node->length;
+            node = node->right;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************
+ * @brief remove from a chunk if the range is inside it
+ *        and the chunk will not be empty
+ * @param node the root of subtree, could be NULL
+ * @param index the index
+ * @param length the length to be removed
+ * @return whether it is removed
+ *******************************************************/
+static bool silk_rope_remove_inplace(struct SilkRopeNode* node, size_t index, size_t length)
+{
+    if (node == NULL)
+        return false;
+
+    bool removed = false;
+    size_t left_size = silk_rope_size(node->left);
+    if (index < left_size)
+    {
+        removed = silk_rope_remove_inplace(node->left, index, length);
+    }
+    else if (index < left_size + node->length)
+    {
+        size_t offset = index - left_size;
+        if (offset + length > node->length || length == node->length)
+            return false;
+
+        silk_overlap_copy(node->data + offset, node->data + offset + length, node->length - offset - length);
+        node->length -= length;
+        removed = true;
+    }
+    else
+    {
+        removed = silk_rope_remove_inplace(node->right, index - left_size - node->length, length);
+    }
+
+    if (removed)
+        node->size -= length;
+    return removed;
+}
+
+/*******************************************************
+ * @brief append all chunks of a subtree into a string
+ * @param node the root of subtree, could be NULL
+ * @param str the string
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_rope_flatten(const struct SilkRopeNode* node, silk_string_t str)
+{
+    if (node == NULL)
+        return true;
+
+    SILK_ASSERT(silk_rope_flatten(node->left, str), false);
+    SILK_ASSERT(silk_string_appendn(str, node->data, node->length), false);
+    return silk_rope_flatten(node->right, str);
+}
+
+/*******************************************************
+ * @brief create a rope
+ * @note  rope is a balanced tree of text chunks,
+ *        insert, remove and index are O(log n)
+ *        see: https://en.wikipedia.org/wiki/Rope_(data_structure)
+ * @param cstr init value, c-style string
+ * @return the rope
+ *******************************************************/
+silk_rope_t silk_rope_new(const char* cstr)
+{
+    silk_rope_t rope = silk_alloc(sizeof(struct SilkRope));
+    SILK_ASSERT(rope != NULL, NULL);
+
+    rope->root = NULL;
+    rope->spare[0] = NULL;
+    rope->spare[1] = NULL;
+    rope->seed = SILK_ROPE_SEED;
+    SILK_ASSERT(silk_rope_inserts(rope, 0, cstr), silk_rope_delete(rope), NULL);
+    return rope;
+}
+
+/*******************************************************
+ * @brief delete a rope
+ * @param rope the rope to be deleted
+ *******************************************************/
+void silk_rope_delete(silk_rope_t rope)
+{
+    SILK_ASSERT(rope != NULL);
+
+    silk_rope_node_delete(rope->root);
+    silk_rope_node_delete(rope->spare[0]);
+    silk_rope_node_delete(rope->spare[1]);
+    silk_free(rope);
+}
+
+/*******************************************************
+ * @brief clear a rope
+ * @param rope the rope to be cleared
+ *******************************************************/
+void silk_rope_clear(silk_rope_t rope)
+{
+    SILK_ASSERT(rope != NULL);
+
+    silk_rope_node_delete(rope->root);
+    rope->root = NULL;
+}
+
+/*******************************************************
+ * @brief get length of a rope
+ * @param rope the rope
+ * @return the length
+ *******************************************************/
+size_t silk_rope_length(silk_rope_t rope)
+{
+    SILK_ASSERT(rope != NULL, 0);
+
+    return silk_rope_size(rope->root);
+}
+
+/*******************************************************
+ * @brief get char at index of rope
+ * @param rope the rope
+ * @param index the index
+ * @return char at index of rope
+ *******************************************************/
+char silk_rope_at(silk_rope_t rope, size_t index)
+{
+    SILK_ASSERT(rope != NULL, 0);
+    SILK_ASSERT(index < silk_rope_length(rope), 0);
+
+    const struct SilkRopeNode* node = rope->root;
+    for (;;)
+    {
+        size_t left_size = silk_rope_size(node->left);
+        if (index < left_size)
+        {
+            node = node->left;
+        }
+        else if (index < left_size + node->length)
+        {
+            return node->data[index - left_size];
+        }
+        else
+        {
+            index -= left_size + node->length;
+            node = node->right;
+        }
+    }
+}
+
+/*******************************************************
+ * @brief insert character into rope
+ * @param rope the rope
+ * @param index the index
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_insert(silk_rope_t rope, size_t index, char ch)
+{
+    return silk_rope_insertn(rope, index, &ch, 1);
+}
+
+/*******************************************************
+ * @brief insert c-style string into rope
+ * @param rope the rope
+ * @param index the index
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_inserts(silk_rope_t rope, size_t index, const char* cstr)
+{
+    return silk_rope_insertn(rope, index, cstr, cstr == NULL ? 0 : strlen(cstr));
+}
+
+/*******************************************************
+ * @brief insert data with length into rope
+ * @param rope the rope
+ * @param index the index
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_insertn(silk_rope_t rope, size_t index, const char* data, size_t len)
+{
+    SILK_ASSERT(rope != NULL, false);
+    SILK_ASSERT(data != NULL || len == 0, false);
+    SILK_ASSERT(index <= silk_rope_length(rope), false);
+
+    if (len == 0)
+        return true;
+
+    if (silk_rope_insert_inplace(rope->root, index, data, len))
+        return true;
+
+    // the chunk at index is filled up first, or appending in pieces leaves a half empty chunk behind each
+    size_t room = silk_rope_room(rope->root, index);
+
+    // build the new chunks of the rest as a subtree
+    struct SilkRopeNode* middle = NULL;
+    for (size_t offset = room; offset < len; offset += SILK_ROPE_FILL_SIZE)
+    {
+        struct SilkRopeNode* node = silk_rope_node_new(rope);
+        SILK_ASSERT(node != NULL, silk_rope_node_delete(middle), false);
+
+        node->length = len - offset < SILK_ROPE_FILL_SIZE ? len - offset : SILK_ROPE_FILL_SIZE;
+        silk_copy(node->data, data + offset, node->length);
+        silk_rope_update(node);
+        middle = silk_rope_merge(middle, node);
+    }
+
+    SILK_ASSERT(silk_rope_prepare(rope), silk_rope_node_delete(middle), false);
+
+    // nothing fails from here, so a failed insertion leaves the rope as it is
+    if (room > 0)
+        silk_rope_insert_inplace(rope->root, index, data, room);
+
+    struct SilkRopeNode* left;
+    struct SilkRopeNode* right;
+    silk_rope_split(rope, rope->root, index + room, &left, &right);
+    rope->root = silk_rope_merge(silk_rope_merge(left, middle), right);
+    return true;
+}
+
+/*******************************************************
+ * @brief append character into rope
+ * @param rope the rope
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_append(silk_rope_t rope, char ch)
+{
+    SILK_ASSERT(rope != NULL, false);
+
+    return silk_rope_insert(rope, silk_rope_length(rope), ch);
+}
+
+/*******************************************************
+ * @brief append c-style string into rope
+ * @param rope the rope
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_appends(silk_rope_t rope, const char* cstr)
+{
+    SILK_ASSERT(rope != NULL, false);
+
+    return silk_rope_inserts(rope, silk_rope_length(rope), cstr);
+}
+
+/*******************************************************
+ * @brief remove a character from a rope
+ * @param rope the rope
+ * @param index the index
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_remove(silk_rope_t rope, size_t index)
+{
+    return silk_rope_removes(rope, index, 1);
+}
+
+/*******************************************************
+ * @brief remove some characters from a rope
+ * @param rope the rope
+ * @param index the index
+ * @param length the length to be removed
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_removes(silk_rope_t rope, size_t index, size_t length)
+{
+    SILK_ASSERT(rope != NULL, false);
+    SILK_ASSERT(index <= silk_rope_length(rope), false);
+    SILK_ASSERT(length <= silk_rope_length(rope) - index, false);
+
+    if (length == 0)
+        return true;
+
+    if (silk_rope_remove_inplace(rope->root, index, length))
+        return true;
+
+    SILK_ASSERT(silk_rope_prepare(rope), false);
+
+    struct SilkRopeNode* left;
+    struct SilkRopeNode* middle;
+    struct SilkRopeNode* right;
+    silk_rope_split(rope, rope->root, index, &left, &right);
+    silk_rope_split(rope, right, length, &middle, &right);
+    silk_rope_node_delete(middle);
+    rope->root = silk_rope_merge(left, right);
+    return true;
+}
+
+/*******************************************************
+ * @brief move all characters of other to the end of rope
+ *        in O(log n), other becomes empty
+ * @param rope the rope
+ * @param other the rope to be concatenated
+ * @return whether it is successful
+ *******************************************************/
+bool silk_rope_concat(silk_rope_t rope, silk_rope_t other)
+{
+    SILK_ASSERT(rope != NULL, false);
+    SILK_ASSERT(other != NULL, false);
+    SILK_ASSERT(rope != other, false);
+
+    rope->root = silk_rope_merge(rope->root, other->root);
+    other->root = NULL;
+    return true;
+}
+
+/*******************************************************
+ * @brief flatten a rope into a new string
+ * @param rope the rope
+ * @return the string
+ *******************************************************/
+silk_string_t silk_rope_to_string(silk_rope_t rope)
+{
+    SILK_ASSERT(rope != NULL, NULL);
+
+    silk_string_t str = silk_string_new(NULL);
+    SILK_ASSERT(str != NULL, NULL);
+    SILK_ASSERT(silk_string_reserve(str, silk_rope_length(rope)), silk_string_delete(str), NULL);
+    SILK_ASSERT(silk_rope_flatten(rope->root, str), silk_string_delete(str), NULL);
+    return str;
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include <silk/set.h>
+#include <silk/log.h>
+#include <silk/utils.h>
+
+#include <string.h>
+
+#include "map_inner.h"
+
+// elements hashed and prefetched ahead in bulk operations
+#define SILK_SET_BATCH          16
+
+// modes of merging, put elements of source into result: all of them, which are not in result,
+// which are in other, which are not in other
+#define SILK_SET_MERGE_PLACE            0
+#define SILK_SET_MERGE_INSERT           1
+#define SILK_SET_MERGE_CONTAINED        2
+#define SILK_SET_MERGE_NOT_CONTAINED    3
+
+// a set is a map without values, its elements are the keys
+struct SilkSet
+{
+    silk_map_t map;
+};
+
+/*******************************************************
+ * @brief put elements of source into result in batches,
+ *        the slots to be probed are prefetched before
+ * @param result the result map, prepared
+ * @param source the source map
+ * @param other the map to be probed, or NULL to probe
+ *              result
+ * @param mode one of SILK_SET_MERGE_*
+ *******************************************************/
+static void silk_set_merge(silk_map_t result, silk_map_t source, silk_map_t other, int mode)
+{
+    silk_map_t probed = other != NULL ? other : result;
+    size_t batch[SILK_SET_BATCH];
+    size_t count = 0;
+    for (size_t i = 0; i <= source->capacity; i++)
+    {
+        // collect a batch, then process it, and the rest at the end
+        if (i < source->capacity)
+        {
+            uint32_t hash = source->hashes[i];
+            if (hash <= SILK_MAP_DELETED)
+                continue;
+
+            size_t pos = hash & (probed->capacity - 1);
+            SILK_PREFETCH(&probed->hashes[pos]);
+            SILK_PREFETCH(SILK_MAP_ENTRY(probed, pos));
+            batch[count++] = i;
+            if (count < SILK_SET_BATCH)
+                continue;
+        }
+
+        for (size_t j = 0; j < count; j++)
+        {
+            const void* data = SILK_MAP_ENTRY(source, batch[j]);
+            uint32_t hash = source->hashes[batch[j]];
+            switch (mode)
+            {
+            case SILK_SET_MERGE_PLACE:
+                silk_map_place(result, data, hash);
+                break;
+            case SILK_SET_MERGE_INSERT:
+                if (silk_map_lookup(result, data, hash) == SILK_INVALID_INDEX)
+                    silk_map_place(result, data, hash);
+                break;
+            case SILK_SET_MERGE_CONTAINED:
+                if (silk_map_lookup(other, data, hash) != SILK_INVALID_INDEX)
+                    silk_map_place(result, data, hash);
+                break;
+            default:
+                if (silk_map_lookup(other, data, hash) == SILK_INVALID_INDEX)
+                    silk_map_place(result, data, hash);
+                break;
+            }
+        }
+        count = 0;
+    }
+}
+
+/*******************************************************
+ * @brief create a hash set
+ * @note  elements are compared and hashed byte by byte,
+ *        strings could be stored as handles of silk_intern,
+ *        it is open addressing with linear probing
+ * @param element_size size of each element
+ * @return the set
+ *******************************************************/
+silk_set_t silk_set_new(size_t element_size)
+{
+    SILK_ASSERT(element_size > 0, NULL);
+
+    silk_set_t set = silk_alloc(sizeof(struct SilkSet));
+    SILK_ASSERT(set != NULL, NULL);
+
+    set->map = silk_map_new(element_size, 0);
+    SILK_ASSERT(set->map != NULL, silk_free(set), NULL);
+    return set;
+}
+
+/*******************************************************
+ * @brief delete a hash set
+ * @param set the set to be deleted
+ *******************************************************/
+void silk_set_delete(silk_set_t set)
+{
+    SILK_ASSERT(set != NULL);
+
+    silk_map_delete(set->map);
+    silk_free(set);
+}
+
+/*******************************************************
+ * @brief clear a hash set, the capacity is kept
+ * @param set the set to be cleared
+ *******************************************************/
+void silk_set_clear(silk_set_t set)
+{
+    SILK_ASSERT(set != NULL);
+
+    silk_map_clear(set->map);
+}
+
+/*******************************************************
+ * @brief get the element size of a hash set
+ * @param set the set
+ * @return the element size
+ *******************************************************/
+size_t silk_set_element_size(silk_set_t set)
+{
+    SILK_ASSERT(set != NULL, 0);
+
+    return set->map->key_size;
+}
+
+/*******************************************************
+ * @brief get the count of elements of a hash set
+ * @param set the set
+ * @return the count of elements
+ *******************************************************/
+size_t silk_set_length(silk_set_t set)
+{
+    SILK_ASSERT(set != NULL, 0);
+
+    return set->map->length;
+}
+
+/*******************************************************
+ * @brief reserve enough memory of a hash set
+ * @param set the set
+ * @param count the count of elements could be held
+ *              without rehashing
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_reserve(silk_set_t set, size_t count)
+{
+    SILK_ASSERT(set != NULL, false);
+
+    return silk_map_reserve(set->map, count);
+}
+
+/*******************************************************
+ * @brief insert an element into a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is successful, it is true if the
+ *         element is already in the set
+ *******************************************************/
+bool silk_set_insert(silk_set_t set, const void* data)
+{
+    SILK_ASSERT(set != NULL, false);
+    SILK_ASSERT(data != NULL, false);
+
+    return silk_map_emplace(set->map, data, NULL) != NULL;
+}
+
+/*******************************************************
+ * @brief insert elements of an array into a hash set,
+ *        the set is reserved first, and elements are
+ *        hashed and prefetched in batches
+ * @param set the set
+ * @param data the elements, adjacent
+ * @param count count of elements
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_insert_bulk(silk_set_t set, const void* data, size_t count)
+{
+    SILK_ASSERT(set != NULL, false);
+    SILK_ASSERT(data != NULL || count == 0, false);
+
+    silk_map_t map = set->map;
+    SILK_ASSERT(silk_map_prepare(map, count), false);
+
+    const uint8_t* elements = data;
+    uint32_t hashes[SILK_SET_BATCH];
+    for (size_t i = 0; i < count; i += SILK_SET_BATCH)
+    {
+        size_t n = count - i < SILK_SET_BATCH ? count - i : SILK_SET_BATCH;
+        for (size_t j = 0; j < n; j++)
+        {
+            hashes[j] = silk_map_hash(map, elements + (i + j) * map->key_size);
+            SILK_PREFETCH(&map->hashes[hashes[j] & (map->capacity - 1)]);
+        }
+
+        for (size_t j = 0; j < n; j++)
+        {
+            const void* element = elements + (i + j) * map->key_size;
+            if (silk_map_lookup(map, element, hashes[j]) == SILK_INVALID_INDEX)
+                silk_map_place(map, element, hashes[j]);
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief remove an element from a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is removed, false if it is not in
+ *         the set
+ *******************************************************/
+bool silk_set_remove(silk_set_t set, const void* data)
+{
+    SILK_ASSERT(set != NULL, false);
+    SILK_ASSERT(data != NULL, false);
+
+    return silk_map_erase(set->map, data);
+}
+
+/*******************************************************
+ * @brief determine whether an element is in a hash set
+ * @param set the set
+ * @param data the element
+ * @return whether it is in the set
+ *******************************************************/
+bool silk_set_contains(silk_set_t set, const void* data)
+{
+    SILK_ASSERT(set != NULL, false);
+    SILK_ASSERT(data != NULL, false);
+
+    return silk_map_find(set->map, data) != NULL;
+}
+
+/*******************************************************
+ * @brief invoke callback for every elements like
+ *        data = callback(data, element), elements must
+ *        not be modified
+ * @param set the set
+ * @param callback the callback function
+ * @param data the data input init value and output result
+ * @return whether it is successful
+ *******************************************************/
+bool silk_set_reduce(silk_set_t set, silk_reduce_callback_t callback, void* data)
+{
+    SILK_ASSERT(set != NULL, false);
+    SILK_ASSERT(callback != NULL, false);
+
+    silk_map_t map = set->map;
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->hashes[i] > SILK_MAP_DELETED)
+            callback(data, SILK_MAP_ENTRY(map, i));
+    }
+
+    return true;
+}
+
+/*******************************************************
+ * @brief copy elements of a hash set into a new vector,
+ *        they are not sorted
+ * @param set the set
+ * @return the vector
+ *******************************************************/
+silk_vector_t silk_set_to_vector(silk_set_t set)
+{
+    SILK_ASSERT(set != NULL, NULL);
+
+    silk_map_t map = set->map;
+    silk_vector_t vector = silk_vector_new(map->key_size);
+    SILK_ASSERT(vector != NULL, NULL);
+    SILK_ASSERT(silk_vector_resize(vector, map->length), silk_vector_delete(vector), NULL);
+
+    uint8_t* data = silk_vector_data(vector);
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->hashes[i] > SILK_MAP_DELETED)
+        {
+            memcpy(data, SILK_MAP_ENTRY(map, i), map->key_size);
+            data += map->key_size;
+        }
+    }
+
+    return vector;
+}
+
+/*******************************************************
+ * @brief create a set of elements in either set
+ * @note  the result is reserved once, and elements are
+ *        probed in batches with the slots prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the union set
+ *******************************************************/
+silk_set_t silk_set_union(silk_set_t x, silk_set_t y)
+{
+    SILK_ASSERT(x != NULL && y != NULL, NULL);
+    SILK_ASSERT(x->map->key_size == y->map->key_size, NULL);
+
+    // elements of the larger one are placed without comparing
+    if (x->map->length < y->map->length)
+    {
+        silk_set_t temp = x;
+        x = y;
+        y = temp;
+    }
+
+    silk_set_t result = silk_set_new(x->map->key_size);
+    SILK_ASSERT(result != NULL, NULL);
+    SILK_ASSERT(silk_map_reserve(result->map, x->map->length + y->map->length), silk_set_delete(result), NULL);
+
+    silk_set_merge(result->map, x->map, NULL, SILK_SET_MERGE_PLACE);
+    silk_set_merge(result->map, y->map, NULL, SILK_SET_MERGE_INSERT);
+    return result;
+}
+
+/*******************************************************
+ * @brief create a set of elements in both sets
+ * @note  elements of the smaller set are probed in the
+ *        larger set in batches with the slots prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the intersection set
+ *******************************************************/
+silk_set_t silk_set_intersect(silk_set_t x, silk_set_t y)
+{
+    SILK_ASSERT(x != NULL && y != NULL, NULL);
+    SILK_ASSERT(x->map->key_size == y->map->key_size, NULL);
+
+    if (x->map->length > y->map->length)
+    {
+        silk_set_t temp = x;
+        x = y;
+        y = temp;
+    }
+
+    silk_set_t result = silk_set_new(x->map->key_size);
+    SILK_ASSERT(result != NULL, NULL);
+    SILK_ASSERT(silk_map_reserve(result->map, x->map->length), silk_set_delete(result), NULL);
+
+    silk_set_merge(result->map, x->map, y->map, SILK_SET_MERGE_CONTAINED);
+    return result;
+}
+
+/*******************************************************
+ * @brief create a set of elements in x but not in y
+ * @note  elements are probed in batches with the slots
+ *        prefetched
+ * @param x a set
+ * @param y a set of the same element size
+ * @return the difference set
+ *******************************************************/
+silk_set_t silk_set_difference(silk_set_t x, silk_set_t y)
+{
+    SILK_ASSERT(x != NULL && y != NULL, NULL);
+    SILK_ASSERT(x->map->key_size == y->map->key_size, NULL);
+
+    silk_set_t result = silk_set_new(x->map->key_size);
+    SILK_ASSERT(result != NULL, NULL);
+    SILK_ASSERT(silk_map_reserve(result->map, x->map->length), silk_set_delete(result), NULL);
+
+    silk_set_merge(result->map, x->map, y->map, SILK_SET_MERGE_NOT_CONTAINED);
+    return result;
+}
\ No newline at end of file
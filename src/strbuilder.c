@@ -0,0 +1,352 @@
+#include <silk/strbuilder.h>
+#include <silk/log.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+// bytes of data in each chunk
+#define SILK_STRBUILDER_CHUNK_SIZE  4096
+
+// pieces larger than it get a chunk of their own
+#define SILK_STRBUILDER_LARGE_SIZE  (SILK_STRBUILDER_CHUNK_SIZE / 2)
+
+// count of chunks gathered by one writev
+#define SILK_STRBUILDER_IOV_COUNT   64
+
+struct SilkStrbuilderChunk
+{
+    struct SilkStrbuilderChunk* next;
+    char* data;                     // follows the chunk header
+    size_t length;
+    size_t capacity;
+};
+
+struct SilkStrbuilder
+{
+    struct SilkStrbuilderChunk* head;
+    struct SilkStrbuilderChunk* tail;
+    size_t length;
+};
+
+/*******************************************************
+ * @brief alloc a chunk with its data
+ * @param capacity bytes of data
+ * @return the chunk
+ *******************************************************/
+static struct SilkStrbuilderChunk* silk_strbuilder_chunk_new(size_t capacity)
+{
+    struct SilkStrbuilderChunk* chunk = silk_alloc(sizeof(struct SilkStrbuilderChunk) + capacity);
+    SILK_ASSERT(chunk != NULL, NULL);
+
+    chunk->next = NULL;
+    chunk->data = (char*)(chunk + 1);
+    chunk->length = 0;
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+/*******************************************************
+ * @brief add a chunk at the end of chain
+ * @param builder the string builder
+ * @param capacity bytes of data
+ * @return the chunk
+ *******************************************************/
+static struct SilkStrbuilderChunk* silk_strbuilder_grow(silk_strbuilder_t builder, size_t capacity)
+{
+    struct SilkStrbuilderChunk* chunk = silk_strbuilder_chunk_new(capacity);
+    SILK_ASSERT(chunk != NULL, NULL);
+
+    builder->tail->next = chunk;
+    builder->tail = chunk;
+    return chunk;
+}
+
+/*******************************************************
+ * @brief create a string builder
+ * @note  appended data is collected in a chain of chunks
+ *        and never moved, it is copied only once when the
+ *        result is materialized or written
+ * @return the string builder
+ *******************************************************/
+silk_strbuilder_t silk_strbuilder_new(void)
+{
+    silk_strbuilder_t builder = silk_alloc(sizeof(struct SilkStrbuilder));
+    SILK_ASSERT(builder != NULL, NULL);
+
+    builder->head = silk_strbuilder_chunk_new(SILK_STRBUILDER_CHUNK_SIZE);
+    SILK_ASSERT(builder->head != NULL, silk_free(builder), NULL);
+
+    builder->tail = builder->head;
+    builder->length = 0;
+    return builder;
+}
+
+/*******************************************************
+ * @brief delete a string builder
+ * @param builder the string builder to be deleted
+ *******************************************************/
+void silk_strbuilder_delete(silk_strbuilder_t builder)
+{
+    SILK_ASSERT(builder != NULL);
+
+    silk_strbuilder_clear(builder);
+    silk_free(builder->head);
+    silk_free(builder);
+}
+
+/*******************************************************
+ * @brief clear a string builder, the first chunk is kept
+ *        for reuse
+ * @param builder the string builder to be cleared
+ *******************************************************/
+void silk_strbuilder_clear(silk_strbuilder_t builder)
+{
+    SILK_ASSERT(builder != NULL);
+
+    struct SilkStrbuilderChunk* chunk = builder->head->next;
+    while (chunk != NULL)
+    {
+        struct SilkStrbuilderChunk* next = chunk->next;
+        silk_free(chunk);
+        chunk = next;
+    }
+
+    builder->head->next = NULL;
+    builder->head->length = 0;
+    builder->tail = builder->head;
+    builder->length = 0;
+}
+
+/*******************************************************
+ * @brief get length of data in a string builder
+ * @param builder the string builder
+ * @return the length
+ *******************************************************/
+size_t silk_strbuilder_length(silk_strbuilder_t builder)
+{
+    SILK_ASSERT(builder != NULL, 0);
+
+    return builder->length;
+}
+
+/*******************************************************
+ * @brief append character into string builder
+ * @param builder the string builder
+ * @param ch the character
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_append(silk_strbuilder_t builder, char ch)
+{
+    return silk_strbuilder_appendn(builder, &ch, 1);
+}
+
+/*******************************************************
+ * @brief append c-style string into string builder
+ * @param builder the string builder
+ * @param cstr the c-style string
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appends(silk_strbuilder_t builder, const char* cstr)
+{
+    return silk_strbuilder_appendn(builder, cstr, cstr == NULL ? 0 : strlen(cstr));
+}
+
+/*******************************************************
+ * @brief append data with length into string builder
+ * @param builder the string builder
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appendn(silk_strbuilder_t builder, const char* data, size_t len)
+{
+    SILK_ASSERT(builder != NULL, false);
+    SILK_ASSERT(data != NULL || len == 0, false);
+
+    struct SilkStrbuilderChunk* chunk = builder->tail;
+    size_t remain = chunk->capacity - chunk->length;
+    if (len > remain)
+    {
+        if (len > SILK_STRBUILDER_LARGE_SIZE)
+        {
+            // a dedicated chunk, the rest of the current chunk is wasted
+            chunk = silk_strbuilder_grow(builder, len);
+            SILK_ASSERT(chunk != NULL, false);
+        }
+        else
+        {
+            // fill the current chunk, then continue in a new one
+            if (remain > 0)
+            {
+                silk_copy(chunk->data + chunk->length, data, remain);
+                chunk->length += remain;
+                builder->length += remain;
+                data += remain;
+                len -= remain;
+            }
+
+            chunk = silk_strbuilder_grow(builder, SILK_STRBUILDER_CHUNK_SIZE);
+            SILK_ASSERT(chunk != NULL, false);
+        }
+    }
+
+    if (len > 0)
+    {
+        silk_copy(chunk->data + chunk->length, data, len);
+        chunk->length += len;
+        builder->length += len;
+    }
+    return true;
+}
+
+/*******************************************************
+ * @brief append formatted data into string builder
+ * @param builder the string builder
+ * @param fmt the format, same as printf
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_appendf(silk_strbuilder_t builder, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    bool ok = silk_strbuilder_vappendf(builder, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+/*******************************************************
+ * @brief append formatted data into string builder
+ * @param builder the string builder
+ * @param fmt the format, same as vprintf
+ * @param args the arguments
+ * @return whether it is successful
+ *******************************************************/
+bool silk_strbuilder_vappendf(silk_strbuilder_t builder, const char* fmt, va_list args)
+{
+    SILK_ASSERT(builder != NULL, false);
+    SILK_ASSERT(fmt != NULL, false);
+
+    // format into the rest of the current chunk directly, vsnprintf needs a byte for '\0'
+    struct SilkStrbuilderChunk* chunk = builder->tail;
+    size_t remain = chunk->capacity - chunk->length;
+    char tail[1];
+    va_list copied;
+    va_copy(copied, args);
+    int n = vsnprintf(remain > 0 ? chunk->data + chunk->length : tail, remain > 0 ? remain : 1, fmt, copied);
+    va_end(copied);
+    if (n < 0)
+        return false;
+
+    if ((size_t)n >= remain)
+    {
+        // not enough, format into a new chunk which could hold it
+        size_t capacity = (size_t)n + 1 > SILK_STRBUILDER_CHUNK_SIZE ? (size_t)n + 1 : SILK_STRBUILDER_CHUNK_SIZE;
+        chunk = silk_strbuilder_grow(builder, capacity);
+        SILK_ASSERT(chunk != NULL, false);
+        vsnprintf(chunk->data, capacity, fmt, args);
+    }
+
+    chunk->length += (size_t)n;
+    builder->length += (size_t)n;
+    return true;
+}
+
+/*******************************************************
+ * @brief materialize the data into a new string, it is
+ *        allocated once with the exact size
+ * @param builder the string builder
+ * @return the string
+ *******************************************************/
+silk_string_t silk_strbuilder_to_string(silk_strbuilder_t builder)
+{
+    SILK_ASSERT(builder != NULL, NULL);
+
+    silk_string_t str = silk_string_new(NULL);
+    SILK_ASSERT(str != NULL, NULL);
+    SILK_ASSERT(silk_string_resize(str, builder->length), silk_string_delete(str), NULL);
+
+    char* p = silk_string_data(str);
+    for (struct SilkStrbuilderChunk* chunk = builder->head; chunk != NULL; chunk = chunk->next)
+    {
+        if (chunk->length == 0)
+            continue;
+
+        silk_copy(p, chunk->data, chunk->length);
+        p += chunk->length;
+    }
+    return str;
+}
+
+/*******************************************************
+ * @brief write the data into a file descriptor, the
+ *        chunks are gathered by writev on POSIX
+ * @param builder the string builder
+ * @param fd the file descriptor
+ * @return whether all data is written
+ *******************************************************/
+bool silk_strbuilder_write(silk_strbuilder_t builder, int fd)
+{
+    SILK_ASSERT(builder != NULL, false);
+    SILK_ASSERT(fd >= 0, false);
+
+    struct SilkStrbuilderChunk* chunk = builder->head;
+    size_t offset = 0; // bytes of the current chunk written
+
+#if defined(_WIN32)
+    for (; chunk != NULL; chunk = chunk->next, offset = 0)
+    {
+        while (offset < chunk->length)
+        {
+            size_t remain = chunk->length - offset;
+            unsigned size = remain > INT32_MAX ? INT32_MAX : (unsigned)remain;
+            int n = _write(fd, chunk->data + offset, size);
+            if (n <= 0)
+                return false;
+            offset += (size_t)n;
+        }
+    }
+#else
+    while (chunk != NULL)
+    {
+        struct iovec iov[SILK_STRBUILDER_IOV_COUNT];
+        int count = 0;
+        for (struct SilkStrbuilderChunk* p = chunk; p != NULL && count < SILK_STRBUILDER_IOV_COUNT; p = p->next)
+        {
+            size_t skip = p == chunk ? offset : 0;
+            if (p->length == skip)
+                continue;
+            iov[count].iov_base = p->data + skip;
+            iov[count].iov_len = p->length - skip;
+            count++;
+        }
+
+        if (count == 0)
+            break;
+
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+
+        // advance over the written bytes, the last chunk may be written partially
+        size_t written = (size_t)n + offset;
+        while (chunk != NULL && written >= chunk->length)
+        {
+            written -= chunk->length;
+            chunk = chunk->next;
+        }
+        offset = written;
+    }
+#endif
+
+    return true;
+}
\ No newline at end of file
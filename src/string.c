@@ -1,14 +1,28 @@
 #include <silk/string.h>
+#include <silk/cpu.h>
+#include <silk/hash.h>
 #include <silk/log.h>
+#include <silk/number.h>
+#include <silk/utf8.h>
 #include <silk/vector.h>
 
+#include <stdio.h>
 #include <string.h>
 
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
 struct SilkString
 {
     silk_vector_t data;
+    uint32_t hash;      // cached value of silk_string_hash
+    bool hashed;        // whether the cached hash is valid
 };
 
+// drop the cached hash, must be called by every modification
+#define SILK_STRING_MODIFIED(S)     ((S)->hashed = false)
+
 /*******************************************************
  * @brief create a string
  * @param cstr init value, c-style string
@@ -21,6 +35,8 @@ silk_string_t silk_string_new(const char* cstr)
 
     str->data = silk_vector_new(sizeof(char));
     SILK_ASSERT(str->data, silk_free(str), NULL);
+    str->hash = 0;
+    str->hashed = false;
     
     size_t len = cstr == NULL ? 0 : strlen(cstr);
     if (len > 0)
@@ -56,6 +72,7 @@ void silk_string_clear(silk_string_t str)
     SILK_ASSERT(str != NULL);
     SILK_ASSERT(str->data != NULL);
 
+    SILK_STRING_MODIFIED(str);
     silk_vector_clear(str->data);
     SILK_ASSERT(silk_vector_append(str->data, "\0")); // always keep '\0' as end
 }
@@ -136,6 +153,11 @@ size_t silk_string_length(silk_string_t str)
 
 /*******************************************************
  * @brief get string value as c-style string
+ * @note  the cached hash is dropped by this call, not by
+ *        writes through the pointer, so after
+ *        silk_string_hash or silk_string_equal, call it
+ *        again before writing, or the stale hash could
+ *        make equal strings compare unequal
  * @param str the string to be get
  * @return c-style string value
  *******************************************************/
@@ -143,6 +165,8 @@ char* silk_string_data(silk_string_t str)
 {
     SILK_ASSERT(str != NULL, NULL);
     
+    // the caller may modify the string through the pointer
+    SILK_STRING_MODIFIED(str);
     return silk_vector_data(str->data);
 }
 
@@ -157,7 +181,37 @@ bool silk_string_equal(silk_string_t str1, silk_string_t str2)
     SILK_ASSERT(str1 != NULL, false);
     SILK_ASSERT(str2 != NULL, false);
 
-    return (strcmp(silk_string_get(str1), silk_string_get(str2)) == 0);
+    if (str1 == str2)
+        return true;
+
+    size_t length = silk_string_length(str1);
+    if (length != silk_string_length(str2))
+        return false;
+
+    if (str1->hashed && str2->hashed && str1->hash != str2->hash)
+        return false;
+
+    return memcmp(silk_string_get(str1), silk_string_get(str2), length) == 0;
+}
+
+/*******************************************************
+ * @brief get the hash value of a string
+ * @note  the value is calculated by silk_hash_murmur3_32
+ *        with seed 0 and cached until the string is 
+ *        modified
+ * @param str the string
+ * @return the hash value
+ *******************************************************/
+uint32_t silk_string_hash(silk_string_t str)
+{
+    SILK_ASSERT(str != NULL, 0);
+
+    if (!str->hashed)
+    {
+        str->hash = silk_hash_murmur3_32(silk_string_get(str), silk_string_length(str), 0);
+        str->hashed = true;
+    }
+    return str->hash;
 }
 
 /*******************************************************
@@ -186,6 +240,7 @@ bool silk_string_insert(silk_string_t str, size_t index, char ch)
     SILK_ASSERT(str != NULL, false);
     SILK_ASSERT(index <= silk_string_length(str), false);
     
+    SILK_STRING_MODIFIED(str);
     return silk_vector_insert(str->data, index, &ch);
 }
 
@@ -204,6 +259,7 @@ bool silk_string_inserts(silk_string_t str, size_t index, const char* cstr)
     size_t len = cstr == NULL ? 0 : strlen(cstr);
     if (len > 0)
     {
+        SILK_STRING_MODIFIED(str);
         SILK_ASSERT(silk_vector_inserts(str->data, index, cstr, len));
     }
     return true;
@@ -237,6 +293,57 @@ bool silk_string_appends(silk_string_t str, const char* cstr)
     return silk_string_inserts(str, silk_string_length(str), cstr);
 }
 
+/*******************************************************
+ * @brief append data with length into string
+ * @param str the string
+ * @param data the data, could contain '\0'
+ * @param len length of the data
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_appendn(silk_string_t str, const char* data, size_t len)
+{
+    SILK_ASSERT(str != NULL, false);
+    SILK_ASSERT(data != NULL || len == 0, false);
+
+    if (len > 0)
+    {
+        SILK_STRING_MODIFIED(str);
+        SILK_ASSERT(silk_vector_inserts(str->data, silk_string_length(str), data, len), false);
+    }
+    return true;
+}
+
+/*******************************************************
+ * @brief reserve enough memory of a string
+ * @param str the string
+ * @param capacity the length could be held without 
+ *                 reallocating, not including the '\0'
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_reserve(silk_string_t str, size_t capacity)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    return silk_vector_reserve(str->data, capacity + 1);
+}
+
+/*******************************************************
+ * @brief resize a string, new characters are uninitialized,
+ *        they could be written by silk_string_data
+ * @param str the string
+ * @param length the new length, not including the '\0'
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_resize(silk_string_t str, size_t length)
+{
+    SILK_ASSERT(str != NULL, false);
+    SILK_ASSERT(silk_vector_resize(str->data, length + 1), false);
+
+    SILK_STRING_MODIFIED(str);
+    silk_string_data(str)[length] = '\0';
+    return true;
+}
+
 /*******************************************************
  * @brief remove a character from a string
  * @param str the string
@@ -248,6 +355,7 @@ bool silk_string_remove(silk_string_t str, size_t index)
     SILK_ASSERT(str != NULL, false);
     SILK_ASSERT(index < silk_string_length(str), false);
 
+    SILK_STRING_MODIFIED(str);
     return silk_vector_removes(str->data, index, 1); 
 }
 
@@ -263,5 +371,500 @@ bool silk_string_removes(silk_string_t str, size_t index, size_t length)
     SILK_ASSERT(str != NULL, false);
     SILK_ASSERT(index + length < silk_string_length(str), false);
 
+    SILK_STRING_MODIFIED(str);
     return silk_vector_removes(str->data, index, length);
+}
+
+/*******************************************************
+ * @brief append formatted data into string, it is
+ *        formatted into the spare capacity directly
+ * @param str the string
+ * @param fmt the format, same as printf
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_appendf(silk_string_t str, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    bool ok = silk_string_vappendf(str, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+/*******************************************************
+ * @brief append formatted data into string, it is
+ *        formatted into the spare capacity directly
+ * @param str the string
+ * @param fmt the format, same as vprintf
+ * @param args the arguments
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_vappendf(silk_string_t str, const char* fmt, va_list args)
+{
+    SILK_ASSERT(str != NULL, false);
+    SILK_ASSERT(fmt != NULL, false);
+
+    size_t length = silk_string_length(str);
+    size_t room = silk_vector_capacity(str->data) - length; // including the '\0'
+
+    va_list copied;
+    va_copy(copied, args);
+    int n = vsnprintf(silk_string_data(str) + length, room, fmt, copied);
+    va_end(copied);
+    if (n < 0)
+    {
+        silk_string_data(str)[length] = '\0';
+        return false;
+    }
+
+    if ((size_t)n >= room)
+    {
+        // not enough, grow once to the exact size
+        SILK_ASSERT(silk_vector_reserve(str->data, length + (size_t)n + 1), silk_string_data(str)[length] = '\0', false);
+        vsnprintf(silk_string_data(str) + length, (size_t)n + 1, fmt, args);
+    }
+
+    return silk_vector_resize(str->data, length + (size_t)n + 1);
+}
+
+/*******************************************************
+ * @brief append a signed integer in decimal into string
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_int64(silk_string_t str, int64_t value)
+{
+    char buffer[SILK_NUMBER_INT_BUFFER_SIZE];
+    size_t length = silk_number_format_int64(buffer, value);
+    return silk_string_appendn(str, buffer, length);
+}
+
+/*******************************************************
+ * @brief append an unsigned integer in decimal into string
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_uint64(silk_string_t str, uint64_t value)
+{
+    char buffer[SILK_NUMBER_INT_BUFFER_SIZE];
+    size_t length = silk_number_format_uint64(buffer, value);
+    return silk_string_appendn(str, buffer, length);
+}
+
+/*******************************************************
+ * @brief append a double into string, with text which
+ *        reads back to the same value, it is the shortest
+ *        in nearly all cases, but not guaranteed, the
+ *        decimal point is always '.' whatever the locale
+ * @param str the string
+ * @param value the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_append_double(silk_string_t str, double value)
+{
+    char buffer[SILK_NUMBER_DOUBLE_BUFFER_SIZE];
+    size_t length = silk_number_format_double(buffer, value);
+    return silk_string_appendn(str, buffer, length);
+}
+
+/*******************************************************
+ * @brief parse a decimal integer from data with length
+ *        such as "-123", "+45" or "67", the whole range
+ *        must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_int64(const char* data, size_t len, int64_t* value)
+{
+    return silk_number_parse_int64(data, len, value);
+}
+
+/*******************************************************
+ * @brief parse a decimal unsigned integer from data 
+ *        with length such as "+45" or "67", the whole
+ *        range must be the integer
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_uint64(const char* data, size_t len, uint64_t* value)
+{
+    return silk_number_parse_uint64(data, len, value);
+}
+
+/*******************************************************
+ * @brief parse a double from data with length, such as
+ *        "-1.5", "2e10", ".5", "inf" or "nan", the whole
+ *        range must be the number, the decimal point is
+ *        always '.' whatever the locale
+ * @param data the data, need not be '\0' terminated
+ * @param len length of the data
+ * @param value return the value
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_to_double(const char* data, size_t len, double* value)
+{
+    return silk_number_parse_double(data, len, value);
+}
+
+/*******************************************************
+ * @brief determine whether a string is valid UTF-8
+ * @param str the string
+ * @return whether it is valid UTF-8
+ *******************************************************/
+bool silk_string_utf8_validate(silk_string_t str)
+{
+    SILK_ASSERT(str != NULL, false);
+
+    return silk_utf8_validate(silk_vector_const_data(str->data), silk_string_length(str));
+}
+
+/*******************************************************
+ * @brief get length of a string in UTF-8 code points,
+ *        silk_string_length is in bytes
+ * @param str the string, should be valid UTF-8
+ * @return the count of code points
+ *******************************************************/
+size_t silk_string_utf8_length(silk_string_t str)
+{
+    SILK_ASSERT(str != NULL, 0);
+
+    return silk_utf8_length(silk_vector_const_data(str->data), silk_string_length(str));
+}
+
+/*******************************************************
+ * @brief convert an ascii char to lowercase
+ * @param ch the char
+ * @return the lowercase char
+ *******************************************************/
+static inline uint8_t silk_string_ascii_lower(uint8_t ch)
+{
+    return (uint8_t)(ch | ((uint8_t)(ch - 'A') < 26 ? 0x20 : 0));
+}
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief mark ascii letters in [first, first+26) by SSE2
+ * @param input 16 chars
+ * @param first 'A' for uppercase, 'a' for lowercase
+ * @return 0xFF for the letters, 0 for others
+ *******************************************************/
+SILK_TARGET("sse2")
+static inline __m128i silk_string_letter_mask_sse2(__m128i input, uint8_t first)
+{
+    // move the range to [-128, -102], then one signed compare is enough
+    __m128i shifted = _mm_add_epi8(input, _mm_set1_epi8((char)(0x80 - first)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+}
+#endif
+
+/*******************************************************
+ * @brief flip case of ascii letters in [first, first+26)
+ * @param data the data
+ * @param len length of the data
+ * @param first 'A' to lower, 'a' to upper
+ *******************************************************/
+static void silk_string_flip_case(uint8_t* data, size_t len, uint8_t first)
+{
+    size_t i = 0;
+#if defined(SILK_CPU_X86)
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSE2))
+    {
+        for (; len - i >= 16; i += 16)
+        {
+            __m128i input = _mm_loadu_si128((const __m128i*)(data + i));
+            __m128i mask = silk_string_letter_mask_sse2(input, first);
+            input = _mm_xor_si128(input, _mm_and_si128(mask, _mm_set1_epi8(0x20)));
+            _mm_storeu_si128((__m128i*)(data + i), input);
+        }
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        if ((uint8_t)(data[i] - first) < 26)
+            data[i] ^= 0x20;
+    }
+}
+
+/*******************************************************
+ * @brief convert ascii letters of a string to lowercase
+ *        in place, other bytes are not changed
+ * @param str the string
+ *******************************************************/
+void silk_string_to_lower(silk_string_t str)
+{
+    SILK_ASSERT(str != NULL);
+
+    SILK_STRING_MODIFIED(str);
+    silk_string_flip_case(silk_vector_data(str->data), silk_string_length(str), 'A');
+}
+
+/*******************************************************
+ * @brief convert ascii letters of a string to uppercase
+ *        in place, other bytes are not changed
+ * @param str the string
+ *******************************************************/
+void silk_string_to_upper(silk_string_t str)
+{
+    SILK_ASSERT(str != NULL);
+
+    SILK_STRING_MODIFIED(str);
+    silk_string_flip_case(silk_vector_data(str->data), silk_string_length(str), 'a');
+}
+
+/*******************************************************
+ * @brief find the first position where two buffers are
+ *        different ignoring ascii case
+ * @param x a buffer
+ * @param y a buffer
+ * @param len length of both buffers
+ * @return the position, or len if they are equal
+ *******************************************************/
+static size_t silk_string_mismatch_nocase(const uint8_t* x, const uint8_t* y, size_t len)
+{
+    size_t i = 0;
+#if defined(SILK_CPU_X86)
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSE2))
+    {
+        const __m128i bit = _mm_set1_epi8(0x20);
+        for (; len - i >= 16; i += 16)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(x + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(y + i));
+            a = _mm_or_si128(a, _mm_and_si128(silk_string_letter_mask_sse2(a, 'A'), bit));
+            b = _mm_or_si128(b, _mm_and_si128(silk_string_letter_mask_sse2(b, 'A'), bit));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+                break;
+        }
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        if (silk_string_ascii_lower(x[i]) != silk_string_ascii_lower(y[i]))
+            break;
+    }
+    return i;
+}
+
+/*******************************************************
+ * @brief determine whether two string are equal
+ *        ignoring ascii case
+ * @param str1 the string to be determine
+ * @param str2 the string to be determine
+ * @return whether two string are equal
+ *******************************************************/
+bool silk_string_equal_nocase(silk_string_t str1, silk_string_t str2)
+{
+    SILK_ASSERT(str1 != NULL, false);
+    SILK_ASSERT(str2 != NULL, false);
+
+    size_t length = silk_string_length(str1);
+    if (length != silk_string_length(str2))
+        return false;
+
+    if (str1 == str2 || length == 0)
+        return true;
+
+    return silk_string_mismatch_nocase(silk_vector_const_data(str1->data), 
+                                       silk_vector_const_data(str2->data), length) == length;
+}
+
+/*******************************************************
+ * @brief compare two string ignoring ascii case, bytes
+ *        are compared as unsigned char after converted
+ *        to lowercase, like strcasecmp
+ * @param str1 the string to be compared
+ * @param str2 the string to be compared
+ * @return negative value while str1 < str2
+ *         positive value while str1 > str2
+ *         0 while str1 == str2
+ *******************************************************/
+int silk_string_compare_nocase(silk_string_t str1, silk_string_t str2)
+{
+    SILK_ASSERT(str1 != NULL, 0);
+    SILK_ASSERT(str2 != NULL, 0);
+
+    if (str1 == str2)
+        return 0;
+
+    size_t length1 = silk_string_length(str1);
+    size_t length2 = silk_string_length(str2);
+    size_t length = length1 < length2 ? length1 : length2;
+    if (length > 0)
+    {
+        const uint8_t* x = silk_vector_const_data(str1->data);
+        const uint8_t* y = silk_vector_const_data(str2->data);
+        size_t i = silk_string_mismatch_nocase(x, y, length);
+        if (i < length)
+            return (int)silk_string_ascii_lower(x[i]) - (int)silk_string_ascii_lower(y[i]);
+    }
+
+    return length1 < length2 ? -1 : (length1 > length2 ? 1 : 0);
+}
+
+/*******************************************************
+ * @brief find data in a range
+ * @param begin the beginning of the range
+ * @param end the end of the range
+ * @param data the data to be found, not empty
+ * @param len length of the data
+ * @return the first position, or NULL if not found
+ *******************************************************/
+static const char* silk_string_search(const char* begin, const char* end, const char* data, size_t len)
+{
+    while ((size_t)(end - begin) >= len)
+    {
+        begin = memchr(begin, data[0], (size_t)(end - begin) - len + 1);
+        if (begin == NULL)
+            return NULL;
+        if (memcmp(begin + 1, data + 1, len - 1) == 0)
+            return begin;
+        begin++;
+    }
+    return NULL;
+}
+
+/*******************************************************
+ * @brief replace the buffer of a string
+ * @param str the string
+ * @param data the new buffer which has the '\0'
+ *******************************************************/
+static void silk_string_swap(silk_string_t str, silk_vector_t data)
+{
+    SILK_STRING_MODIFIED(str);
+    silk_vector_delete(str->data);
+    str->data = data;
+}
+
+/*******************************************************
+ * @brief replace all occurrences of from with to, it is
+ *        done in one pass, with at most one allocation
+ * @note  from and to must not point into the string
+ * @param str the string
+ * @param from the c-style string to be replaced, not empty
+ * @param to the c-style string to replace with
+ * @return count of replaced occurrences, 
+ *         or SILK_INVALID_INDEX if it fails
+ *******************************************************/
+size_t silk_string_replace_all(silk_string_t str, const char* from, const char* to)
+{
+    SILK_ASSERT(str != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(from != NULL && from[0] != '\0', SILK_INVALID_INDEX);
+    SILK_ASSERT(to != NULL, SILK_INVALID_INDEX);
+
+    size_t from_length = strlen(from);
+    size_t to_length = strlen(to);
+    size_t length = silk_string_length(str);
+    char* begin = silk_vector_data(str->data);
+    const char* end = begin + length;
+
+    size_t count = 0;
+    for (const char* p = begin; (p = silk_string_search(p, end, from, from_length)) != NULL; p += from_length)
+        count++;
+
+    if (count == 0)
+        return 0;
+
+    if (to_length <= from_length)
+    {
+        // never longer, compact in place
+        char* w = begin;
+        const char* r = begin;
+        for (const char* p; (p = silk_string_search(r, end, from, from_length)) != NULL; r = p + from_length)
+        {
+            silk_overlap_copy(w, r, (size_t)(p - r));
+            w += p - r;
+            silk_copy(w, to, to_length);
+            w += to_length;
+        }
+        silk_overlap_copy(w, r, (size_t)(end - r));
+        w += end - r;
+
+        SILK_ASSERT(silk_string_resize(str, (size_t)(w - begin)), SILK_INVALID_INDEX);
+        return count;
+    }
+
+    size_t growth = to_length - from_length;
+    SILK_ASSERT(count <= (SIZE_MAX - length - 1) / growth, SILK_INVALID_INDEX);
+    size_t new_length = length + count * growth;
+
+    silk_vector_t data = silk_vector_new(sizeof(char));
+    SILK_ASSERT(data != NULL, SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_vector_resize(data, new_length + 1), silk_vector_delete(data), SILK_INVALID_INDEX);
+
+    char* w = silk_vector_data(data);
+    const char* r = begin;
+    for (const char* p; (p = silk_string_search(r, end, from, from_length)) != NULL; r = p + from_length)
+    {
+        silk_copy(w, r, (size_t)(p - r));
+        w += p - r;
+        silk_copy(w, to, to_length);
+        w += to_length;
+    }
+    silk_copy(w, r, (size_t)(end - r) + 1); // +1 to copy the '\0'
+
+    silk_string_swap(str, data);
+    return count;
+}
+
+/*******************************************************
+ * @brief apply a batch of edits in one pass, the output
+ *        size is computed first, so it allocates once
+ * @param str the string
+ * @param edits the edits, sorted by index and not
+ *              overlapped, indexes are in the original
+ *              string
+ * @param count count of edits
+ * @return whether it is successful
+ *******************************************************/
+bool silk_string_edit(silk_string_t str, const silk_string_edit_t* edits, size_t count)
+{
+    SILK_ASSERT(str != NULL, false);
+    SILK_ASSERT(edits != NULL || count == 0, false);
+
+    size_t length = silk_string_length(str);
+    size_t new_length = length;
+    size_t position = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        SILK_ASSERT(edits[i].index >= position, false);
+        SILK_ASSERT(edits[i].index <= length && edits[i].length <= length - edits[i].index, false);
+        SILK_ASSERT(edits[i].data != NULL || edits[i].size == 0, false);
+        SILK_ASSERT(edits[i].size <= SIZE_MAX - new_length - 1, false);
+
+        new_length = new_length - edits[i].length + edits[i].size;
+        position = edits[i].index + edits[i].length;
+    }
+
+    if (count == 0)
+        return true;
+
+    silk_vector_t data = silk_vector_new(sizeof(char));
+    SILK_ASSERT(data != NULL, false);
+    SILK_ASSERT(silk_vector_resize(data, new_length + 1), silk_vector_delete(data), false);
+
+    const char* r = silk_vector_const_data(str->data);
+    char* w = silk_vector_data(data);
+    position = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t kept = edits[i].index - position;
+        silk_copy(w, r + position, kept);
+        w += kept;
+        if (edits[i].size > 0)
+            silk_copy(w, edits[i].data, edits[i].size);
+        w += edits[i].size;
+        position = edits[i].index + edits[i].length;
+    }
+    silk_copy(w, r + position, length - position + 1); // +1 to copy the '\0'
+
+    silk_string_swap(str, data);
+    return true;
 }
\ No newline at end of file
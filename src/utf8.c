@@ -0,0 +1,425 @@
+#include <silk/utf8.h>
+#include <silk/cpu.h>
+#include <silk/endian.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+#if defined(SILK_CPU_X86)
+    #include <immintrin.h>
+#endif
+
+/* 
+ * The SIMD validator is the lookup algorithm of John Keiser and Daniel Lemire,
+ * see: https://arxiv.org/abs/2010.03090
+ * Every error of a 2-byte window (prev1, input) is found by looking up three
+ * nibbles, each table marks which errors the nibble could take part in.
+ */
+#define SILK_UTF8_TOO_SHORT         0x01 // 11______ 0_______ or 11______ 11______
+#define SILK_UTF8_TOO_LONG          0x02 // 0_______ 10______
+#define SILK_UTF8_OVERLONG_3        0x04 // 11100000 100_____
+#define SILK_UTF8_TOO_LARGE         0x08 // 11110100 1001____ or 11110100 101_____
+#define SILK_UTF8_SURROGATE         0x10 // 11101101 101_____
+#define SILK_UTF8_OVERLONG_2        0x20 // 1100000_ 10______
+#define SILK_UTF8_TOO_LARGE_1000    0x40 // 11110101 1000____ or 1111011_ 1000____ or 11111___ 1000____
+#define SILK_UTF8_OVERLONG_4        0x40 // 11110000 1000____
+#define SILK_UTF8_TWO_CONTS         0x80 // 10______ 10______
+#define SILK_UTF8_CARRY             (SILK_UTF8_TOO_SHORT | SILK_UTF8_TOO_LONG | SILK_UTF8_TWO_CONTS)
+
+// tables indexed by the high nibble of prev1, the low nibble of prev1 and the high nibble of input
+#define SILK_UTF8_BYTE_1_HIGH                                                                       \
+    SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG,                 \
+    SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG, SILK_UTF8_TOO_LONG,                 \
+    SILK_UTF8_TWO_CONTS, SILK_UTF8_TWO_CONTS, SILK_UTF8_TWO_CONTS, SILK_UTF8_TWO_CONTS,             \
+    SILK_UTF8_TOO_SHORT | SILK_UTF8_OVERLONG_2,                                                     \
+    SILK_UTF8_TOO_SHORT,                                                                            \
+    SILK_UTF8_TOO_SHORT | SILK_UTF8_OVERLONG_3 | SILK_UTF8_SURROGATE,                               \
+    SILK_UTF8_TOO_SHORT | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000 | SILK_UTF8_OVERLONG_4
+
+#define SILK_UTF8_BYTE_1_LOW                                                                        \
+    SILK_UTF8_CARRY | SILK_UTF8_OVERLONG_3 | SILK_UTF8_OVERLONG_2 | SILK_UTF8_OVERLONG_4,           \
+    SILK_UTF8_CARRY | SILK_UTF8_OVERLONG_2,                                                         \
+    SILK_UTF8_CARRY,                                                                                \
+    SILK_UTF8_CARRY,                                                                                \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE,                                                          \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000 | SILK_UTF8_SURROGATE,         \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000,                               \
+    SILK_UTF8_CARRY | SILK_UTF8_TOO_LARGE | SILK_UTF8_TOO_LARGE_1000
+
+#define SILK_UTF8_BYTE_2_HIGH                                                                       \
+    SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT,             \
+    SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT,             \
+    SILK_UTF8_TOO_LONG | SILK_UTF8_OVERLONG_2 | SILK_UTF8_TWO_CONTS | SILK_UTF8_OVERLONG_3 |         \
+        SILK_UTF8_TOO_LARGE_1000 | SILK_UTF8_OVERLONG_4,                                            \
+    SILK_UTF8_TOO_LONG | SILK_UTF8_OVERLONG_2 | SILK_UTF8_TWO_CONTS | SILK_UTF8_OVERLONG_3 |         \
+        SILK_UTF8_TOO_LARGE,                                                                        \
+    SILK_UTF8_TOO_LONG | SILK_UTF8_OVERLONG_2 | SILK_UTF8_TWO_CONTS | SILK_UTF8_SURROGATE |          \
+        SILK_UTF8_TOO_LARGE,                                                                        \
+    SILK_UTF8_TOO_LONG | SILK_UTF8_OVERLONG_2 | SILK_UTF8_TWO_CONTS | SILK_UTF8_SURROGATE |          \
+        SILK_UTF8_TOO_LARGE,                                                                        \
+    SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT, SILK_UTF8_TOO_SHORT
+
+// bytes greater than it at the end of a block need more bytes: 0xEF for the 3rd last, 0xDF for the 2nd last, 0xBF for the last
+#define SILK_UTF8_INCOMPLETE_LIMIT  (char)0xEF, (char)0xDF, (char)0xBF
+
+// 0x80 - 0xBF as signed char are continuation bytes
+#define SILK_UTF8_CONTINUATION_MAX  -65
+
+/*******************************************************
+ * @brief validate UTF-8 byte by byte
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is valid UTF-8
+ *******************************************************/
+static bool silk_utf8_validate_scalar(const uint8_t* data, size_t len)
+{
+    size_t i = 0;
+    while (i < len)
+    {
+        // skip 8 ascii bytes at once
+        if (len - i >= 8 && (silk_endian_read_little64(data + i) & 0x8080808080808080u) == 0)
+        {
+            i += 8;
+            continue;
+        }
+
+        uint8_t c = data[i];
+        if (c < 0x80)
+        {
+            i++;
+            continue;
+        }
+
+        // range of the 2nd byte is narrower for some lead bytes
+        size_t n = 0;
+        uint8_t low = 0x80;
+        uint8_t high = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF)
+        {
+            n = 1;
+        }
+        else if (c >= 0xE0 && c <= 0xEF)
+        {
+            n = 2;
+            low = c == 0xE0 ? 0xA0 : low;
+            high = c == 0xED ? 0x9F : high;
+        }
+        else if (c >= 0xF0 && c <= 0xF4)
+        {
+            n = 3;
+            low = c == 0xF0 ? 0x90 : low;
+            high = c == 0xF4 ? 0x8F : high;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (len - i - 1 < n || data[i + 1] < low || data[i + 1] > high)
+            return false;
+
+        for (size_t k = 2; k <= n; k++)
+        {
+            if ((data[i + k] & 0xC0) != 0x80)
+                return false;
+        }
+        i += n + 1;
+    }
+    return true;
+}
+
+/*******************************************************
+ * @brief count code points byte by byte
+ * @param data the data
+ * @param len length of the data
+ * @return the count of code points
+ *******************************************************/
+static size_t silk_utf8_length_scalar(const uint8_t* data, size_t len)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        count += (data[i] & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+#if defined(SILK_CPU_X86)
+/*******************************************************
+ * @brief find errors of 16 bytes by SSSE3
+ * @param input the current 16 bytes
+ * @param prev_input the previous 16 bytes
+ * @return the errors, 0 means no error
+ *******************************************************/
+SILK_TARGET("ssse3")
+static __m128i silk_utf8_check_ssse3(__m128i input, __m128i prev_input)
+{
+    const __m128i byte_1_high = _mm_setr_epi8(SILK_UTF8_BYTE_1_HIGH);
+    const __m128i byte_1_low = _mm_setr_epi8(SILK_UTF8_BYTE_1_LOW);
+    const __m128i byte_2_high = _mm_setr_epi8(SILK_UTF8_BYTE_2_HIGH);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    // special cases of 2-byte windows
+    __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+    __m128i sc = _mm_and_si128(_mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                               _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble)));
+    sc = _mm_and_si128(sc, _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+    // 3rd and 4th bytes must be continuations, they are marked as TWO_CONTS above
+    __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+    __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+    __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+    return _mm_xor_si128(must23, sc);
+}
+
+/*******************************************************
+ * @brief validate UTF-8 by SSSE3
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is valid UTF-8
+ *******************************************************/
+SILK_TARGET("ssse3")
+static bool silk_utf8_validate_ssse3(const uint8_t* data, size_t len)
+{
+    const __m128i limit = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 
+                                        -1, -1, -1, -1, -1, SILK_UTF8_INCOMPLETE_LIMIT);
+    __m128i error = _mm_setzero_si128();
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+
+    for (size_t i = 0; i < len; i += 16)
+    {
+        __m128i input;
+        if (len - i >= 16)
+        {
+            input = _mm_loadu_si128((const __m128i*)(data + i));
+        }
+        else
+        {
+            // pad the tail with ascii
+            uint8_t buffer[16];
+            memset(buffer, ' ', sizeof(buffer));
+            memcpy(buffer, data + i, len - i);
+            input = _mm_loadu_si128((const __m128i*)buffer);
+        }
+
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            error = _mm_or_si128(error, prev_incomplete);
+        }
+        else
+        {
+            error = _mm_or_si128(error, silk_utf8_check_ssse3(input, prev_input));
+            prev_incomplete = _mm_subs_epu8(input, limit);
+        }
+        prev_input = input;
+    }
+
+    error = _mm_or_si128(error, prev_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+/*******************************************************
+ * @brief find errors of 32 bytes by AVX2
+ * @param input the current 32 bytes
+ * @param prev_input the previous 32 bytes
+ * @return the errors, 0 means no error
+ *******************************************************/
+SILK_TARGET("avx2")
+static __m256i silk_utf8_check_avx2(__m256i input, __m256i prev_input)
+{
+    const __m256i byte_1_high = _mm256_setr_epi8(SILK_UTF8_BYTE_1_HIGH, SILK_UTF8_BYTE_1_HIGH);
+    const __m256i byte_1_low = _mm256_setr_epi8(SILK_UTF8_BYTE_1_LOW, SILK_UTF8_BYTE_1_LOW);
+    const __m256i byte_2_high = _mm256_setr_epi8(SILK_UTF8_BYTE_2_HIGH, SILK_UTF8_BYTE_2_HIGH);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    // alignr works in 128-bit lanes, so shift in the high lane of prev_input
+    __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+
+    // special cases of 2-byte windows
+    __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+    __m256i sc = _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                                  _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble)));
+    sc = _mm256_and_si256(sc, _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+    // 3rd and 4th bytes must be continuations, they are marked as TWO_CONTS above
+    __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must23, sc);
+}
+
+/*******************************************************
+ * @brief validate UTF-8 by AVX2
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is valid UTF-8
+ *******************************************************/
+SILK_TARGET("avx2")
+static bool silk_utf8_validate_avx2(const uint8_t* data, size_t len)
+{
+    const __m256i limit = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 
+                                           -1, -1, -1, -1, -1, -1, -1, -1, 
+                                           -1, -1, -1, -1, -1, -1, -1, -1, 
+                                           -1, -1, -1, -1, -1, SILK_UTF8_INCOMPLETE_LIMIT);
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        __m256i input;
+        if (len - i >= 32)
+        {
+            input = _mm256_loadu_si256((const __m256i*)(data + i));
+        }
+        else
+        {
+            // pad the tail with ascii
+            uint8_t buffer[32];
+            memset(buffer, ' ', sizeof(buffer));
+            memcpy(buffer, data + i, len - i);
+            input = _mm256_loadu_si256((const __m256i*)buffer);
+        }
+
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            error = _mm256_or_si256(error, prev_incomplete);
+        }
+        else
+        {
+            error = _mm256_or_si256(error, silk_utf8_check_avx2(input, prev_input));
+            prev_incomplete = _mm256_subs_epu8(input, limit);
+        }
+        prev_input = input;
+    }
+
+    error = _mm256_or_si256(error, prev_incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+/*******************************************************
+ * @brief count code points by SSE2
+ * @param data the data
+ * @param len length of the data
+ * @return the count of code points
+ *******************************************************/
+SILK_TARGET("sse2")
+static size_t silk_utf8_length_sse2(const uint8_t* data, size_t len)
+{
+    const __m128i continuation = _mm_set1_epi8(SILK_UTF8_CONTINUATION_MAX);
+    size_t count = 0;
+    size_t i = 0;
+    while (len - i >= 16)
+    {
+        // 8-bit counters of each lane could hold 255 blocks
+        size_t blocks = (len - i) / 16;
+        blocks = blocks > 255 ? 255 : blocks;
+
+        __m128i counter = _mm_setzero_si128();
+        for (size_t k = 0; k < blocks; k++, i += 16)
+        {
+            __m128i input = _mm_loadu_si128((const __m128i*)(data + i));
+            counter = _mm_sub_epi8(counter, _mm_cmpgt_epi8(input, continuation));
+        }
+
+        __m128i sum = _mm_sad_epu8(counter, _mm_setzero_si128());
+        count += (size_t)_mm_cvtsi128_si32(sum) + (size_t)_mm_extract_epi16(sum, 4);
+    }
+    return count + silk_utf8_length_scalar(data + i, len - i);
+}
+
+/*******************************************************
+ * @brief count code points by AVX2
+ * @param data the data
+ * @param len length of the data
+ * @return the count of code points
+ *******************************************************/
+SILK_TARGET("avx2")
+static size_t silk_utf8_length_avx2(const uint8_t* data, size_t len)
+{
+    const __m256i continuation = _mm256_set1_epi8(SILK_UTF8_CONTINUATION_MAX);
+    size_t count = 0;
+    size_t i = 0;
+    while (len - i >= 32)
+    {
+        // 8-bit counters of each lane could hold 255 blocks
+        size_t blocks = (len - i) / 32;
+        blocks = blocks > 255 ? 255 : blocks;
+
+        __m256i counter = _mm256_setzero_si256();
+        for (size_t k = 0; k < blocks; k++, i += 32)
+        {
+            __m256i input = _mm256_loadu_si256((const __m256i*)(data + i));
+            counter = _mm256_sub_epi8(counter, _mm256_cmpgt_epi8(input, continuation));
+        }
+
+        __m256i sum = _mm256_sad_epu8(counter, _mm256_setzero_si256());
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        count += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_extract_epi16(half, 4);
+    }
+    return count + silk_utf8_length_scalar(data + i, len - i);
+}
+#endif
+
+/*******************************************************
+ * @brief determine whether data is valid UTF-8
+ * @note  overlong forms, surrogates and code points
+ *        above U+10FFFF are rejected, it uses SSSE3 or
+ *        AVX2 if the cpu supports
+ * @param data the data
+ * @param len length of the data
+ * @return whether it is valid UTF-8
+ *******************************************************/
+bool silk_utf8_validate(const void* data, size_t len)
+{
+    SILK_ASSERT(data != NULL || len == 0, false);
+
+    if (len == 0)
+        return true;
+
+#if defined(SILK_CPU_X86)
+    if (len >= 32 && silk_cpu_supports(SILK_CPU_AVX2))
+        return silk_utf8_validate_avx2(data, len);
+
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSSE3))
+        return silk_utf8_validate_ssse3(data, len);
+#endif
+
+    return silk_utf8_validate_scalar(data, len);
+}
+
+/*******************************************************
+ * @brief count code points of UTF-8 data
+ * @note  it counts bytes which are not continuation
+ *        bytes, the data should be validated first
+ * @param data the data
+ * @param len length of the data
+ * @return the count of code points
+ *******************************************************/
+size_t silk_utf8_length(const void* data, size_t len)
+{
+    SILK_ASSERT(data != NULL || len == 0, 0);
+
+#if defined(SILK_CPU_X86)
+    if (len >= 32 && silk_cpu_supports(SILK_CPU_AVX2))
+        return silk_utf8_length_avx2(data, len);
+
+    if (len >= 16 && silk_cpu_supports(SILK_CPU_SSE2))
+        return silk_utf8_length_sse2(data, len);
+#endif
+
+    return silk_utf8_length_scalar(data, len);
+}
\ No newline at end of file
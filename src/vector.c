@@ -56,7 +56,7 @@ static bool silk_vector_enough(silk_vector_t vector, size_t count)
 {
     SILK_ASSERT(vector != NULL, false);
 
-    while (vector->capacity <= vector->length + count)
+    while (vector->capacity < vector->length + count)
     {
         SILK_ASSERT(silk_vector_expand(vector), false);
     }
@@ -259,6 +259,21 @@ bool silk_vector_reserve(silk_vector_t vector, size_t capacity)
     return true;
 }
 
+/*******************************************************
+ * @brief resize a vector, new elements are uninitialized
+ * @param vector the vector
+ * @param length the new length
+ * @return whether it is successful
+ *******************************************************/
+bool silk_vector_resize(silk_vector_t vector, size_t length)
+{
+    SILK_ASSERT(vector != NULL, false);
+    SILK_ASSERT(silk_vector_reserve(vector, length), false);
+
+    vector->length = length;
+    return true;
+}
+
 /*******************************************************
  * @brief insert elements into a vector
  * @param vector the vector
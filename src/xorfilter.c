@@ -0,0 +1,432 @@
+#include <silk/xorfilter.h>
+#include <silk/hash.h>
+#include <silk/log.h>
+#include <silk/utils.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// 3-wise binary fuse filter
+#define SILK_XORFILTER_ARITY            3
+
+// max segment length
+#define SILK_XORFILTER_MAX_SEGMENT      262144
+
+// construction fails with a tiny probability each time, retry with another seed
+#define SILK_XORFILTER_MAX_ITERATIONS   100
+
+struct SilkXorfilter
+{
+    uint64_t seed;                  // seed to mix the key hashes
+    uint32_t segment_length;        // power of 2
+    uint32_t segment_length_mask;
+    uint32_t segment_count;         // count of segments the first position could be in
+    uint32_t segment_count_length;  // segment_count * segment_length
+    uint32_t array_length;          // count of fingerprints
+    uint8_t* fingerprints;
+};
+
+/*******************************************************
+ * @brief calculate log2 of a positive integer, without
+ *        linking the math library
+ * @param x the value
+ * @return log2(x), about 20 bits of precision
+ *******************************************************/
+static double silk_xorfilter_log2(uint32_t x)
+{
+    // the integer part is the highest bit, the fraction is got bit by bit by squaring
+    int n = 63 - silk_clz64(x);
+    double y = (double)x / (double)(1ull << n);
+    double result = n;
+    double bit = 0.5;
+    for (int i = 0; i < 20; i++, bit /= 2)
+    {
+        y *= y;
+        if (y >= 2)
+        {
+            y /= 2;
+            result += bit;
+        }
+    }
+    return result;
+}
+
+/*******************************************************
+ * @brief the finalizer of MurmurHash3 x64, mixes a key
+ *        hash with the filter seed
+ * @param h the value
+ * @return the mixed value
+ *******************************************************/
+static inline uint64_t silk_xorfilter_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/*******************************************************
+ * @brief the next seed of splitmix64
+ * @param state the state of the generator
+ * @return the seed
+ *******************************************************/
+static inline uint64_t silk_xorfilter_next_seed(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/*******************************************************
+ * @brief get the fingerprint of a mixed hash
+ * @param hash the mixed hash
+ * @return the fingerprint
+ *******************************************************/
+static inline uint8_t silk_xorfilter_fingerprint(uint64_t hash)
+{
+    return (uint8_t)(hash ^ (hash >> 32));
+}
+
+/*******************************************************
+ * @brief get the 3 positions of a mixed hash, they are
+ *        in 3 consecutive segments
+ * @param filter the filter
+ * @param hash the mixed hash
+ * @param positions return the positions, the first 2 are
+ *                  repeated at the end, so positions
+ *                  [i + 1] and [i + 2] are the others of i
+ *******************************************************/
+static inline void silk_xorfilter_positions(silk_xorfilter_t filter, uint64_t hash, uint32_t positions[5])
+{
+    uint64_t high;
+    silk_mul128(hash, filter->segment_count_length, &high);
+    positions[0] = (uint32_t)high;
+    positions[1] = positions[0] + filter->segment_length;
+    positions[2] = positions[1] + filter->segment_length;
+    positions[1] ^= (uint32_t)(hash >> 18) & filter->segment_length_mask;
+    positions[2] ^= (uint32_t)hash & filter->segment_length_mask;
+    positions[3] = positions[0];
+    positions[4] = positions[1];
+}
+
+/*******************************************************
+ * @brief compare two uint64_t values for qsort
+ * @param x a value
+ * @param y a value
+ * @return the order
+ *******************************************************/
+static int silk_xorfilter_compare(const void* x, const void* y)
+{
+    uint64_t a = *(const uint64_t*)x;
+    uint64_t b = *(const uint64_t*)y;
+    return (a > b) - (a < b);
+}
+
+/*******************************************************
+ * @brief decide the layout of a filter
+ * @param filter the filter
+ * @param size count of keys
+ *******************************************************/
+static void silk_xorfilter_layout(silk_xorfilter_t filter, uint32_t size)
+{
+    const uint32_t arity = SILK_XORFILTER_ARITY;
+
+    // the parameters of the paper, segment length 2^floor(log3.33(size) + 2.25)
+    uint32_t segment_length = 4;
+    if (size > 1)
+    {
+        uint32_t bits = (uint32_t)(silk_xorfilter_log2(size) / 1.7355221772965 + 2.25);
+        segment_length = bits >= 18 ? SILK_XORFILTER_MAX_SEGMENT : (1u << bits);
+    }
+
+    // size factor max(1.125, 0.875 + 0.25 * log(1000000) / log(size))
+    uint32_t capacity = 0;
+    if (size > 1)
+    {
+        double factor = 0.875 + 0.25 * 19.931568569324174 / silk_xorfilter_log2(size);
+        if (factor < 1.125)
+            factor = 1.125;
+        capacity = (uint32_t)((double)size * factor + 0.5);
+    }
+
+    uint32_t segment_count = (capacity + segment_length - 1) / segment_length;
+    segment_count = segment_count <= arity - 1 ? 1 : segment_count - (arity - 1);
+
+    filter->segment_length = segment_length;
+    filter->segment_length_mask = segment_length - 1;
+    filter->segment_count = segment_count;
+    filter->segment_count_length = segment_count * segment_length;
+    filter->array_length = (segment_count + arity - 1) * segment_length;
+}
+
+/*******************************************************
+ * @brief assign the fingerprints of the filter by
+ *        peeling the 3-hypergraph of the keys
+ * @param filter the filter
+ * @param keys the key hashes, could be reordered
+ * @param size count of keys
+ * @return whether it is successful
+ *******************************************************/
+static bool silk_xorfilter_populate(silk_xorfilter_t filter, uint64_t* keys, uint32_t size)
+{
+    uint32_t capacity = filter->array_length;
+    uint64_t* order = silk_alloc(sizeof(uint64_t) * ((size_t)size + 1));
+    uint8_t* order_index = silk_alloc(size > 0 ? size : 1);
+    uint32_t* alone = silk_alloc(sizeof(uint32_t) * capacity);
+    uint8_t* t2count = silk_alloc(capacity);
+    uint64_t* t2hash = silk_alloc(sizeof(uint64_t) * capacity);
+
+    uint32_t block_bits = 1;
+    while ((1u << block_bits) < filter->segment_count)
+        block_bits++;
+    uint32_t block = 1u << block_bits;
+    uint32_t* start = silk_alloc(sizeof(uint32_t) * block);
+
+    bool result = order != NULL && order_index != NULL && alone != NULL && t2count != NULL && t2hash != NULL && start != NULL;
+    if (!result)
+    {
+        silk_free(order);
+        silk_free(order_index);
+        silk_free(alone);
+        silk_free(t2count);
+        silk_free(t2hash);
+        silk_free(start);
+        return false;
+    }
+
+    uint64_t rng = 0x726b2b9d438b9d4dull;
+    uint32_t positions[5];
+    result = false;
+    for (int loop = 0; loop < SILK_XORFILTER_MAX_ITERATIONS; loop++)
+    {
+        filter->seed = silk_xorfilter_next_seed(&rng);
+        memset(order, 0, sizeof(uint64_t) * ((size_t)size + 1));
+        memset(t2count, 0, capacity);
+        memset(t2hash, 0, sizeof(uint64_t) * capacity);
+        order[size] = 1;
+
+        // sort keys roughly by the first segment, so the following passes are cache friendly
+        for (uint32_t i = 0; i < block; i++)
+            start[i] = (uint32_t)(((uint64_t)i * size) >> block_bits);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            uint64_t hash = silk_xorfilter_mix(keys[i] + filter->seed);
+            uint64_t index = hash >> (64 - block_bits);
+            while (order[start[index]] != 0)
+                index = (index + 1) & (block - 1);
+            order[start[index]] = hash;
+            start[index]++;
+        }
+
+        // count keys of each position, t2hash is the xor of their hashes,
+        // t2count is count << 2 and the xor of which of the 3 positions it is
+        bool error = false;
+        uint32_t duplicates = 0;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            uint64_t hash = order[i];
+            silk_xorfilter_positions(filter, hash, positions);
+            for (uint32_t j = 0; j < SILK_XORFILTER_ARITY; j++)
+            {
+                t2count[positions[j]] += 4;
+                t2count[positions[j]] ^= (uint8_t)j;
+                t2hash[positions[j]] ^= hash;
+            }
+
+            // the same hash twice cancels itself out, remove the second one
+            if ((t2hash[positions[0]] & t2hash[positions[1]] & t2hash[positions[2]]) == 0)
+            {
+                if ((t2hash[positions[0]] == 0 && t2count[positions[0]] == 8) ||
+                    (t2hash[positions[1]] == 0 && t2count[positions[1]] == 8) ||
+                    (t2hash[positions[2]] == 0 && t2count[positions[2]] == 8))
+                {
+                    duplicates++;
+                    for (uint32_t j = 0; j < SILK_XORFILTER_ARITY; j++)
+                    {
+                        t2count[positions[j]] -= 4;
+                        t2count[positions[j]] ^= (uint8_t)j;
+                        t2hash[positions[j]] ^= hash;
+                    }
+                }
+            }
+
+            // the count overflows
+            for (uint32_t j = 0; j < SILK_XORFILTER_ARITY; j++)
+                error = error || t2count[positions[j]] < 4;
+        }
+
+        if (error)
+            continue;
+
+        // peel positions with only one key
+        uint32_t queue = 0;
+        for (uint32_t i = 0; i < capacity; i++)
+        {
+            alone[queue] = i;
+            queue += (t2count[i] >> 2) == 1 ? 1 : 0;
+        }
+
+        uint32_t stack = 0;
+        while (queue > 0)
+        {
+            queue--;
+            uint32_t index = alone[queue];
+            if ((t2count[index] >> 2) != 1)
+                continue;
+
+            uint64_t hash = t2hash[index];
+            uint8_t found = t2count[index] & 3;
+            silk_xorfilter_positions(filter, hash, positions);
+            order_index[stack] = found;
+            order[stack] = hash;
+            stack++;
+
+            for (uint32_t j = 1; j < SILK_XORFILTER_ARITY; j++)
+            {
+                uint32_t other = positions[found + j];
+                alone[queue] = other;
+                queue += (t2count[other] >> 2) == 2 ? 1 : 0;
+                t2count[other] -= 4;
+                t2count[other] ^= (uint8_t)((found + j) % SILK_XORFILTER_ARITY);
+                t2hash[other] ^= hash;
+            }
+        }
+
+        if (stack + duplicates == size)
+        {
+            // assign in reverse peeling order, each key owns the position it was peeled from
+            for (uint32_t i = stack; i-- > 0;)
+            {
+                uint64_t hash = order[i];
+                uint8_t found = order_index[i];
+                silk_xorfilter_positions(filter, hash, positions);
+                filter->fingerprints[positions[found]] = silk_xorfilter_fingerprint(hash) ^
+                                                         filter->fingerprints[positions[found + 1]] ^
+                                                         filter->fingerprints[positions[found + 2]];
+            }
+            result = true;
+            break;
+        }
+
+        // duplicates which were not detected, remove them all
+        if (duplicates > 0)
+        {
+            qsort(keys, size, sizeof(uint64_t), silk_xorfilter_compare);
+            uint32_t unique = 0;
+            for (uint32_t i = 0; i < size; i++)
+            {
+                if (unique == 0 || keys[i] != keys[unique - 1])
+                    keys[unique++] = keys[i];
+            }
+            size = unique;
+        }
+    }
+
+    silk_free(start);
+    silk_free(t2hash);
+    silk_free(t2count);
+    silk_free(alone);
+    silk_free(order_index);
+    silk_free(order);
+    return result;
+}
+
+/*******************************************************
+ * @brief create a binary fuse filter of a static key set
+ * @note  it is an xor filter with 8-bit fingerprints in
+ *        spatially coupled segments, it takes about 9 bits
+ *        per key, the false positive rate is 1/256, and a
+ *        query reads 3 bytes, keys can not be added later
+ *        see: https://arxiv.org/abs/2201.01174
+ * @param keys the keys, bytes of each element is a key,
+ *             duplicated keys are allowed
+ * @return the filter, or NULL if it fails, building could
+ *         fail after all seeds are tried, it is not an
+ *         assertion failure
+ *******************************************************/
+silk_xorfilter_t silk_xorfilter_new(silk_vector_t keys)
+{
+    SILK_ASSERT(keys != NULL, NULL);
+
+    size_t length = silk_vector_length(keys);
+    size_t element_size = silk_vector_element_size(keys);
+    SILK_ASSERT(length < UINT32_MAX / 2, NULL);
+
+    uint32_t size = (uint32_t)length;
+    uint64_t* hashes = silk_alloc(sizeof(uint64_t) * (size > 0 ? size : 1));
+    SILK_ASSERT(hashes != NULL, NULL);
+
+    const uint8_t* data = silk_vector_const_data(keys);
+    for (uint32_t i = 0; i < size; i++)
+        hashes[i] = silk_hash_wyhash(data + (size_t)i * element_size, element_size, 0);
+
+    silk_xorfilter_t filter = silk_alloc(sizeof(struct SilkXorfilter));
+    SILK_ASSERT(filter != NULL, silk_free(hashes), NULL);
+
+    silk_xorfilter_layout(filter, size);
+    filter->fingerprints = silk_alloc(filter->array_length);
+    SILK_ASSERT(filter->fingerprints != NULL, silk_free(filter), silk_free(hashes), NULL);
+    memset(filter->fingerprints, 0, filter->array_length);
+
+    // it could still fail after all seeds are tried, such as for adversarial keys
+    bool result = silk_xorfilter_populate(filter, hashes, size);
+    silk_free(hashes);
+    if (!result)
+    {
+        silk_free(filter->fingerprints);
+        silk_free(filter);
+        return NULL;
+    }
+
+    return filter;
+}
+
+/*******************************************************
+ * @brief delete a binary fuse filter
+ * @param filter the filter to be deleted
+ *******************************************************/
+void silk_xorfilter_delete(silk_xorfilter_t filter)
+{
+    SILK_ASSERT(filter != NULL);
+
+    silk_free(filter->fingerprints);
+    silk_free(filter);
+}
+
+/*******************************************************
+ * @brief determine whether a key may be in a filter
+ * @param filter the filter
+ * @param data the key
+ * @param len length of the key, it should be the element
+ *            size of the vector to create the filter
+ * @return false if the key is surely not in the key set,
+ *         true if it is probably in the key set
+ *******************************************************/
+bool silk_xorfilter_contains(silk_xorfilter_t filter, const void* data, size_t len)
+{
+    SILK_ASSERT(filter != NULL, false);
+
+    uint32_t positions[5];
+    uint64_t hash = silk_xorfilter_mix(silk_hash_wyhash(data, len, 0) + filter->seed);
+    silk_xorfilter_positions(filter, hash, positions);
+
+    uint8_t f = silk_xorfilter_fingerprint(hash);
+    f ^= filter->fingerprints[positions[0]] ^ filter->fingerprints[positions[1]] ^ filter->fingerprints[positions[2]];
+    return f == 0;
+}
+
+/*******************************************************
+ * @brief get the memory of fingerprints of a filter
+ * @param filter the filter
+ * @return the size in bytes
+ *******************************************************/
+size_t silk_xorfilter_size(silk_xorfilter_t filter)
+{
+    SILK_ASSERT(filter != NULL, 0);
+
+    return filter->array_length;
+}
\ No newline at end of file
@@ -6,6 +6,25 @@ void test_list();
 void test_string();
 void test_endian();
 void test_hash();
+void test_intern();
+void test_rope();
+void test_cpu();
+void test_utf8();
+void test_number();
+void test_codec();
+void test_strbuilder();
+void test_matcher();
+void test_crc();
+void test_bloom();
+void test_xorfilter();
+void test_hll();
+void test_cms();
+void test_hashring();
+void test_mph();
+void test_set();
+void test_map();
+void test_cmap();
+void test_lru();
 
 int main()
 {
@@ -17,5 +36,24 @@ int main()
     test_string();
     test_endian();
     test_hash();
+    test_intern();
+    test_rope();
+    test_cpu();
+    test_utf8();
+    test_number();
+    test_codec();
+    test_strbuilder();
+    test_matcher();
+    test_crc();
+    test_bloom();
+    test_xorfilter();
+    test_hll();
+    test_cms();
+    test_hashring();
+    test_mph();
+    test_set();
+    test_map();
+    test_cmap();
+    test_lru();
     return 0;
 }
@@ -0,0 +1,131 @@
+#include <silk/log.h>
+#include <silk/bloom.h>
+#include <silk/cpu.h>
+
+#include <string.h>
+
+void test_bloom_add()
+{
+    silk_bloom_t bloom = silk_bloom_new(1000, 10);
+    SILK_ASSERT(bloom != NULL);
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        SILK_ASSERT(silk_bloom_add(bloom, &i, sizeof(i)));
+    }
+
+    uint32_t features[] = {0, SILK_CPU_SSE2, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+
+        // no false negatives
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            SILK_ASSERT(silk_bloom_contains(bloom, &i, sizeof(i)));
+        }
+
+        // about 1% false positives
+        size_t positives = 0;
+        for (uint32_t i = 1000; i < 101000; i++)
+            positives += silk_bloom_contains(bloom, &i, sizeof(i));
+        SILK_ASSERT(positives < 2000);
+
+        silk_cpu_set_features(old);
+    }
+
+    SILK_ASSERT(silk_bloom_clear(bloom));
+    uint32_t key = 1;
+    SILK_ASSERT(!silk_bloom_contains(bloom, &key, sizeof(key)));
+    SILK_ASSERT(!silk_bloom_contains(bloom, "", 0));
+    SILK_ASSERT(silk_bloom_add(bloom, "", 0));
+    SILK_ASSERT(silk_bloom_contains(bloom, "", 0));
+
+    silk_bloom_delete(bloom);
+}
+
+void test_bloom_bulk()
+{
+    uint64_t keys[1000];
+    bool results[1000];
+    for (size_t i = 0; i < 1000; i++)
+        keys[i] = i * 0x9e3779b97f4a7c15ull;
+
+    silk_bloom_t bloom = silk_bloom_new(500, 12);
+    SILK_ASSERT(bloom != NULL);
+    SILK_ASSERT(silk_bloom_add_bulk(bloom, keys, sizeof(uint64_t), 500));
+
+    size_t found = silk_bloom_contains_bulk(bloom, keys, sizeof(uint64_t), 1000, results);
+    SILK_ASSERT(found >= 500 && found < 520);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        SILK_ASSERT(results[i] == silk_bloom_contains(bloom, &keys[i], sizeof(uint64_t)));
+        if (i < 500)
+        {
+            SILK_ASSERT(results[i]);
+        }
+    }
+
+    SILK_ASSERT(silk_bloom_contains_bulk(bloom, keys, sizeof(uint64_t), 500, NULL) == 500);
+    silk_bloom_delete(bloom);
+}
+
+void test_bloom_serialize()
+{
+    silk_bloom_t bloom = silk_bloom_new(100, 10);
+    SILK_ASSERT(bloom != NULL);
+
+    for (uint32_t i = 0; i < 100; i++)
+        silk_bloom_add(bloom, &i, sizeof(i));
+
+    size_t size = silk_bloom_serialized_size(bloom);
+    SILK_ASSERT(size == 64 + 64 * (1000 / 512 + 1));
+
+    uint64_t buffer[64];
+    SILK_ASSERT(size <= sizeof(buffer));
+    SILK_ASSERT(!silk_bloom_serialize(bloom, buffer, size - 1));
+    SILK_ASSERT(silk_bloom_serialize(bloom, buffer, sizeof(buffer)));
+    SILK_ASSERT(memcmp(buffer, "SKBLOOM1", 8) == 0);
+
+    // invalid data
+    SILK_ASSERT(silk_bloom_deserialize(buffer, size - 1) == NULL);
+    SILK_ASSERT(silk_bloom_view(buffer, 63) == NULL);
+
+    silk_bloom_t copy = silk_bloom_deserialize(buffer, size);
+    silk_bloom_t view = silk_bloom_view(buffer, size);
+    SILK_ASSERT(copy != NULL && view != NULL);
+
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        bool expect = silk_bloom_contains(bloom, &i, sizeof(i));
+        SILK_ASSERT(silk_bloom_contains(copy, &i, sizeof(i)) == expect);
+        SILK_ASSERT(silk_bloom_contains(view, &i, sizeof(i)) == expect);
+    }
+
+    // a view is read-only, a copy is not
+    uint32_t key = 12345;
+    SILK_ASSERT(!silk_bloom_add(view, &key, sizeof(key)));
+    SILK_ASSERT(!silk_bloom_clear(view));
+    SILK_ASSERT(silk_bloom_add(copy, &key, sizeof(key)));
+    SILK_ASSERT(silk_bloom_contains(copy, &key, sizeof(key)));
+
+    // a view of unaligned data is copied
+    uint8_t* unaligned = (uint8_t*)buffer + 1;
+    memmove(unaligned, buffer, size);
+    silk_bloom_t view2 = silk_bloom_view(unaligned, size);
+    SILK_ASSERT(view2 != NULL);
+    SILK_ASSERT(silk_bloom_contains(view2, &key, sizeof(key)) == silk_bloom_contains(bloom, &key, sizeof(key)));
+    SILK_ASSERT(!silk_bloom_add(view2, &key, sizeof(key)));
+
+    silk_bloom_delete(view2);
+    silk_bloom_delete(view);
+    silk_bloom_delete(copy);
+    silk_bloom_delete(bloom);
+}
+
+void test_bloom()
+{
+    test_bloom_add();
+    test_bloom_bulk();
+    test_bloom_serialize();
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <silk/log.h>
+#include <silk/cmap.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+#define TEST_CMAP_THREADS   8
+#define TEST_CMAP_KEYS      20000
+
+struct TestCmapTask
+{
+    silk_cmap_t cmap;
+    uint64_t id;
+    uint64_t computed;      // count of calls of compute
+};
+
+/*******************************************************
+ * @brief compute the value of a key
+ * @param key the key
+ * @param value return the value
+ * @param data the task
+ * @return whether to insert the value
+ *******************************************************/
+static bool test_cmap_compute(const void* key, void* value, void* data)
+{
+    struct TestCmapTask* task = data;
+    task->computed++;
+    *(uint64_t*)value = *(const uint64_t*)key * 2;
+    return *(const uint64_t*)key % 100 != 99;
+}
+
+/*******************************************************
+ * @brief work of each thread, keys of its own are put
+ *        and erased, shared keys are computed
+ * @param task the task
+ *******************************************************/
+static void test_cmap_work(struct TestCmapTask* task)
+{
+    uint64_t base = (task->id + 1) * 1000000;
+    for (uint64_t i = 0; i < TEST_CMAP_KEYS; i++)
+    {
+        uint64_t key = base + i;
+        uint64_t value = i;
+        SILK_ASSERT(silk_cmap_put(task->cmap, &key, &value));
+
+        key = i;
+        bool found = silk_cmap_compute_if_absent(task->cmap, &key, test_cmap_compute, task, &value);
+        SILK_ASSERT(found == (i % 100 != 99));
+        if (found)
+            SILK_ASSERT(value == i * 2);
+    }
+
+    for (uint64_t i = 0; i < TEST_CMAP_KEYS; i++)
+    {
+        uint64_t key = base + i;
+        uint64_t value;
+        SILK_ASSERT(silk_cmap_get(task->cmap, &key, &value) && value == i);
+        if (i % 2 == 0)
+            SILK_ASSERT(silk_cmap_erase(task->cmap, &key));
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI test_cmap_thread(LPVOID data)
+{
+    test_cmap_work(data);
+    return 0;
+}
+#else
+static void* test_cmap_thread(void* data)
+{
+    test_cmap_work(data);
+    return NULL;
+}
+#endif
+
+void test_cmap_threads()
+{
+    silk_cmap_t cmap = silk_cmap_new(sizeof(uint64_t), sizeof(uint64_t), 0);
+    SILK_ASSERT(cmap != NULL);
+
+    struct TestCmapTask tasks[TEST_CMAP_THREADS];
+#if defined(_WIN32)
+    HANDLE threads[TEST_CMAP_THREADS];
+#else
+    pthread_t threads[TEST_CMAP_THREADS];
+#endif
+    for (size_t i = 0; i < TEST_CMAP_THREADS; i++)
+    {
+        tasks[i].cmap = cmap;
+        tasks[i].id = i;
+        tasks[i].computed = 0;
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, test_cmap_thread, &tasks[i], 0, NULL);
+        SILK_ASSERT(threads[i] != NULL);
+#else
+        SILK_ASSERT(pthread_create(&threads[i], NULL, test_cmap_thread, &tasks[i]) == 0);
+#endif
+    }
+
+    uint64_t computed = 0;
+    for (size_t i = 0; i < TEST_CMAP_THREADS; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+        computed += tasks[i].computed;
+    }
+
+    // each shared key is computed once, unless compute declined it
+    uint64_t declined = TEST_CMAP_KEYS / 100;
+    SILK_ASSERT(computed == TEST_CMAP_KEYS - declined + declined * TEST_CMAP_THREADS);
+    SILK_ASSERT(silk_cmap_length(cmap) == TEST_CMAP_KEYS - declined + TEST_CMAP_THREADS * TEST_CMAP_KEYS / 2);
+
+    silk_cmap_clear(cmap);
+    SILK_ASSERT(silk_cmap_length(cmap) == 0);
+    silk_cmap_delete(cmap);
+}
+
+void test_cmap_single()
+{
+    silk_cmap_t cmap = silk_cmap_new(sizeof(uint32_t), 0, 3);
+    SILK_ASSERT(cmap != NULL);
+
+    for (uint32_t i = 0; i < 100; i++)
+        SILK_ASSERT(silk_cmap_put(cmap, &i, NULL));
+    SILK_ASSERT(silk_cmap_length(cmap) == 100);
+    SILK_ASSERT(silk_cmap_get(cmap, &(uint32_t){50}, NULL));
+    SILK_ASSERT(!silk_cmap_get(cmap, &(uint32_t){100}, NULL));
+    SILK_ASSERT(silk_cmap_erase(cmap, &(uint32_t){50}));
+    SILK_ASSERT(!silk_cmap_erase(cmap, &(uint32_t){50}));
+    SILK_ASSERT(silk_cmap_length(cmap) == 99);
+
+    silk_cmap_delete(cmap);
+}
+
+void test_cmap()
+{
+    test_cmap_single();
+    test_cmap_threads();
+}
\ No newline at end of file
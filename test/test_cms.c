@@ -0,0 +1,117 @@
+#include <silk/log.h>
+#include <silk/cms.h>
+#include <silk/cpu.h>
+
+#include <string.h>
+
+void test_cms_estimate()
+{
+    uint32_t features[] = {0, SILK_CPU_SSE41, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+
+        silk_cms_t cms = silk_cms_new(1000, 5, 0);
+        SILK_ASSERT(cms != NULL);
+        SILK_ASSERT(silk_cms_total(cms) == 0);
+
+        // zipf-like stream, key k occurs 10000 / (k + 1) times
+        uint64_t total = 0;
+        for (uint32_t k = 0; k < 10000; k++)
+        {
+            uint32_t count = 10000 / (k + 1);
+            SILK_ASSERT(silk_cms_add(cms, &k, sizeof(k), count) >= count);
+            total += count;
+        }
+        SILK_ASSERT(silk_cms_total(cms) == total);
+
+        // never underestimated, and the error is within e / width * total for most keys
+        size_t over = 0;
+        for (uint32_t k = 0; k < 10000; k++)
+        {
+            uint32_t estimate = silk_cms_estimate(cms, &k, sizeof(k));
+            uint32_t count = 10000 / (k + 1);
+            SILK_ASSERT(estimate >= count);
+            if (estimate - count > total * 272 / 100 / 1024)
+                over++;
+        }
+        SILK_ASSERT(over < 100);
+
+        // all rows of the same key are hashed with the same seeds
+        const char* key = "silk";
+        uint32_t estimate = silk_cms_estimate(cms, key, strlen(key));
+        SILK_ASSERT(silk_cms_add(cms, key, strlen(key), 3) >= estimate + 3);
+        SILK_ASSERT(silk_cms_estimate(cms, key, strlen(key)) >= estimate + 3);
+
+        silk_cms_clear(cms);
+        SILK_ASSERT(silk_cms_total(cms) == 0);
+        SILK_ASSERT(silk_cms_estimate(cms, key, strlen(key)) == 0);
+        silk_cms_delete(cms);
+
+        silk_cpu_set_features(old);
+    }
+
+    // counters saturate
+    silk_cms_t cms = silk_cms_new(16, 1, 0);
+    SILK_ASSERT(cms != NULL);
+    SILK_ASSERT(silk_cms_add(cms, "a", 1, UINT32_MAX - 1) == UINT32_MAX - 1);
+    SILK_ASSERT(silk_cms_add(cms, "a", 1, 5) == UINT32_MAX);
+    SILK_ASSERT(silk_cms_estimate(cms, "a", 1) == UINT32_MAX);
+    SILK_ASSERT(silk_cms_add(cms, NULL, 0, 1) >= 1);
+    silk_cms_delete(cms);
+}
+
+void test_cms_top()
+{
+    silk_cms_t cms = silk_cms_new(4096, 4, 10);
+    SILK_ASSERT(cms != NULL);
+
+    silk_cms_item_t items[20];
+    SILK_ASSERT(silk_cms_top(cms, items, 20) == 0);
+
+    // interleaved so that heavy hitters are found while the heap is full
+    for (uint32_t round = 0; round < 100; round++)
+    {
+        for (uint32_t k = 0; k < 1000; k++)
+        {
+            uint32_t count = 100 / (k + 1);
+            if (round < count)
+                silk_cms_add(cms, &k, sizeof(k), 1);
+            if (k >= 100 && round == k % 100)
+                silk_cms_add(cms, &k, sizeof(k), 1);
+        }
+    }
+
+    SILK_ASSERT(silk_cms_top(cms, items, 20) == 10);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        uint32_t k;
+        SILK_ASSERT(items[i].len == sizeof(k));
+        memcpy(&k, items[i].data, sizeof(k));
+        SILK_ASSERT(items[i].count == silk_cms_estimate(cms, &k, sizeof(k)));
+        SILK_ASSERT(i == 0 || items[i - 1].count >= items[i].count);
+    }
+
+    // fewer items than tracked
+    SILK_ASSERT(silk_cms_top(cms, items, 3) == 3);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t k;
+        memcpy(&k, items[i].data, sizeof(k));
+        SILK_ASSERT(k == i);
+    }
+    SILK_ASSERT(silk_cms_top(cms, items, 0) == 0);
+
+    silk_cms_clear(cms);
+    SILK_ASSERT(silk_cms_top(cms, items, 20) == 0);
+    SILK_ASSERT(silk_cms_add(cms, "key", 3, 7) == 7);
+    SILK_ASSERT(silk_cms_top(cms, items, 20) == 1);
+    SILK_ASSERT(items[0].len == 3 && memcmp(items[0].data, "key", 3) == 0 && items[0].count == 7);
+    silk_cms_delete(cms);
+}
+
+void test_cms()
+{
+    test_cms_estimate();
+    test_cms_top();
+}
\ No newline at end of file
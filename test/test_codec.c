@@ -0,0 +1,119 @@
+#include <silk/log.h>
+#include <silk/codec.h>
+#include <silk/cpu.h>
+
+#include <string.h>
+
+// RFC 4648 test vectors
+static const char* silk_test_base64_data[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+static const char* silk_test_base64_text[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+
+void test_codec_base64()
+{
+    char text[64];
+    char data[64];
+    for (size_t i = 0; i < sizeof(silk_test_base64_data) / sizeof(silk_test_base64_data[0]); i++)
+    {
+        size_t len = strlen(silk_test_base64_data[i]);
+        size_t n = silk_base64_encode(text, silk_test_base64_data[i], len);
+        SILK_ASSERT(n == silk_base64_encode_length(len));
+        SILK_ASSERT(n == strlen(silk_test_base64_text[i]));
+        SILK_ASSERT(memcmp(text, silk_test_base64_text[i], n) == 0);
+
+        n = silk_base64_decode(data, silk_test_base64_text[i], strlen(silk_test_base64_text[i]));
+        SILK_ASSERT(n == len);
+        SILK_ASSERT(memcmp(data, silk_test_base64_data[i], n) == 0);
+    }
+
+    // padding is optional
+    SILK_ASSERT(silk_base64_decode(data, "Zm9vYg", 6) == 4);
+    SILK_ASSERT(memcmp(data, "foob", 4) == 0);
+
+    SILK_ASSERT(silk_base64_decode(data, "Zm9vY", 5) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_base64_decode(data, "Zm9v Yg==", 9) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_base64_decode(data, "Zm9=Yg==", 8) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_base64_decode(data, "Z===", 4) == SILK_INVALID_INDEX);
+}
+
+void test_codec_hex()
+{
+    char text[64];
+    char data[64];
+    SILK_ASSERT(silk_hex_encode(text, "\x01\xAB\xFF", 3) == 6);
+    SILK_ASSERT(memcmp(text, "01abff", 6) == 0);
+
+    SILK_ASSERT(silk_hex_decode(data, "01AbfF", 6) == 3);
+    SILK_ASSERT(memcmp(data, "\x01\xAB\xFF", 3) == 0);
+
+    SILK_ASSERT(silk_hex_decode(data, "01a", 3) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_hex_decode(data, "0g", 2) == SILK_INVALID_INDEX);
+}
+
+void test_codec_simd()
+{
+    // long enough for the SIMD kernels, the result must be same as scalar
+    unsigned char data[300];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 131 + 7);
+
+    char base64[2][400];
+    char hex[2][600];
+    unsigned char decoded[300];
+    memset(base64, 0, sizeof(base64));
+    memset(hex, 0, sizeof(hex));
+    const uint32_t features[] = {0, UINT32_MAX};
+    for (size_t k = 0; k < sizeof(features) / sizeof(features[0]); k++)
+    {
+        uint32_t old = silk_cpu_set_features(features[k]);
+        for (size_t len = 0; len <= sizeof(data); len += 7)
+        {
+            size_t n = silk_base64_encode(base64[k], data, len);
+            SILK_ASSERT(silk_base64_decode(decoded, base64[k], n) == len);
+            SILK_ASSERT(len == 0 || memcmp(decoded, data, len) == 0);
+
+            n = silk_hex_encode(hex[k], data, len);
+            SILK_ASSERT(silk_hex_decode(decoded, hex[k], n) == len);
+            SILK_ASSERT(len == 0 || memcmp(decoded, data, len) == 0);
+        }
+
+        // an invalid char in the last block
+        base64[k][380] = '.';
+        SILK_ASSERT(silk_base64_decode(decoded, base64[k], 400) == SILK_INVALID_INDEX);
+        hex[k][590] = 'x';
+        SILK_ASSERT(silk_hex_decode(decoded, hex[k], 600) == SILK_INVALID_INDEX);
+        silk_cpu_set_features(old);
+    }
+
+    SILK_ASSERT(memcmp(base64[0], base64[1], sizeof(base64[0])) == 0);
+    SILK_ASSERT(memcmp(hex[0], hex[1], sizeof(hex[0])) == 0);
+}
+
+void test_codec_string()
+{
+    silk_string_t str = silk_string_new("data:");
+    SILK_ASSERT(silk_base64_encode_string(str, "foobar", 6));
+    SILK_ASSERT(strcmp(silk_string_get(str), "data:Zm9vYmFy") == 0);
+    SILK_ASSERT(silk_hex_encode_string(str, "\xAB", 1));
+    SILK_ASSERT(strcmp(silk_string_get(str), "data:Zm9vYmFyab") == 0);
+
+    silk_string_clear(str);
+    SILK_ASSERT(silk_base64_decode_string(str, "Zm9vYmE=", 8));
+    SILK_ASSERT(strcmp(silk_string_get(str), "fooba") == 0);
+    SILK_ASSERT(silk_hex_decode_string(str, "2121", 4));
+    SILK_ASSERT(strcmp(silk_string_get(str), "fooba!!") == 0);
+
+    // not changed if it fails
+    SILK_ASSERT(!silk_base64_decode_string(str, "Zm9v!!!!", 8));
+    SILK_ASSERT(!silk_hex_decode_string(str, "zz", 2));
+    SILK_ASSERT(strcmp(silk_string_get(str), "fooba!!") == 0);
+    SILK_ASSERT(silk_string_length(str) == 7);
+    silk_string_delete(str);
+}
+
+void test_codec()
+{
+    test_codec_base64();
+    test_codec_hex();
+    test_codec_simd();
+    test_codec_string();
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <silk/log.h>
+#include <silk/cpu.h>
+
+void test_cpu_features()
+{
+    uint32_t features = silk_cpu_features();
+    SILK_ASSERT(silk_cpu_supports(0));
+    SILK_ASSERT(silk_cpu_supports(features));
+    SILK_ASSERT(silk_cpu_features() == features);
+#if defined(__x86_64__) || defined(_M_X64)
+    SILK_ASSERT(silk_cpu_supports(SILK_CPU_SSE2));
+#endif
+}
+
+void test_cpu_set_features()
+{
+    uint32_t features = silk_cpu_features();
+    SILK_ASSERT(silk_cpu_set_features(0) == features);
+    SILK_ASSERT(silk_cpu_features() == 0);
+    SILK_ASSERT(silk_cpu_supports(0));
+
+    // features not detected are dropped
+    SILK_ASSERT(silk_cpu_set_features(UINT32_MAX) == 0);
+    SILK_ASSERT(silk_cpu_features() == features);
+}
+
+void test_cpu()
+{
+    test_cpu_features();
+    test_cpu_set_features();
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <silk/log.h>
+#include <silk/crc.h>
+#include <silk/cpu.h>
+#include <silk/memory.h>
+
+#include <string.h>
+
+void test_crc32c_check()
+{
+    uint32_t features[] = {0, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+
+        // check values of CRC-32C, see RFC 3720 B.4
+        uint8_t data[32];
+        SILK_ASSERT(silk_crc32c("123456789", 9, 0) == 0xE3069283);
+        SILK_ASSERT(silk_crc32c("", 0, 0) == 0);
+
+        memset(data, 0, sizeof(data));
+        SILK_ASSERT(silk_crc32c(data, sizeof(data), 0) == 0x8A9136AA);
+
+        memset(data, 0xff, sizeof(data));
+        SILK_ASSERT(silk_crc32c(data, sizeof(data), 0) == 0x62A8AB43);
+
+        for (size_t i = 0; i < sizeof(data); i++)
+            data[i] = (uint8_t)i;
+        SILK_ASSERT(silk_crc32c(data, sizeof(data), 0) == 0x46DD794E);
+
+        for (size_t i = 0; i < sizeof(data); i++)
+            data[i] = (uint8_t)(31 - i);
+        SILK_ASSERT(silk_crc32c(data, sizeof(data), 0) == 0x113FDB5C);
+
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_crc32c_large()
+{
+    // long enough to take both the long and the short interleaved blocks
+    size_t size = 3 * 8192 * 2 + 3 * 256 * 3 + 101;
+    uint8_t* data = silk_alloc(size + 1);
+    SILK_ASSERT(data != NULL);
+
+    uint32_t seed = 1;
+    for (size_t i = 0; i < size + 1; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    uint32_t old = silk_cpu_set_features(0);
+    uint32_t expects[8];
+    for (size_t offset = 0; offset < 2; offset++)
+    {
+        for (size_t k = 0; k < 4; k++)
+        {
+            size_t len = size - k * 1000;
+            expects[offset * 4 + k] = silk_crc32c(data + offset, len, 0);
+        }
+    }
+
+    silk_cpu_set_features(UINT32_MAX);
+    for (size_t offset = 0; offset < 2; offset++)
+    {
+        for (size_t k = 0; k < 4; k++)
+        {
+            size_t len = size - k * 1000;
+            SILK_ASSERT(silk_crc32c(data + offset, len, 0) == expects[offset * 4 + k]);
+        }
+    }
+    silk_cpu_set_features(old);
+
+    silk_free(data);
+}
+
+void test_crc32c_stream()
+{
+    uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 13 + 5);
+
+    uint32_t expect = silk_crc32c(data, sizeof(data), 0);
+    for (size_t step = 1; step < 80; step += 7)
+    {
+        uint32_t crc = 0;
+        for (size_t i = 0; i < sizeof(data); i += step)
+            crc = silk_crc32c(data + i, i + step > sizeof(data) ? sizeof(data) - i : step, crc);
+        SILK_ASSERT(crc == expect);
+    }
+}
+
+void test_crc()
+{
+    test_crc32c_check();
+    test_crc32c_large();
+    test_crc32c_stream();
+}
\ No newline at end of file
@@ -1,6 +1,13 @@
 #include <silk/log.h>
 #include <silk/endian.h>
 
+void test_endian_is_little()
+{
+    const uint32_t value = 0x11223344;
+    SILK_ASSERT(silk_endian_is_little() == (*(const uint8_t*)&value == 0x44));
+    SILK_ASSERT(silk_endian_is_little() == (silk_endian_read_little32(&value) == value));
+}
+
 void test_endian_read_little()
 {
     uint8_t data[] = {
@@ -166,6 +173,7 @@ void test_endian_write_big()
 
 void test_endian()
 {
+    test_endian_is_little();
     test_endian_read_little();
     test_endian_read_big();
     test_endian_write_little();
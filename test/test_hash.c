@@ -1,5 +1,7 @@
 #include <silk/log.h>
 #include <silk/hash.h>
+#include <silk/cpu.h>
+#include <silk/memory.h>
 
 #include <string.h>
 
@@ -38,7 +40,231 @@ void test_hash_murmur3_32()
     SILK_ASSERT(silk_hash_murmur3_32(data, 29, UINT32_MAX) == 3650431031);
 }
 
+void test_hash_murmur3_32_verification()
+{
+    // VerificationTest of SMHasher
+    uint8_t key[256];
+    uint8_t hashes[256 * 4];
+    for (size_t i = 0; i < 256; i++)
+    {
+        key[i] = (uint8_t)i;
+        uint32_t hash = silk_hash_murmur3_32(key, i, (uint32_t)(256 - i));
+        memcpy(hashes + i * 4, &hash, 4);
+    }
+    SILK_ASSERT(silk_hash_murmur3_32(hashes, sizeof(hashes), 0) == 0xB0F57EE3);
+}
+
+void test_hash_murmur3_128()
+{
+    uint64_t hash[2];
+    silk_hash_murmur3_128("", 0, 0, hash);
+    SILK_ASSERT(hash[0] == 0 && hash[1] == 0);
+
+    // VerificationTest of SMHasher
+    uint8_t key[256];
+    uint8_t hashes[256 * 16];
+    for (size_t i = 0; i < 256; i++)
+    {
+        key[i] = (uint8_t)i;
+        silk_hash_murmur3_128(key, i, (uint32_t)(256 - i), hash);
+        memcpy(hashes + i * 16, hash, 16);
+    }
+    silk_hash_murmur3_128(hashes, sizeof(hashes), 0, hash);
+    SILK_ASSERT((uint32_t)hash[0] == 0x6384BA69);
+}
+
+void test_hash_wyhash()
+{
+    // test vectors of wyhash final4
+    const char* msgs[] = {
+        "",
+        "a",
+        "abc",
+        "message digest",
+        "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+    };
+    const uint64_t expects[] = {
+        0x0409638ee2bde459ull,
+        0xa8412d091b5fe0a9ull,
+        0x32dd92e4b2915153ull,
+        0x8619124089a3a16bull,
+        0x7a43afb61d7f5f40ull,
+        0xff42329b90e50d58ull,
+        0xc39cab13b115aad3ull,
+    };
+
+    for (size_t i = 0; i < sizeof(msgs) / sizeof(msgs[0]); i++)
+    {
+        SILK_ASSERT(silk_hash_wyhash(msgs[i], strlen(msgs[i]), i) == expects[i]);
+    }
+
+    // every length hits a different path, flipping any byte changes the hash
+    uint8_t data[128];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 7 + 1);
+
+    for (size_t len = 1; len <= sizeof(data); len++)
+    {
+        uint64_t hash = silk_hash_wyhash(data, len, 0);
+        SILK_ASSERT(hash != silk_hash_wyhash(data, len - 1, 0));
+        SILK_ASSERT(hash != silk_hash_wyhash(data, len, 1));
+        for (size_t i = 0; i < len; i++)
+        {
+            data[i] ^= 0x10;
+            SILK_ASSERT(hash != silk_hash_wyhash(data, len, 0));
+            data[i] ^= 0x10;
+        }
+    }
+}
+
+void test_hash_murmur3_32_seeds()
+{
+    uint8_t data[40];
+    uint32_t seeds[19];
+    uint32_t hashes[19];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 29 + 3);
+    for (size_t i = 0; i < 19; i++)
+        seeds[i] = (uint32_t)(i * 0x9e3779b9);
+
+    uint32_t features[] = {0, SILK_CPU_SSE2 | SILK_CPU_SSE41, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+        for (size_t len = 0; len <= sizeof(data); len++)
+        {
+            silk_hash_murmur3_32_seeds(data, len, seeds, 19, hashes);
+            for (size_t i = 0; i < 19; i++)
+            {
+                SILK_ASSERT(hashes[i] == silk_hash_murmur3_32(data, len, seeds[i]));
+            }
+        }
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_hash_state()
+{
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 31 + 7);
+
+    // split the data into pieces of every size, the result must be the same as one-shot
+    size_t lens[] = {0, 1, 3, 4, 15, 16, 17, 47, 48, 49, 96, 97, 145, 300};
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++)
+    {
+        size_t len = lens[l];
+        uint32_t expect32 = silk_hash_murmur3_32(data, len, 7);
+        uint64_t expect128[2];
+        silk_hash_murmur3_128(data, len, 7, expect128);
+        uint64_t expect64 = silk_hash_wyhash(data, len, 7);
+
+        for (size_t step = 1; step <= 50; step++)
+        {
+            silk_hash_state_t state32;
+            silk_hash_state_t state128;
+            silk_hash_state_t state64;
+            silk_hash_murmur3_32_init(&state32, 7);
+            silk_hash_murmur3_128_init(&state128, 7);
+            silk_hash_wyhash_init(&state64, 7);
+
+            // vary the piece size to mix aligned and unaligned pieces
+            for (size_t i = 0, n = 0; i < len; i += n)
+            {
+                n = (i / step) % 2 == 0 ? step : step / 2 + 1;
+                if (n > len - i)
+                    n = len - i;
+
+                silk_hash_murmur3_32_update(&state32, data + i, n);
+                silk_hash_murmur3_128_update(&state128, data + i, n);
+                silk_hash_wyhash_update(&state64, data + i, n);
+            }
+            silk_hash_wyhash_update(&state64, NULL, 0);
+
+            uint64_t hash128[2];
+            silk_hash_murmur3_128_final(&state128, hash128);
+            SILK_ASSERT(silk_hash_murmur3_32_final(&state32) == expect32);
+            SILK_ASSERT(hash128[0] == expect128[0] && hash128[1] == expect128[1]);
+            SILK_ASSERT(silk_hash_wyhash_final(&state64) == expect64);
+        }
+    }
+
+    // final does not change the state
+    silk_hash_state_t state;
+    silk_hash_wyhash_init(&state, 0);
+    silk_hash_wyhash_update(&state, "hello", 5);
+    SILK_ASSERT(silk_hash_wyhash_final(&state) == silk_hash_wyhash("hello", 5, 0));
+    silk_hash_wyhash_update(&state, "world", 5);
+    SILK_ASSERT(silk_hash_wyhash_final(&state) == silk_hash_wyhash("helloworld", 10, 0));
+}
+
+void test_hash_murmur3_32_batch()
+{
+    size_t count = 37;
+    uint8_t* keys = silk_alloc(count * 33);
+    uint32_t* hashes = silk_alloc(count * sizeof(uint32_t));
+    SILK_ASSERT(keys != NULL && hashes != NULL);
+
+    for (size_t i = 0; i < count * 33; i++)
+        keys[i] = (uint8_t)(i * 131 + 17);
+
+    uint32_t features[] = {0, SILK_CPU_SSE2 | SILK_CPU_SSE41, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+        for (size_t key_len = 0; key_len <= 33; key_len++)
+        {
+            // count is not a multiple of the lanes, the rest are hashed one by one
+            silk_hash_murmur3_32_batch(keys, key_len, count, 0x9747b28c, hashes);
+            for (size_t i = 0; i < count; i++)
+            {
+                SILK_ASSERT(hashes[i] == silk_hash_murmur3_32(keys + i * key_len, key_len, 0x9747b28c));
+            }
+        }
+        silk_cpu_set_features(old);
+    }
+
+    silk_free(hashes);
+    silk_free(keys);
+}
+
+void test_hash_jump()
+{
+    size_t counts[10] = {0};
+    for (uint64_t k = 0; k < 100000; k++)
+    {
+        uint64_t key = silk_hash_wyhash(&k, sizeof(k), 0);
+        SILK_ASSERT(silk_hash_jump(key, 1) == 0);
+
+        // a key only moves to the new bucket when buckets grows
+        uint32_t bucket = silk_hash_jump(key, 1);
+        for (uint32_t buckets = 2; buckets <= 10; buckets++)
+        {
+            uint32_t next = silk_hash_jump(key, buckets);
+            SILK_ASSERT(next < buckets);
+            SILK_ASSERT(next == bucket || next == buckets - 1);
+            bucket = next;
+        }
+        counts[bucket]++;
+    }
+
+    // balanced
+    for (size_t i = 0; i < 10; i++)
+        SILK_ASSERT(counts[i] > 9500 && counts[i] < 10500);
+
+    SILK_ASSERT(silk_hash_jump(UINT64_MAX, UINT32_MAX) < UINT32_MAX);
+}
+
 void test_hash()
 {
     test_hash_murmur3_32();
+    test_hash_murmur3_32_verification();
+    test_hash_murmur3_32_batch();
+    test_hash_murmur3_32_seeds();
+    test_hash_murmur3_128();
+    test_hash_wyhash();
+    test_hash_state();
+    test_hash_jump();
 }
\ No newline at end of file
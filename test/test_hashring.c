@@ -0,0 +1,90 @@
+#include <silk/log.h>
+#include <silk/hashring.h>
+
+void test_hashring_get()
+{
+    silk_hashring_t ring = silk_hashring_new(160);
+    SILK_ASSERT(ring != NULL);
+    SILK_ASSERT(silk_hashring_length(ring) == 0);
+    SILK_ASSERT(silk_hashring_get(ring, "key", 3) == SILK_INVALID_INDEX);
+
+    for (uint32_t shard = 0; shard < 10; shard++)
+        SILK_ASSERT(silk_hashring_add(ring, shard * 7));
+    SILK_ASSERT(!silk_hashring_add(ring, 14));
+    SILK_ASSERT(silk_hashring_length(ring) == 10);
+
+    // balanced, 160 virtual nodes keep each shard within about 25%
+    size_t counts[10] = {0};
+    for (uint32_t k = 0; k < 100000; k++)
+    {
+        size_t shard = silk_hashring_get(ring, &k, sizeof(k));
+        SILK_ASSERT(shard % 7 == 0 && shard / 7 < 10);
+        counts[shard / 7]++;
+    }
+    for (size_t i = 0; i < 10; i++)
+        SILK_ASSERT(counts[i] > 7500 && counts[i] < 12500);
+
+    // the same key always goes to the same shard
+    SILK_ASSERT(silk_hashring_get(ring, "key", 3) == silk_hashring_get(ring, "key", 3));
+    SILK_ASSERT(silk_hashring_get(ring, NULL, 0) == silk_hashring_get(ring, "", 0));
+
+    // wrap around
+    SILK_ASSERT(silk_hashring_get_hash(ring, UINT32_MAX) == silk_hashring_get_hash(ring, 0));
+
+    silk_hashring_clear(ring);
+    SILK_ASSERT(silk_hashring_length(ring) == 0);
+    SILK_ASSERT(silk_hashring_get_hash(ring, 0) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_hashring_add(ring, 3));
+    SILK_ASSERT(silk_hashring_get_hash(ring, 12345) == 3);
+    silk_hashring_delete(ring);
+}
+
+void test_hashring_rebalance()
+{
+    silk_hashring_t ring = silk_hashring_new(100);
+    SILK_ASSERT(ring != NULL);
+    for (uint32_t shard = 0; shard < 20; shard++)
+        SILK_ASSERT(silk_hashring_add(ring, shard));
+
+    size_t shards[10000];
+    for (uint32_t k = 0; k < 10000; k++)
+        shards[k] = silk_hashring_get(ring, &k, sizeof(k));
+
+    // keys only move to the new shard, about 1/21 of them
+    SILK_ASSERT(silk_hashring_add(ring, 20));
+    size_t moved = 0;
+    for (uint32_t k = 0; k < 10000; k++)
+    {
+        size_t shard = silk_hashring_get(ring, &k, sizeof(k));
+        if (shard != shards[k])
+        {
+            SILK_ASSERT(shard == 20);
+            moved++;
+        }
+    }
+    SILK_ASSERT(moved > 200 && moved < 800);
+
+    // removing it moves them back, and only them
+    SILK_ASSERT(silk_hashring_remove(ring, 20));
+    SILK_ASSERT(!silk_hashring_remove(ring, 20));
+    SILK_ASSERT(silk_hashring_length(ring) == 20);
+    for (uint32_t k = 0; k < 10000; k++)
+        SILK_ASSERT(silk_hashring_get(ring, &k, sizeof(k)) == shards[k]);
+
+    // keys of a removed shard move to the others
+    SILK_ASSERT(silk_hashring_remove(ring, 5));
+    for (uint32_t k = 0; k < 10000; k++)
+    {
+        size_t shard = silk_hashring_get(ring, &k, sizeof(k));
+        SILK_ASSERT(shard != 5);
+        SILK_ASSERT(shards[k] == 5 || shard == shards[k]);
+    }
+
+    silk_hashring_delete(ring);
+}
+
+void test_hashring()
+{
+    test_hashring_get();
+    test_hashring_rebalance();
+}
\ No newline at end of file
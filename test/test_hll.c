@@ -0,0 +1,151 @@
+#include <silk/log.h>
+#include <silk/hll.h>
+#include <silk/cpu.h>
+
+#include <string.h>
+
+/*******************************************************
+ * @brief determine whether an estimate is close enough
+ * @param estimate the estimated count
+ * @param count the real count
+ * @param error the relative error allowed
+ * @return whether it is close enough
+ *******************************************************/
+static bool test_hll_close(uint64_t estimate, uint64_t count, double error)
+{
+    double diff = (double)estimate - (double)count;
+    if (diff < 0)
+        diff = -diff;
+    return diff <= (double)count * error + 1;
+}
+
+void test_hll_count()
+{
+    silk_hll_t hll = silk_hll_new(14);
+    SILK_ASSERT(hll != NULL);
+    SILK_ASSERT(silk_hll_count(hll) == 0);
+
+    uint64_t checkpoints[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    uint64_t i = 0;
+    for (size_t c = 0; c < sizeof(checkpoints) / sizeof(checkpoints[0]); c++)
+    {
+        for (; i < checkpoints[c]; i++)
+            SILK_ASSERT(silk_hll_add(hll, &i, sizeof(i)));
+
+        // 3 times the standard error of 2^14 registers
+        SILK_ASSERT(test_hll_close(silk_hll_count(hll), checkpoints[c], 0.025));
+    }
+
+    // duplicated keys are not counted
+    for (i = 0; i < 1000; i++)
+        SILK_ASSERT(silk_hll_add(hll, &i, sizeof(i)));
+    SILK_ASSERT(test_hll_close(silk_hll_count(hll), 1000000, 0.025));
+
+    silk_hll_clear(hll);
+    SILK_ASSERT(silk_hll_count(hll) == 0);
+    silk_hll_delete(hll);
+
+    // the smallest precision
+    hll = silk_hll_new(4);
+    SILK_ASSERT(hll != NULL);
+    for (i = 0; i < 100000; i++)
+        SILK_ASSERT(silk_hll_add(hll, &i, sizeof(i)));
+    SILK_ASSERT(test_hll_close(silk_hll_count(hll), 100000, 0.8));
+    silk_hll_delete(hll);
+}
+
+void test_hll_merge()
+{
+    uint32_t features[] = {0, SILK_CPU_SSE2, UINT32_MAX};
+    for (size_t f = 0; f < sizeof(features) / sizeof(features[0]); f++)
+    {
+        uint32_t old = silk_cpu_set_features(features[f]);
+
+        silk_hll_t dense1 = silk_hll_new(12);
+        silk_hll_t dense2 = silk_hll_new(12);
+        silk_hll_t sparse = silk_hll_new(12);
+        silk_hll_t all = silk_hll_new(12);
+        SILK_ASSERT(dense1 != NULL && dense2 != NULL && sparse != NULL && all != NULL);
+
+        for (uint64_t i = 0; i < 60000; i++)
+        {
+            SILK_ASSERT(silk_hll_add(i < 40000 ? dense1 : dense2, &i, sizeof(i)));
+            SILK_ASSERT(silk_hll_add(all, &i, sizeof(i)));
+        }
+        for (uint64_t i = 60000; i < 60100; i++)
+        {
+            SILK_ASSERT(silk_hll_add(sparse, &i, sizeof(i)));
+            SILK_ASSERT(silk_hll_add(all, &i, sizeof(i)));
+        }
+
+        // merging is the same as adding all keys into one sketch
+        silk_hll_t merged = silk_hll_new(12);
+        SILK_ASSERT(merged != NULL);
+        SILK_ASSERT(silk_hll_merge(merged, sparse));
+        SILK_ASSERT(silk_hll_count(merged) == silk_hll_count(sparse));
+        SILK_ASSERT(silk_hll_merge(merged, dense1));
+        SILK_ASSERT(silk_hll_merge(merged, dense2));
+        SILK_ASSERT(silk_hll_merge(merged, sparse));
+        SILK_ASSERT(silk_hll_count(merged) == silk_hll_count(all));
+        SILK_ASSERT(test_hll_close(silk_hll_count(merged), 60100, 0.05));
+
+        silk_hll_t other = silk_hll_new(13);
+        SILK_ASSERT(other != NULL);
+        SILK_ASSERT(!silk_hll_merge(merged, other));
+
+        silk_hll_delete(other);
+        silk_hll_delete(merged);
+        silk_hll_delete(all);
+        silk_hll_delete(sparse);
+        silk_hll_delete(dense2);
+        silk_hll_delete(dense1);
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_hll_serialize()
+{
+    uint8_t buffer[12 + 1024];
+    silk_hll_t hll = silk_hll_new(10);
+    SILK_ASSERT(hll != NULL);
+    SILK_ASSERT(silk_hll_serialized_size(hll) == 12);
+
+    for (uint64_t n = 0; n < 2; n++)
+    {
+        // sparse at first, then dense
+        for (uint64_t i = 0; i < (n == 0 ? 100 : 10000); i++)
+            SILK_ASSERT(silk_hll_add(hll, &i, sizeof(i)));
+
+        size_t size = silk_hll_serialized_size(hll);
+        SILK_ASSERT(n == 0 ? size <= 12 + 4 * 100 : size == 12 + 1024);
+        SILK_ASSERT(!silk_hll_serialize(hll, buffer, size - 1));
+        SILK_ASSERT(silk_hll_serialize(hll, buffer, sizeof(buffer)));
+        SILK_ASSERT(memcmp(buffer, "SHLL", 4) == 0);
+
+        silk_hll_t copy = silk_hll_deserialize(buffer, size);
+        SILK_ASSERT(copy != NULL);
+        SILK_ASSERT(silk_hll_count(copy) == silk_hll_count(hll));
+        SILK_ASSERT(silk_hll_serialized_size(copy) == size);
+        silk_hll_delete(copy);
+
+        // invalid data
+        SILK_ASSERT(silk_hll_deserialize(buffer, size - 1) == NULL);
+        buffer[5] = 30;
+        SILK_ASSERT(silk_hll_deserialize(buffer, size) == NULL);
+        buffer[5] = 10;
+        buffer[12] = 0xff;
+        buffer[13] = 0xff;
+        buffer[14] = 0xff;
+        buffer[15] = 0xff;
+        SILK_ASSERT(silk_hll_deserialize(buffer, size) == NULL);
+    }
+
+    silk_hll_delete(hll);
+}
+
+void test_hll()
+{
+    test_hll_count();
+    test_hll_merge();
+    test_hll_serialize();
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <silk/log.h>
+#include <silk/intern.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define N 10000
+
+void test_intern_put()
+{
+    silk_intern_t intern = silk_intern_new();
+    SILK_ASSERT(silk_intern_length(intern) == 0);
+
+    size_t hello = silk_intern_puts(intern, "hello");
+    size_t world = silk_intern_puts(intern, "world");
+    SILK_ASSERT(hello != SILK_INVALID_INDEX);
+    SILK_ASSERT(world != SILK_INVALID_INDEX);
+    SILK_ASSERT(hello != world);
+    SILK_ASSERT(silk_intern_length(intern) == 2);
+
+    // same string, same handle
+    char buffer[] = "hello";
+    SILK_ASSERT(silk_intern_puts(intern, buffer) == hello);
+    SILK_ASSERT(silk_intern_put(intern, "hello world", 5) == hello);
+    SILK_ASSERT(silk_intern_get(intern, hello) == silk_intern_get(intern, silk_intern_puts(intern, "hello")));
+    SILK_ASSERT(silk_intern_length(intern) == 2);
+
+    SILK_ASSERT(strcmp(silk_intern_get(intern, hello), "hello") == 0);
+    SILK_ASSERT(strcmp(silk_intern_get(intern, world), "world") == 0);
+    SILK_ASSERT(silk_intern_string_length(intern, hello) == 5);
+
+    // empty string and embedded '\0'
+    size_t empty = silk_intern_put(intern, NULL, 0);
+    SILK_ASSERT(silk_intern_puts(intern, "") == empty);
+    SILK_ASSERT(silk_intern_string_length(intern, empty) == 0);
+    size_t binary = silk_intern_put(intern, "a\0b", 3);
+    SILK_ASSERT(binary != silk_intern_puts(intern, "a"));
+    SILK_ASSERT(silk_intern_string_length(intern, binary) == 3);
+
+    silk_intern_delete(intern);
+}
+
+void test_intern_find()
+{
+    silk_intern_t intern = silk_intern_new();
+    SILK_ASSERT(silk_intern_finds(intern, "hello") == SILK_INVALID_INDEX);
+    size_t hello = silk_intern_puts(intern, "hello");
+    SILK_ASSERT(silk_intern_finds(intern, "hello") == hello);
+    SILK_ASSERT(silk_intern_find(intern, "hello", 4) == SILK_INVALID_INDEX);
+    SILK_ASSERT(silk_intern_length(intern) == 1);
+
+    silk_intern_clear(intern);
+    SILK_ASSERT(silk_intern_length(intern) == 0);
+    SILK_ASSERT(silk_intern_finds(intern, "hello") == SILK_INVALID_INDEX);
+    silk_intern_delete(intern);
+}
+
+void test_intern_many()
+{
+    silk_intern_t intern = silk_intern_new();
+    char buffer[32];
+    const char* pointers[N];
+
+    for (int i = 0; i < N; i++)
+    {
+        snprintf(buffer, sizeof(buffer), "identifier_%d", i);
+        size_t handle = silk_intern_puts(intern, buffer);
+        SILK_ASSERT(handle == (size_t)i);
+        pointers[i] = silk_intern_get(intern, handle);
+    }
+
+    // handles and pointers are stable while growing
+    for (int i = 0; i < N; i++)
+    {
+        snprintf(buffer, sizeof(buffer), "identifier_%d", i);
+        SILK_ASSERT(silk_intern_puts(intern, buffer) == (size_t)i);
+        SILK_ASSERT(silk_intern_get(intern, i) == pointers[i]);
+        SILK_ASSERT(strcmp(pointers[i], buffer) == 0);
+    }
+    SILK_ASSERT(silk_intern_length(intern) == N);
+
+    // large string
+    static char large[100000];
+    memset(large, 'x', sizeof(large) - 1);
+    size_t handle = silk_intern_puts(intern, large);
+    SILK_ASSERT(strcmp(silk_intern_get(intern, handle), large) == 0);
+    SILK_ASSERT(silk_intern_puts(intern, large) == handle);
+
+    silk_intern_delete(intern);
+}
+
+void test_intern()
+{
+    test_intern_put();
+    test_intern_find();
+    test_intern_many();
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <silk/lru.h>
+#include <silk/log.h>
+
+#include <string.h>
+
+void test_lru_put()
+{
+    // the node and the index slot are charged besides the key and the value
+    size_t overhead = silk_lru_entry_bytes(sizeof(uint32_t), 0);
+    SILK_ASSERT(overhead > sizeof(uint32_t) + sizeof(void*) * 2);
+    SILK_ASSERT(silk_lru_entry_bytes(sizeof(uint32_t), 10) == overhead + 10);
+
+    silk_lru_t lru = silk_lru_new(sizeof(uint32_t), 1000, SILK_LRU_POLICY_LRU);
+    SILK_ASSERT(lru != NULL);
+    SILK_ASSERT(silk_lru_length(lru) == 0);
+    SILK_ASSERT(silk_lru_bytes(lru) == 0);
+
+    char buf[64];
+    size_t size = 0;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        memset(buf, 'a' + i, sizeof(buf));
+        SILK_ASSERT(silk_lru_put(lru, &i, buf, 10 + i));
+    }
+    SILK_ASSERT(silk_lru_length(lru) == 10);
+    SILK_ASSERT(silk_lru_bytes(lru) == 10 * overhead + 145);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        const char* value = silk_lru_get(lru, &i, &size);
+        SILK_ASSERT(value != NULL);
+        SILK_ASSERT(size == 10 + i);
+        SILK_ASSERT(value[0] == 'a' + (int)i && value[size - 1] == 'a' + (int)i);
+    }
+
+    // replace with another size
+    uint32_t key = 3;
+    SILK_ASSERT(silk_lru_put(lru, &key, "xyz", 3));
+    SILK_ASSERT(silk_lru_length(lru) == 10);
+    SILK_ASSERT(silk_lru_bytes(lru) == 10 * overhead + 145 - 13 + 3);
+    SILK_ASSERT(memcmp(silk_lru_get(lru, &key, &size), "xyz", 3) == 0);
+    SILK_ASSERT(size == 3);
+
+    // empty value
+    key = 100;
+    SILK_ASSERT(silk_lru_put(lru, &key, NULL, 0));
+    SILK_ASSERT(silk_lru_get(lru, &key, &size) != NULL);
+    SILK_ASSERT(size == 0);
+
+    // larger than the whole budget, the old value is kept
+    char large[1000];
+    memset(large, 0, sizeof(large));
+    key = 200;
+    SILK_ASSERT(!silk_lru_put(lru, &key, large, sizeof(large)));
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) == NULL);
+    SILK_ASSERT(silk_lru_length(lru) == 11);
+    key = 3;
+    SILK_ASSERT(!silk_lru_put(lru, &key, large, sizeof(large)));
+    SILK_ASSERT(memcmp(silk_lru_get(lru, &key, &size), "xyz", 3) == 0);
+    SILK_ASSERT(silk_lru_length(lru) == 11);
+
+    // erase
+    key = 5;
+    SILK_ASSERT(silk_lru_erase(lru, &key));
+    SILK_ASSERT(!silk_lru_erase(lru, &key));
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) == NULL);
+    SILK_ASSERT(silk_lru_length(lru) == 10);
+
+    silk_lru_stats_t stats;
+    silk_lru_stats(lru, &stats);
+    SILK_ASSERT(stats.evictions == 0);
+    SILK_ASSERT(stats.misses == 2);
+
+    silk_lru_clear(lru);
+    SILK_ASSERT(silk_lru_length(lru) == 0);
+    SILK_ASSERT(silk_lru_bytes(lru) == 0);
+    key = 1;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) == NULL);
+
+    silk_lru_delete(lru);
+}
+
+void test_lru_evict()
+{
+    // 10 entries of 16 bytes
+    size_t budget = 10 * silk_lru_entry_bytes(sizeof(uint32_t), 16);
+    silk_lru_t lru = silk_lru_new(sizeof(uint32_t), budget, SILK_LRU_POLICY_LRU);
+    SILK_ASSERT(lru != NULL);
+
+    char buf[32];
+    memset(buf, 0, sizeof(buf));
+    for (uint32_t i = 0; i < 10; i++)
+        SILK_ASSERT(silk_lru_put(lru, &i, buf, 16));
+    SILK_ASSERT(silk_lru_bytes(lru) == budget);
+
+    // touch 0, then 1 is the least recently used
+    uint32_t key = 0;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+    key = 10;
+    SILK_ASSERT(silk_lru_put(lru, &key, buf, 16));
+    key = 1;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) == NULL);
+    key = 0;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+    SILK_ASSERT(silk_lru_length(lru) == 10);
+
+    // a larger entry evicts more, 2 and 3 are the oldest
+    key = 11;
+    SILK_ASSERT(silk_lru_put(lru, &key, buf, 32));
+    SILK_ASSERT(silk_lru_length(lru) == 9);
+    SILK_ASSERT(silk_lru_bytes(lru) <= budget);
+    for (key = 2; key < 4; key++)
+        SILK_ASSERT(silk_lru_get(lru, &key, NULL) == NULL);
+    key = 4;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+
+    silk_lru_stats_t stats;
+    silk_lru_stats(lru, &stats);
+    SILK_ASSERT(stats.evictions == 3);
+    SILK_ASSERT(stats.hits == 3);
+    SILK_ASSERT(stats.misses == 3);
+
+    silk_lru_delete(lru);
+}
+
+void test_lru_clock()
+{
+    size_t budget = 10 * silk_lru_entry_bytes(sizeof(uint32_t), 16);
+    silk_lru_t lru = silk_lru_new(sizeof(uint32_t), budget, SILK_LRU_POLICY_CLOCK);
+    SILK_ASSERT(lru != NULL);
+
+    char buf[16];
+    memset(buf, 0, sizeof(buf));
+    for (uint32_t i = 0; i < 10; i++)
+        SILK_ASSERT(silk_lru_put(lru, &i, buf, 16));
+
+    // 0 and 1 are referenced, they get a second chance, 2 and 3 are evicted
+    uint32_t key = 1;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+    key = 0;
+    SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+    for (key = 10; key < 12; key++)
+        SILK_ASSERT(silk_lru_put(lru, &key, buf, 16));
+
+    for (key = 0; key < 12; key++)
+    {
+        bool cached = key < 2 || key > 3;
+        SILK_ASSERT((silk_lru_get(lru, &key, NULL) != NULL) == cached);
+    }
+
+    // a hot working set survives a scan of cold keys
+    for (uint32_t round = 0; round < 100; round++)
+    {
+        for (key = 0; key < 2; key++)
+            SILK_ASSERT(silk_lru_get(lru, &key, NULL) != NULL);
+        key = 1000 + round;
+        SILK_ASSERT(silk_lru_put(lru, &key, buf, 16));
+    }
+    SILK_ASSERT(silk_lru_length(lru) == 10);
+    SILK_ASSERT(silk_lru_bytes(lru) == budget);
+
+    silk_lru_delete(lru);
+}
+
+void test_lru()
+{
+    test_lru_put();
+    test_lru_evict();
+    test_lru_clock();
+}
\ No newline at end of file
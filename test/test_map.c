@@ -0,0 +1,185 @@
+#include <silk/log.h>
+#include <silk/map.h>
+
+#include <string.h>
+
+struct TestMapValue
+{
+    uint64_t number;
+    char name[12];
+};
+
+/*******************************************************
+ * @brief sum keys and values of a map
+ * @param data the sums
+ * @param key a key
+ * @param value a value
+ *******************************************************/
+static void test_map_sum(void* data, const void* key, void* value)
+{
+    uint64_t* sums = data;
+    sums[0] += *(const uint32_t*)key;
+    sums[1] += ((const struct TestMapValue*)value)->number;
+}
+
+void test_map_put()
+{
+    silk_map_t map = silk_map_new(sizeof(uint32_t), sizeof(struct TestMapValue));
+    SILK_ASSERT(map != NULL);
+    SILK_ASSERT(silk_map_length(map) == 0);
+
+    struct TestMapValue value;
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        value.number = (uint64_t)i * 3;
+        memset(value.name, 'a' + i % 26, sizeof(value.name));
+        SILK_ASSERT(silk_map_put(map, &i, &value));
+    }
+    SILK_ASSERT(silk_map_length(map) == 10000);
+
+    // replace
+    for (uint32_t i = 0; i < 10000; i += 2)
+    {
+        value.number = i;
+        SILK_ASSERT(silk_map_put(map, &i, &value));
+    }
+    SILK_ASSERT(silk_map_length(map) == 10000);
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        bool found = silk_map_get(map, &i, &value);
+        SILK_ASSERT(found == (i < 10000));
+        if (found)
+            SILK_ASSERT(value.number == (i % 2 == 0 ? i : (uint64_t)i * 3));
+    }
+
+    // values are aligned in place
+    struct TestMapValue* slot = silk_map_find(map, &(uint32_t){7});
+    SILK_ASSERT(slot != NULL && ((uintptr_t)slot & 7) == 0);
+    SILK_ASSERT(slot->number == 21 && slot->name[0] == 'h');
+    slot->number = 100;
+    SILK_ASSERT(silk_map_get(map, &(uint32_t){7}, &value) && value.number == 100);
+    SILK_ASSERT(silk_map_find(map, &(uint32_t){10000}) == NULL);
+    SILK_ASSERT(silk_map_get(map, &(uint32_t){8}, NULL));
+
+    uint64_t sums[2] = {0, 0};
+    SILK_ASSERT(silk_map_foreach(map, test_map_sum, sums));
+    SILK_ASSERT(sums[0] == 9999ull * 10000 / 2);
+
+    silk_map_clear(map);
+    SILK_ASSERT(silk_map_length(map) == 0);
+    SILK_ASSERT(!silk_map_get(map, &(uint32_t){1}, NULL));
+    silk_map_delete(map);
+}
+
+void test_map_emplace()
+{
+    silk_map_t map = silk_map_new(sizeof(uint64_t), sizeof(uint32_t));
+    SILK_ASSERT(map != NULL);
+    SILK_ASSERT(silk_map_reserve(map, 1000));
+
+    // count occurrences
+    for (uint64_t i = 0; i < 3000; i++)
+    {
+        uint64_t key = i % 1000;
+        bool inserted;
+        uint32_t* count = silk_map_emplace(map, &key, &inserted);
+        SILK_ASSERT(count != NULL);
+        SILK_ASSERT(inserted == (i < 1000));
+        if (inserted)
+            *count = 0;
+        (*count)++;
+    }
+    SILK_ASSERT(silk_map_length(map) == 1000);
+    for (uint64_t i = 0; i < 1000; i++)
+        SILK_ASSERT(*(uint32_t*)silk_map_find(map, &i) == 3);
+
+    // removed slots are reused, and dropped by rehashing
+    for (uint64_t i = 0; i < 1000; i += 2)
+        SILK_ASSERT(silk_map_erase(map, &i));
+    SILK_ASSERT(!silk_map_erase(map, &(uint64_t){0}));
+    SILK_ASSERT(silk_map_length(map) == 500);
+    uint32_t one = 1;
+    for (uint32_t round = 0; round < 10; round++)
+    {
+        for (uint64_t i = 2000; i < 3000; i++)
+            SILK_ASSERT(silk_map_put(map, &i, &one));
+        for (uint64_t i = 2000; i < 3000; i++)
+            SILK_ASSERT(silk_map_erase(map, &i));
+    }
+    for (uint64_t i = 0; i < 1000; i++)
+        SILK_ASSERT((silk_map_find(map, &i) != NULL) == (i % 2 == 1));
+
+    silk_map_delete(map);
+
+    // a map without values works as a set
+    map = silk_map_new(sizeof(uint16_t), 0);
+    SILK_ASSERT(map != NULL);
+    SILK_ASSERT(silk_map_put(map, &(uint16_t){5}, NULL));
+    SILK_ASSERT(silk_map_get(map, &(uint16_t){5}, NULL));
+    SILK_ASSERT(!silk_map_get(map, &(uint16_t){6}, NULL));
+    silk_map_delete(map);
+}
+
+void test_map_churn(int engine)
+{
+    silk_map_t map = silk_map_new_engine(sizeof(uint32_t), sizeof(uint32_t), engine);
+    SILK_ASSERT(map != NULL);
+
+    // random puts and erases, checked against a plain array, 0 means absent
+    static uint32_t expect[4096];
+    memset(expect, 0, sizeof(expect));
+    size_t length = 0;
+    uint32_t seed = 12345;
+    for (uint32_t i = 1; i <= 200000; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        uint32_t key = (seed >> 8) % 4096;
+        if ((seed >> 28) < 8)
+        {
+            length += expect[key] == 0;
+            expect[key] = i;
+            SILK_ASSERT(silk_map_put(map, &key, &i));
+        }
+        else
+        {
+            SILK_ASSERT(silk_map_erase(map, &key) == (expect[key] != 0));
+            length -= expect[key] != 0;
+            expect[key] = 0;
+        }
+    }
+    SILK_ASSERT(silk_map_length(map) == length);
+
+    uint32_t value;
+    for (uint32_t key = 0; key < 4096; key++)
+    {
+        bool found = silk_map_get(map, &key, &value);
+        SILK_ASSERT(found == (expect[key] != 0));
+        if (found)
+            SILK_ASSERT(value == expect[key]);
+    }
+
+    silk_map_probe_stats_t stats;
+    silk_map_probe_stats(map, &stats);
+    SILK_ASSERT(stats.hit >= 1 && stats.hit <= (double)stats.max);
+    SILK_ASSERT(stats.miss >= 1);
+
+    // erase all, nothing is left behind
+    for (uint32_t key = 0; key < 4096; key++)
+        silk_map_erase(map, &key);
+    SILK_ASSERT(silk_map_length(map) == 0);
+    silk_map_probe_stats(map, &stats);
+    SILK_ASSERT(stats.max == 0);
+    if (engine == SILK_MAP_ENGINE_ROBIN_HOOD)
+        SILK_ASSERT(stats.miss == 1);
+
+    silk_map_delete(map);
+}
+
+void test_map()
+{
+    test_map_put();
+    test_map_emplace();
+    test_map_churn(SILK_MAP_ENGINE_LINEAR);
+    test_map_churn(SILK_MAP_ENGINE_ROBIN_HOOD);
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <silk/log.h>
+#include <silk/matcher.h>
+
+#include <string.h>
+
+struct TestMatcherResult
+{
+    size_t count;
+    size_t patterns[16];
+    size_t offsets[16];
+};
+
+static bool test_matcher_collect(size_t pattern, size_t offset, void* userdata)
+{
+    struct TestMatcherResult* result = userdata;
+    result->patterns[result->count] = pattern;
+    result->offsets[result->count] = offset;
+    result->count++;
+    return result->count < 16;
+}
+
+void test_matcher_new()
+{
+    silk_matcher_t matcher = silk_matcher_new();
+    SILK_ASSERT(matcher != NULL);
+    SILK_ASSERT(silk_matcher_length(matcher) == 0);
+    SILK_ASSERT(silk_matcher_match(matcher, "hello", 5, NULL, NULL) == 0);
+    silk_matcher_delete(matcher);
+}
+
+void test_matcher_match()
+{
+    silk_matcher_t matcher = silk_matcher_new();
+    SILK_ASSERT(silk_matcher_adds(matcher, "he") == 0);
+    SILK_ASSERT(silk_matcher_adds(matcher, "she") == 1);
+    SILK_ASSERT(silk_matcher_adds(matcher, "his") == 2);
+    SILK_ASSERT(silk_matcher_adds(matcher, "hers") == 3);
+    SILK_ASSERT(silk_matcher_length(matcher) == 4);
+    SILK_ASSERT(silk_matcher_compile(matcher));
+
+    // the classic example, matches are ordered by their end
+    struct TestMatcherResult result = {0};
+    SILK_ASSERT(silk_matcher_match(matcher, "ushers", 6, test_matcher_collect, &result) == 3);
+    SILK_ASSERT(result.count == 3);
+    SILK_ASSERT(result.patterns[0] == 1 && result.offsets[0] == 1);
+    SILK_ASSERT(result.patterns[1] == 0 && result.offsets[1] == 2);
+    SILK_ASSERT(result.patterns[2] == 3 && result.offsets[2] == 2);
+
+    // patterns added later are compiled on demand
+    SILK_ASSERT(silk_matcher_add(matcher, "s\0h", 3) == 4);
+    memset(&result, 0, sizeof(result));
+    SILK_ASSERT(silk_matcher_match(matcher, "his\0his", 7, test_matcher_collect, &result) == 3);
+    SILK_ASSERT(result.patterns[0] == 2 && result.offsets[0] == 0);
+    SILK_ASSERT(result.patterns[1] == 4 && result.offsets[1] == 2);
+    SILK_ASSERT(result.patterns[2] == 2 && result.offsets[2] == 4);
+
+    // "he", "hers", "she" and "he"
+    silk_string_t str = silk_string_new("a hershey");
+    SILK_ASSERT(silk_matcher_match_string(matcher, str, NULL, NULL) == 4);
+    silk_string_delete(str);
+
+    silk_matcher_clear(matcher);
+    SILK_ASSERT(silk_matcher_length(matcher) == 0);
+    SILK_ASSERT(silk_matcher_match(matcher, "ushers", 6, NULL, NULL) == 0);
+    silk_matcher_delete(matcher);
+}
+
+void test_matcher_overlap()
+{
+    silk_matcher_t matcher = silk_matcher_new();
+    SILK_ASSERT(silk_matcher_adds(matcher, "a") == 0);
+    SILK_ASSERT(silk_matcher_adds(matcher, "aa") == 1);
+    SILK_ASSERT(silk_matcher_adds(matcher, "aaa") == 2);
+    SILK_ASSERT(silk_matcher_adds(matcher, "aa") == 3);
+
+    // 4 of "a", 3 of each "aa" and 2 of "aaa"
+    SILK_ASSERT(silk_matcher_match(matcher, "aaaa", 4, NULL, NULL) == 12);
+
+    // the callback could stop matching
+    struct TestMatcherResult result = {0};
+    char text[64];
+    memset(text, 'a', sizeof(text));
+    SILK_ASSERT(silk_matcher_match(matcher, text, sizeof(text), test_matcher_collect, &result) == 16);
+    silk_matcher_delete(matcher);
+}
+
+void test_matcher_binary()
+{
+    // every byte value is used, so there is no shared class
+    silk_matcher_t matcher = silk_matcher_new();
+    unsigned char data[256];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(255 - i);
+    SILK_ASSERT(silk_matcher_add(matcher, data, sizeof(data)) == 0);
+    SILK_ASSERT(silk_matcher_add(matcher, data + 100, 3) == 1);
+
+    struct TestMatcherResult result = {0};
+    SILK_ASSERT(silk_matcher_match(matcher, data, sizeof(data), test_matcher_collect, &result) == 2);
+    SILK_ASSERT(result.patterns[0] == 1 && result.offsets[0] == 100);
+    SILK_ASSERT(result.patterns[1] == 0 && result.offsets[1] == 0);
+    silk_matcher_delete(matcher);
+}
+
+void test_matcher()
+{
+    test_matcher_new();
+    test_matcher_match();
+    test_matcher_overlap();
+    test_matcher_binary();
+}
\ No newline at end of file
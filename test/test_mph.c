@@ -0,0 +1,153 @@
+#include <silk/log.h>
+#include <silk/mph.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************
+ * @brief determine whether a minimal perfect hash
+ *        function maps the keys to distinct indexes
+ * @param mph the minimal perfect hash function
+ * @param keys the keys
+ * @param count count of keys
+ * @return whether it is a bijection
+ *******************************************************/
+static bool test_mph_bijection(silk_mph_t mph, const silk_mph_key_t* keys, size_t count)
+{
+    bool* seen = silk_alloc(count);
+    SILK_ASSERT(seen != NULL, false);
+    memset(seen, 0, count);
+
+    bool result = true;
+    for (size_t i = 0; i < count && result; i++)
+    {
+        size_t index = silk_mph_get(mph, keys[i].data, keys[i].len);
+        result = index < count && !seen[index];
+        if (result)
+            seen[index] = true;
+    }
+
+    silk_free(seen);
+    return result;
+}
+
+void test_mph_build()
+{
+    size_t counts[] = {1, 2, 3, 10, 100, 1000, 100000};
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        size_t count = counts[c];
+        uint64_t* values = silk_alloc(sizeof(uint64_t) * count);
+        silk_mph_key_t* keys = silk_alloc(sizeof(silk_mph_key_t) * count);
+        SILK_ASSERT(values != NULL && keys != NULL);
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = i * 0x9e3779b97f4a7c15ull;
+            keys[i].data = &values[i];
+            keys[i].len = sizeof(uint64_t);
+        }
+
+        silk_mph_t mph = silk_mph_build(keys, count);
+        SILK_ASSERT(mph != NULL);
+        SILK_ASSERT(silk_mph_count(mph) == count);
+        SILK_ASSERT(test_mph_bijection(mph, keys, count));
+
+        // about 3 bits per key
+        if (count >= 100000)
+            SILK_ASSERT(silk_mph_serialized_size(mph) * 8 < count * 4);
+
+        // other keys still get an index in range
+        for (uint64_t i = 0; i < 1000; i++)
+            SILK_ASSERT(silk_mph_get(mph, &i, sizeof(i) - 1) < count);
+
+        silk_mph_delete(mph);
+        silk_free(keys);
+        silk_free(values);
+    }
+
+    // keys of different lengths
+    char strings[1000][16];
+    silk_mph_key_t keys[1000 + 1];
+    for (size_t i = 0; i < 1000; i++)
+    {
+        snprintf(strings[i], sizeof(strings[i]), "key-%zu", i);
+        keys[i].data = strings[i];
+        keys[i].len = strlen(strings[i]);
+    }
+    keys[1000].data = NULL;
+    keys[1000].len = 0;
+    silk_mph_t mph = silk_mph_build(keys, 1000 + 1);
+    SILK_ASSERT(mph != NULL);
+    SILK_ASSERT(test_mph_bijection(mph, keys, 1000 + 1));
+    silk_mph_delete(mph);
+
+    // duplicated or empty keys
+    keys[1000] = keys[500];
+    SILK_ASSERT(silk_mph_build(keys, 1000 + 1) == NULL);
+    SILK_ASSERT(silk_mph_build(keys, 0) == NULL);
+}
+
+void test_mph_serialize()
+{
+    uint32_t values[1000];
+    silk_mph_key_t keys[1000];
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        values[i] = i;
+        keys[i].data = &values[i];
+        keys[i].len = sizeof(uint32_t);
+    }
+
+    silk_mph_t mph = silk_mph_build(keys, 1000);
+    SILK_ASSERT(mph != NULL);
+
+    size_t size = silk_mph_serialized_size(mph);
+    uint64_t buffer[256];
+    SILK_ASSERT(size + 1 <= sizeof(buffer));
+    SILK_ASSERT(!silk_mph_serialize(mph, buffer, size - 1));
+    SILK_ASSERT(silk_mph_serialize(mph, buffer, size));
+    SILK_ASSERT(memcmp(buffer, "SKMPH001", 8) == 0);
+
+    // invalid data
+    SILK_ASSERT(silk_mph_deserialize(buffer, size - 1) == NULL);
+    SILK_ASSERT(silk_mph_view(buffer, 63) == NULL);
+
+    silk_mph_t copy = silk_mph_deserialize(buffer, size);
+    silk_mph_t view = silk_mph_view(buffer, size);
+    SILK_ASSERT(copy != NULL && view != NULL);
+    SILK_ASSERT(silk_mph_count(copy) == 1000 && silk_mph_count(view) == 1000);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        size_t index = silk_mph_get(mph, &i, sizeof(i));
+        SILK_ASSERT(silk_mph_get(copy, &i, sizeof(i)) == index);
+        SILK_ASSERT(silk_mph_get(view, &i, sizeof(i)) == index);
+    }
+    silk_mph_delete(view);
+    silk_mph_delete(copy);
+
+    // a view of unaligned data is copied
+    uint8_t* unaligned = (uint8_t*)buffer + 1;
+    memmove(unaligned, buffer, size);
+    view = silk_mph_view(unaligned, size);
+    SILK_ASSERT(view != NULL);
+    SILK_ASSERT(test_mph_bijection(view, keys, 1000));
+    silk_mph_delete(view);
+
+    // a remapped slot out of range
+    memmove(buffer, unaligned, size);
+    uint8_t* bytes = (uint8_t*)buffer;
+    memset(bytes + size - 4, 0xff, 4);
+    SILK_ASSERT(silk_mph_deserialize(buffer, size) == NULL);
+
+    // a bad width
+    bytes[48] = 0;
+    SILK_ASSERT(silk_mph_view(buffer, size) == NULL);
+
+    silk_mph_delete(mph);
+}
+
+void test_mph()
+{
+    test_mph_build();
+    test_mph_serialize();
+}
\ No newline at end of file
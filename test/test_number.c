@@ -0,0 +1,105 @@
+#include <silk/log.h>
+#include <silk/number.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+void test_number_format_int()
+{
+    char buffer[SILK_NUMBER_INT_BUFFER_SIZE];
+    const int64_t values[] = {0, 9, -7, 10, 99, 100, -1234567890123LL, INT64_MIN, INT64_MAX};
+    const char* texts[] = {"0", "9", "-7", "10", "99", "100", "-1234567890123", "-9223372036854775808", "9223372036854775807"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        size_t length = silk_number_format_int64(buffer, values[i]);
+        SILK_ASSERT(length == strlen(texts[i]));
+        SILK_ASSERT(memcmp(buffer, texts[i], length) == 0);
+    }
+
+    size_t length = silk_number_format_uint64(buffer, UINT64_MAX);
+    SILK_ASSERT(length == 20);
+    SILK_ASSERT(memcmp(buffer, "18446744073709551615", length) == 0);
+    SILK_ASSERT(silk_number_format_uint64(buffer, 0) == 1 && buffer[0] == '0');
+
+    // every length from 1 to 20 digits reads back
+    uint64_t value = 1;
+    for (int i = 0; i < 20; i++, value = value * 10 + 1)
+    {
+        uint64_t parsed = 0;
+        length = silk_number_format_uint64(buffer, value);
+        SILK_ASSERT(length == (size_t)i + 1);
+        SILK_ASSERT(silk_number_parse_uint64(buffer, length, &parsed) && parsed == value);
+    }
+}
+
+void test_number_format_double()
+{
+    char buffer[SILK_NUMBER_DOUBLE_BUFFER_SIZE];
+    const double values[] = {0.0, -0.0, 1.0, -2.5, 0.001, 123456789012345.0, 1e16, 1e-5, 2.2250738585072014e-308, -1.7976931348623157e308};
+    const char* texts[] = {"0", "-0", "1", "-2.5", "0.001", "123456789012345", "1e+16", "1e-05", "2.2250738585072014e-308", "-1.7976931348623157e+308"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        size_t length = silk_number_format_double(buffer, values[i]);
+        SILK_ASSERT(length == strlen(texts[i]));
+        SILK_ASSERT(memcmp(buffer, texts[i], length) == 0);
+    }
+
+    // round trip of values spread over the whole range
+    uint64_t bits = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 10000; i++)
+    {
+        bits = bits * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (value != value)
+            continue;
+
+        double parsed = 0.0;
+        size_t length = silk_number_format_double(buffer, value);
+        SILK_ASSERT(length <= sizeof(buffer));
+        SILK_ASSERT(silk_number_parse_double(buffer, length, &parsed));
+        SILK_ASSERT(memcmp(&parsed, &value, sizeof(value)) == 0);
+    }
+}
+
+void test_number_parse()
+{
+    int64_t i64 = 0;
+    SILK_ASSERT(silk_number_parse_int64("0000000000000000000000042", 25, &i64) && i64 == 42);
+    SILK_ASSERT(silk_number_parse_int64("-12345678", 9, &i64) && i64 == -12345678);
+    SILK_ASSERT(!silk_number_parse_int64("-9223372036854775809", 20, &i64));
+    SILK_ASSERT(!silk_number_parse_int64("1234567a", 8, &i64));
+    SILK_ASSERT(!silk_number_parse_int64("", 0, &i64));
+    SILK_ASSERT(!silk_number_parse_int64(NULL, 0, &i64));
+
+    uint64_t u64 = 0;
+    SILK_ASSERT(silk_number_parse_uint64("+0", 2, &u64) && u64 == 0);
+    SILK_ASSERT(!silk_number_parse_uint64("+", 1, &u64));
+    SILK_ASSERT(!silk_number_parse_uint64("99999999999999999999", 20, &u64));
+
+    // halfway cases and long significands go to the slow path
+    const char* texts[] = {"9007199254740993", "2.2250738585072012e-308", "4.9406564584124654e-324", "1e-400",
+                           "0.000000000000000000000000000000000000001", "1.00000000000000011102230246251565404236316680908203125",
+                           "179769313486231580793728971405301e276", "-0.0"};
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+    {
+        double value = 0.0;
+        double expected = strtod(texts[i], NULL);
+        SILK_ASSERT(silk_number_parse_double(texts[i], strlen(texts[i]), &value));
+        SILK_ASSERT(memcmp(&value, &expected, sizeof(value)) == 0);
+    }
+
+    double value = 0.0;
+    SILK_ASSERT(silk_number_parse_double("INF", 3, &value) && value > 0 && value * 0 != 0);
+    SILK_ASSERT(!silk_number_parse_double("infinit", 7, &value));
+    SILK_ASSERT(!silk_number_parse_double("1e+", 3, &value));
+    SILK_ASSERT(!silk_number_parse_double("1 ", 2, &value));
+    SILK_ASSERT(!silk_number_parse_double("", 0, &value));
+}
+
+void test_number()
+{
+    test_number_format_int();
+    test_number_format_double();
+    test_number_parse();
+}
\ No newline at end of file
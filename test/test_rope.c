@@ -0,0 +1,181 @@
+#include <silk/log.h>
+#include <silk/rope.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define N 4096
+
+void test_rope_new()
+{
+    silk_rope_t rope = silk_rope_new(NULL);
+    SILK_ASSERT(silk_rope_length(rope) == 0);
+    silk_rope_delete(rope);
+
+    const char* cstr = "hello world";
+    rope = silk_rope_new(cstr);
+    SILK_ASSERT(silk_rope_length(rope) == strlen(cstr));
+    for (size_t i = 0; i < strlen(cstr); i++)
+    {
+        SILK_ASSERT(silk_rope_at(rope, i) == cstr[i]);
+    }
+
+    silk_string_t str = silk_rope_to_string(rope);
+    SILK_ASSERT(strcmp(silk_string_get(str), cstr) == 0);
+    silk_string_delete(str);
+
+    silk_rope_clear(rope);
+    SILK_ASSERT(silk_rope_length(rope) == 0);
+    silk_rope_delete(rope);
+}
+
+void test_rope_insert()
+{
+    silk_rope_t rope = silk_rope_new("hello world");
+    SILK_ASSERT(silk_rope_insert(rope, 6, ' '));
+    SILK_ASSERT(silk_rope_insert(rope, 6, 'k'));
+    SILK_ASSERT(silk_rope_inserts(rope, 6, "sil"));
+    SILK_ASSERT(silk_rope_appends(rope, "!!"));
+    SILK_ASSERT(silk_rope_append(rope, '!'));
+    SILK_ASSERT(silk_rope_inserts(rope, 0, ">> "));
+
+    silk_string_t str = silk_rope_to_string(rope);
+    SILK_ASSERT(strcmp(silk_string_get(str), ">> hello silk world!!!") == 0);
+    silk_string_delete(str);
+    silk_rope_delete(rope);
+}
+
+void test_rope_remove()
+{
+    silk_rope_t rope = silk_rope_new("test_rope_removes");
+    SILK_ASSERT(silk_rope_removes(rope, 4, 5));
+    SILK_ASSERT(silk_rope_remove(rope, 0));
+    SILK_ASSERT(silk_rope_removes(rope, 0, 0));
+
+    silk_string_t str = silk_rope_to_string(rope);
+    SILK_ASSERT(strcmp(silk_string_get(str), "est_removes") == 0);
+    silk_string_delete(str);
+
+    SILK_ASSERT(silk_rope_removes(rope, 0, silk_rope_length(rope)));
+    SILK_ASSERT(silk_rope_length(rope) == 0);
+    silk_rope_delete(rope);
+}
+
+void test_rope_concat()
+{
+    silk_rope_t rope1 = silk_rope_new("hello ");
+    silk_rope_t rope2 = silk_rope_new("world");
+    SILK_ASSERT(silk_rope_concat(rope1, rope2));
+    SILK_ASSERT(silk_rope_length(rope2) == 0);
+
+    silk_string_t str = silk_rope_to_string(rope1);
+    SILK_ASSERT(strcmp(silk_string_get(str), "hello world") == 0);
+    silk_string_delete(str);
+
+    silk_rope_delete(rope1);
+    silk_rope_delete(rope2);
+}
+
+static size_t test_rope_allocs = 0;
+
+static void* test_rope_count_alloc(size_t bytes)
+{
+    test_rope_allocs++;
+    return malloc(bytes);
+}
+
+void test_rope_fill()
+{
+    // appending in pieces fills up the last chunk before a new one is allocated
+    char piece[1024];
+    memset(piece, 'x', sizeof(piece));
+    silk_rope_t rope = silk_rope_new(NULL);
+    silk_alloc_t old = silk_set_alloc_func(test_rope_count_alloc);
+    for (int i = 0; i < 1024; i++)
+    {
+        piece[0] = (char)('a' + i % 26);
+        SILK_ASSERT(silk_rope_insertn(rope, silk_rope_length(rope), piece, sizeof(piece)));
+    }
+    silk_set_alloc_func(old);
+    // a chunk for each piece, one more for the first, and the spare nodes of split
+    SILK_ASSERT(test_rope_allocs <= 1024 + 3);
+
+    SILK_ASSERT(silk_rope_length(rope) == 1024 * sizeof(piece));
+    for (int i = 0; i < 1024; i++)
+    {
+        SILK_ASSERT(silk_rope_at(rope, (size_t)i * sizeof(piece)) == 'a' + i % 26);
+        SILK_ASSERT(silk_rope_at(rope, (size_t)i * sizeof(piece) + 1) == 'x');
+    }
+
+    // a piece larger than the room of a chunk in the middle is split around it
+    silk_rope_delete(rope);
+    rope = silk_rope_new("hello world");
+    memset(piece, 'x', sizeof(piece));
+    SILK_ASSERT(silk_rope_insertn(rope, 6, piece, sizeof(piece)));
+    SILK_ASSERT(silk_rope_length(rope) == 11 + sizeof(piece));
+    silk_string_t str = silk_rope_to_string(rope);
+    SILK_ASSERT(memcmp(silk_string_get(str), "hello ", 6) == 0);
+    SILK_ASSERT(memcmp(silk_string_get(str) + 6, piece, sizeof(piece)) == 0);
+    SILK_ASSERT(strcmp(silk_string_get(str) + 6 + sizeof(piece), "world") == 0);
+    silk_string_delete(str);
+    silk_rope_delete(rope);
+}
+
+void test_rope_random()
+{
+    // compare with a flat buffer
+    static char text[N * 256];
+    size_t length = 0;
+    char piece[3000];
+    silk_rope_t rope = silk_rope_new(NULL);
+
+    srand(0);
+    for (int i = 0; i < N; i++)
+    {
+        size_t index = length == 0 ? 0 : (size_t)rand() % (length + 1);
+        if (rand() % 3 != 0 || length == 0)
+        {
+            size_t len = (size_t)rand() % (rand() % 8 == 0 ? sizeof(piece) : 16);
+            for (size_t j = 0; j < len; j++)
+                piece[j] = (char)('a' + rand() % 26);
+
+            SILK_ASSERT(silk_rope_insertn(rope, index, piece, len));
+            memmove(text + index + len, text + index, length - index);
+            memcpy(text + index, piece, len);
+            length += len;
+        }
+        else
+        {
+            size_t len = (size_t)rand() % (rand() % 8 == 0 ? 2000 : 16);
+            if (len > length - index)
+                len = length - index;
+
+            SILK_ASSERT(silk_rope_removes(rope, index, len));
+            memmove(text + index, text + index + len, length - index - len);
+            length -= len;
+        }
+
+        SILK_ASSERT(silk_rope_length(rope) == length);
+        if (length > 0)
+        {
+            size_t probe = (size_t)rand() % length;
+            SILK_ASSERT(silk_rope_at(rope, probe) == text[probe]);
+        }
+    }
+
+    silk_string_t str = silk_rope_to_string(rope);
+    SILK_ASSERT(silk_string_length(str) == length);
+    SILK_ASSERT(memcmp(silk_string_get(str), text, length) == 0);
+    silk_string_delete(str);
+    silk_rope_delete(rope);
+}
+
+void test_rope()
+{
+    test_rope_new();
+    test_rope_insert();
+    test_rope_remove();
+    test_rope_concat();
+    test_rope_fill();
+    test_rope_random();
+}
\ No newline at end of file
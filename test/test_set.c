@@ -0,0 +1,168 @@
+#include <silk/log.h>
+#include <silk/set.h>
+#include <silk/intern.h>
+
+#include <string.h>
+
+/*******************************************************
+ * @brief sum elements of a set
+ * @param data the sum
+ * @param element an element
+ *******************************************************/
+static void test_set_sum(void* data, void* element)
+{
+    *(uint64_t*)data += *(const uint32_t*)element;
+}
+
+void test_set_insert()
+{
+    silk_set_t set = silk_set_new(sizeof(uint32_t));
+    SILK_ASSERT(set != NULL);
+    SILK_ASSERT(silk_set_element_size(set) == sizeof(uint32_t));
+    SILK_ASSERT(silk_set_length(set) == 0);
+
+    for (uint32_t i = 0; i < 10000; i++)
+        SILK_ASSERT(silk_set_insert(set, &i));
+    for (uint32_t i = 0; i < 10000; i += 2)
+        SILK_ASSERT(silk_set_insert(set, &i));
+    SILK_ASSERT(silk_set_length(set) == 10000);
+
+    for (uint32_t i = 0; i < 20000; i++)
+        SILK_ASSERT(silk_set_contains(set, &i) == (i < 10000));
+
+    // removed slots are reused, and dropped by rehashing
+    for (uint32_t i = 0; i < 10000; i += 2)
+        SILK_ASSERT(silk_set_remove(set, &i));
+    SILK_ASSERT(!silk_set_remove(set, &(uint32_t){0}));
+    SILK_ASSERT(silk_set_length(set) == 5000);
+    for (uint32_t round = 0; round < 10; round++)
+    {
+        for (uint32_t i = 20000; i < 25000; i++)
+            SILK_ASSERT(silk_set_insert(set, &i));
+        for (uint32_t i = 20000; i < 25000; i++)
+            SILK_ASSERT(silk_set_remove(set, &i));
+    }
+    for (uint32_t i = 0; i < 10000; i++)
+        SILK_ASSERT(silk_set_contains(set, &i) == (i % 2 == 1));
+
+    uint64_t sum = 0;
+    SILK_ASSERT(silk_set_reduce(set, test_set_sum, &sum));
+    SILK_ASSERT(sum == 5000ull * 5000);
+
+    silk_vector_t vector = silk_set_to_vector(set);
+    SILK_ASSERT(vector != NULL);
+    SILK_ASSERT(silk_vector_length(vector) == 5000);
+    const uint32_t* elements = silk_vector_const_data(vector);
+    for (size_t i = 0; i < 5000; i++)
+        SILK_ASSERT(elements[i] % 2 == 1 && elements[i] < 10000);
+    silk_vector_delete(vector);
+
+    silk_set_clear(set);
+    SILK_ASSERT(silk_set_length(set) == 0);
+    SILK_ASSERT(!silk_set_contains(set, &(uint32_t){1}));
+
+    // bulk insert, with duplicates in the array
+    uint32_t values[3000];
+    for (uint32_t i = 0; i < 3000; i++)
+        values[i] = i % 1000;
+    SILK_ASSERT(silk_set_reserve(set, 1000));
+    SILK_ASSERT(silk_set_insert_bulk(set, values, 3000));
+    SILK_ASSERT(silk_set_length(set) == 1000);
+    SILK_ASSERT(silk_set_insert_bulk(set, NULL, 0));
+    for (uint32_t i = 0; i < 2000; i++)
+        SILK_ASSERT(silk_set_contains(set, &i) == (i < 1000));
+
+    silk_set_delete(set);
+}
+
+void test_set_operation()
+{
+    // x is multiples of 2, y is multiples of 3
+    silk_set_t x = silk_set_new(sizeof(uint64_t));
+    silk_set_t y = silk_set_new(sizeof(uint64_t));
+    SILK_ASSERT(x != NULL && y != NULL);
+    for (uint64_t i = 0; i < 60000; i++)
+    {
+        if (i % 2 == 0)
+            SILK_ASSERT(silk_set_insert(x, &i));
+        if (i % 3 == 0)
+            SILK_ASSERT(silk_set_insert(y, &i));
+    }
+
+    silk_set_t u = silk_set_union(x, y);
+    silk_set_t n = silk_set_intersect(x, y);
+    silk_set_t d = silk_set_difference(x, y);
+    silk_set_t e = silk_set_difference(y, x);
+    SILK_ASSERT(u != NULL && n != NULL && d != NULL && e != NULL);
+    SILK_ASSERT(silk_set_length(u) == 40000);
+    SILK_ASSERT(silk_set_length(n) == 10000);
+    SILK_ASSERT(silk_set_length(d) == 20000);
+    SILK_ASSERT(silk_set_length(e) == 10000);
+
+    for (uint64_t i = 0; i < 60000; i++)
+    {
+        bool a = i % 2 == 0;
+        bool b = i % 3 == 0;
+        SILK_ASSERT(silk_set_contains(u, &i) == (a || b));
+        SILK_ASSERT(silk_set_contains(n, &i) == (a && b));
+        SILK_ASSERT(silk_set_contains(d, &i) == (a && !b));
+        SILK_ASSERT(silk_set_contains(e, &i) == (b && !a));
+    }
+    silk_set_delete(u);
+    silk_set_delete(n);
+    silk_set_delete(d);
+    silk_set_delete(e);
+
+    // with an empty set
+    silk_set_t empty = silk_set_new(sizeof(uint64_t));
+    SILK_ASSERT(empty != NULL);
+    u = silk_set_union(empty, x);
+    n = silk_set_intersect(x, empty);
+    d = silk_set_difference(x, empty);
+    SILK_ASSERT(silk_set_length(u) == 30000 && silk_set_length(n) == 0 && silk_set_length(d) == 30000);
+    silk_set_delete(u);
+    silk_set_delete(n);
+    silk_set_delete(d);
+
+    silk_set_delete(empty);
+    silk_set_delete(y);
+    silk_set_delete(x);
+}
+
+void test_set_string()
+{
+    // strings are stored as handles of an intern pool
+    silk_intern_t intern = silk_intern_new();
+    silk_set_t x = silk_set_new(sizeof(size_t));
+    silk_set_t y = silk_set_new(sizeof(size_t));
+    SILK_ASSERT(intern != NULL && x != NULL && y != NULL);
+
+    const char* fruits[] = {"apple", "banana", "cherry"};
+    const char* colors[] = {"red", "yellow", "cherry"};
+    for (size_t i = 0; i < 3; i++)
+    {
+        size_t handle = silk_intern_puts(intern, fruits[i]);
+        SILK_ASSERT(silk_set_insert(x, &handle));
+        handle = silk_intern_puts(intern, colors[i]);
+        SILK_ASSERT(silk_set_insert(y, &handle));
+    }
+
+    silk_set_t n = silk_set_intersect(x, y);
+    SILK_ASSERT(n != NULL && silk_set_length(n) == 1);
+    silk_vector_t vector = silk_set_to_vector(n);
+    size_t handle = *(const size_t*)silk_vector_const_data(vector);
+    SILK_ASSERT(strcmp(silk_intern_get(intern, handle), "cherry") == 0);
+
+    silk_vector_delete(vector);
+    silk_set_delete(n);
+    silk_set_delete(y);
+    silk_set_delete(x);
+    silk_intern_delete(intern);
+}
+
+void test_set()
+{
+    test_set_insert();
+    test_set_operation();
+    test_set_string();
+}
\ No newline at end of file
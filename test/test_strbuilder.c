@@ -0,0 +1,129 @@
+#include <silk/log.h>
+#include <silk/strbuilder.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <fcntl.h>
+    #include <io.h>
+    #define fileno _fileno
+    #define close _close
+#else
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
+void test_strbuilder_new()
+{
+    silk_strbuilder_t builder = silk_strbuilder_new();
+    SILK_ASSERT(builder != NULL);
+    SILK_ASSERT(silk_strbuilder_length(builder) == 0);
+
+    silk_string_t str = silk_strbuilder_to_string(builder);
+    SILK_ASSERT(silk_string_length(str) == 0);
+    SILK_ASSERT(strcmp(silk_string_get(str), "") == 0);
+    silk_string_delete(str);
+    silk_strbuilder_delete(builder);
+}
+
+void test_strbuilder_append()
+{
+    silk_strbuilder_t builder = silk_strbuilder_new();
+    silk_string_t expected = silk_string_new(NULL);
+
+    // small pieces across chunks, large pieces and formatted pieces
+    char large[10000];
+    memset(large, 'x', sizeof(large));
+    for (int i = 0; i < 2000; i++)
+    {
+        SILK_ASSERT(silk_strbuilder_appends(builder, "hello, "));
+        SILK_ASSERT(silk_string_appends(expected, "hello, "));
+        SILK_ASSERT(silk_strbuilder_append(builder, (char)('a' + i % 26)));
+        SILK_ASSERT(silk_string_append(expected, (char)('a' + i % 26)));
+        SILK_ASSERT(silk_strbuilder_appendf(builder, "[%d]", i));
+        SILK_ASSERT(silk_string_appendf(expected, "[%d]", i));
+        if (i % 500 == 0)
+        {
+            SILK_ASSERT(silk_strbuilder_appendn(builder, large, sizeof(large) - (size_t)i));
+            SILK_ASSERT(silk_string_appendn(expected, large, sizeof(large) - (size_t)i));
+            SILK_ASSERT(silk_strbuilder_appendf(builder, "%.*s", 5000, large));
+            SILK_ASSERT(silk_string_appendf(expected, "%.*s", 5000, large));
+        }
+    }
+    SILK_ASSERT(silk_strbuilder_appendn(builder, "\0!", 2));
+    SILK_ASSERT(silk_string_appendn(expected, "\0!", 2));
+
+    SILK_ASSERT(silk_strbuilder_length(builder) == silk_string_length(expected));
+    silk_string_t str = silk_strbuilder_to_string(builder);
+    SILK_ASSERT(silk_string_equal(str, expected));
+    silk_string_delete(str);
+
+    silk_strbuilder_clear(builder);
+    SILK_ASSERT(silk_strbuilder_length(builder) == 0);
+    SILK_ASSERT(silk_strbuilder_appends(builder, "reused"));
+    SILK_ASSERT(silk_strbuilder_appends(builder, NULL));
+    SILK_ASSERT(silk_strbuilder_length(builder) == 6);
+    str = silk_strbuilder_to_string(builder);
+    SILK_ASSERT(strcmp(silk_string_get(str), "reused") == 0);
+
+    silk_string_delete(str);
+    silk_string_delete(expected);
+    silk_strbuilder_delete(builder);
+}
+
+void test_strbuilder_write()
+{
+    silk_strbuilder_t builder = silk_strbuilder_new();
+    for (int i = 0; i < 50000; i++)
+    {
+        SILK_ASSERT(silk_strbuilder_appendf(builder, "line %d\n", i));
+    }
+
+    FILE* fp = tmpfile();
+    SILK_ASSERT(fp != NULL);
+    SILK_ASSERT(silk_strbuilder_write(builder, fileno(fp)));
+
+    silk_string_t str = silk_strbuilder_to_string(builder);
+    size_t length = silk_string_length(str);
+    char* buffer = silk_alloc(length + 1);
+    SILK_ASSERT(fseek(fp, 0, SEEK_SET) == 0);
+    SILK_ASSERT(fread(buffer, 1, length + 1, fp) == length);
+    SILK_ASSERT(memcmp(buffer, silk_string_get(str), length) == 0);
+
+    silk_free(buffer);
+    fclose(fp);
+    silk_string_delete(str);
+    silk_strbuilder_delete(builder);
+}
+
+void test_strbuilder_write_fail()
+{
+    silk_strbuilder_t builder = silk_strbuilder_new();
+    SILK_ASSERT(silk_strbuilder_appends(builder, "lost"));
+
+    // the read end is closed, it is a runtime error rather than an assertion
+    int fds[2];
+#if defined(_WIN32)
+    SILK_ASSERT(_pipe(fds, 4096, _O_BINARY) == 0);
+#else
+    void (*handler)(int) = signal(SIGPIPE, SIG_IGN);
+    SILK_ASSERT(pipe(fds) == 0);
+#endif
+    close(fds[0]);
+    SILK_ASSERT(!silk_strbuilder_write(builder, fds[1]));
+    close(fds[1]);
+#if !defined(_WIN32)
+    signal(SIGPIPE, handler);
+#endif
+
+    silk_strbuilder_delete(builder);
+}
+
+void test_strbuilder()
+{
+    test_strbuilder_new();
+    test_strbuilder_append();
+    test_strbuilder_write();
+    test_strbuilder_write_fail();
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include <silk/log.h>
 #include <silk/string.h>
+#include <silk/cpu.h>
+#include <silk/hash.h>
 
+#include <stdlib.h>
 #include <string.h>
+#include <wchar.h>
 
 void test_string_new()
 {
@@ -57,6 +61,67 @@ void test_string_copy()
     silk_string_delete(str);
 }
 
+void test_string_equal()
+{
+    silk_string_t str1 = silk_string_new("hello world");
+    silk_string_t str2 = silk_string_new("hello world");
+    silk_string_t str3 = silk_string_new("hello silk");
+    silk_string_t str4 = silk_string_new("hello worle");
+
+    SILK_ASSERT(silk_string_equal(str1, str1));
+    SILK_ASSERT(silk_string_equal(str1, str2));
+    SILK_ASSERT(!silk_string_equal(str1, str3));
+    SILK_ASSERT(!silk_string_equal(str1, str4));
+
+    // with cached hash
+    SILK_ASSERT(silk_string_hash(str1) == silk_string_hash(str2));
+    SILK_ASSERT(silk_string_hash(str1) != silk_string_hash(str4));
+    SILK_ASSERT(silk_string_equal(str1, str2));
+    SILK_ASSERT(!silk_string_equal(str1, str4));
+
+    silk_string_delete(str1);
+    silk_string_delete(str2);
+    silk_string_delete(str3);
+    silk_string_delete(str4);
+}
+
+void test_string_hash()
+{
+    const char* cstr = "helloworld";
+    silk_string_t str = silk_string_new(cstr);
+    SILK_ASSERT(silk_string_hash(str) == silk_hash_murmur3_32(cstr, strlen(cstr), 0));
+    SILK_ASSERT(silk_string_hash(str) == 2687965642);
+
+    // cached hash is dropped by modifications
+    SILK_ASSERT(silk_string_append(str, '!'));
+    SILK_ASSERT(silk_string_hash(str) == silk_hash_murmur3_32("helloworld!", 11, 0));
+    SILK_ASSERT(silk_string_remove(str, 10));
+    SILK_ASSERT(silk_string_hash(str) == 2687965642);
+    SILK_ASSERT(silk_string_inserts(str, 5, " "));
+    SILK_ASSERT(silk_string_hash(str) == silk_hash_murmur3_32("hello world", 11, 0));
+    silk_string_data(str)[0] = 'H';
+    SILK_ASSERT(silk_string_hash(str) == silk_hash_murmur3_32("Hello world", 11, 0));
+    SILK_ASSERT(silk_string_set(str, cstr));
+    SILK_ASSERT(silk_string_hash(str) == 2687965642);
+    silk_string_clear(str);
+    SILK_ASSERT(silk_string_hash(str) == silk_hash_murmur3_32("", 0, 0));
+    silk_string_delete(str);
+
+    // writes after hashing need a fresh pointer to drop the cached hash
+    str = silk_string_new("abc");
+    silk_string_t other = silk_string_new("xbc");
+    silk_string_hash(other);
+    char* p = silk_string_data(str);
+    silk_string_hash(str);
+    p = silk_string_data(str);
+    p[0] = 'x';
+    SILK_ASSERT(silk_string_equal(str, other));
+    SILK_ASSERT(silk_string_hash(str) == silk_string_hash(other));
+
+    silk_string_delete(other);
+    silk_string_delete(str);
+}
+
 void test_string_clear()
 {
     const char* cstr = "hello world";
@@ -130,6 +195,18 @@ void test_string_appends()
     silk_string_delete(str);
 }
 
+void test_string_appendn()
+{
+    silk_string_t str = silk_string_new(NULL);
+    SILK_ASSERT(silk_string_reserve(str, 64));
+    SILK_ASSERT(silk_string_appendn(str, "hello world", 5));
+    SILK_ASSERT(silk_string_appendn(str, NULL, 0));
+    SILK_ASSERT(silk_string_appendn(str, " silk", 5));
+    SILK_ASSERT(silk_string_length(str) == 10);
+    SILK_ASSERT(strcmp(silk_string_get(str), "hello silk") == 0);
+    silk_string_delete(str);
+}
+
 void test_string_remove()
 {
     silk_string_t str = silk_string_new("hello world");
@@ -149,17 +226,261 @@ void test_string_removes()
     silk_string_delete(str);
 }
 
+void test_string_appendf()
+{
+    silk_string_t str = silk_string_new("id=");
+    SILK_ASSERT(silk_string_appendf(str, "%d, name=%s", 42, "silk"));
+    SILK_ASSERT(strcmp(silk_string_get(str), "id=42, name=silk") == 0);
+    SILK_ASSERT(silk_string_appendf(str, "%s", ""));
+    SILK_ASSERT(silk_string_length(str) == 16);
+
+    // grow while formatting
+    char buffer[4096];
+    memset(buffer, 'x', sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    SILK_ASSERT(silk_string_appendf(str, "[%s]", buffer));
+    SILK_ASSERT(silk_string_length(str) == 16 + 2 + sizeof(buffer) - 1);
+    SILK_ASSERT(silk_string_at(str, 16) == '[');
+    SILK_ASSERT(silk_string_at(str, silk_string_length(str) - 1) == ']');
+    SILK_ASSERT(silk_string_get(str)[silk_string_length(str)] == '\0');
+
+    // a wide character which could not be converted in the "C" locale fails at runtime
+    size_t length = silk_string_length(str);
+    SILK_ASSERT(!silk_string_appendf(str, "%ls", L"\x4E2D"));
+    SILK_ASSERT(silk_string_length(str) == length);
+    SILK_ASSERT(silk_string_get(str)[length] == '\0');
+
+    silk_string_delete(str);
+}
+
+void test_string_append_number()
+{
+    silk_string_t str = silk_string_new(NULL);
+    SILK_ASSERT(silk_string_append_int64(str, 0));
+    SILK_ASSERT(silk_string_append(str, ' '));
+    SILK_ASSERT(silk_string_append_int64(str, -7));
+    SILK_ASSERT(silk_string_append(str, ' '));
+    SILK_ASSERT(silk_string_append_int64(str, 1234567890123LL));
+    SILK_ASSERT(silk_string_append(str, ' '));
+    SILK_ASSERT(silk_string_append_int64(str, INT64_MIN));
+    SILK_ASSERT(silk_string_append(str, ' '));
+    SILK_ASSERT(silk_string_append_int64(str, INT64_MAX));
+    SILK_ASSERT(silk_string_append(str, ' '));
+    SILK_ASSERT(silk_string_append_uint64(str, UINT64_MAX));
+    SILK_ASSERT(strcmp(silk_string_get(str), "0 -7 1234567890123 -9223372036854775808 9223372036854775807 18446744073709551615") == 0);
+
+    silk_string_clear(str);
+    const double values[] = {0.0, 1.0, -2.5, 0.1, 0.3, 1.0 / 3, 100.0, 1e21, 1.5e-7, 5e-324, 1.7976931348623157e308};
+    const char* texts[] = {"0", "1", "-2.5", "0.1", "0.3", "0.3333333333333333", "100", "1e+21", "1.5e-07", "5e-324", "1.7976931348623157e+308"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        silk_string_clear(str);
+        SILK_ASSERT(silk_string_append_double(str, values[i]));
+        SILK_ASSERT(strcmp(silk_string_get(str), texts[i]) == 0);
+    }
+
+    volatile double zero = 0.0;
+    silk_string_clear(str);
+    SILK_ASSERT(silk_string_append_double(str, -1.0 / zero));
+    SILK_ASSERT(strcmp(silk_string_get(str), "-inf") == 0);
+
+    silk_string_delete(str);
+}
+
+void test_string_to_number()
+{
+    int64_t i64 = 0;
+    SILK_ASSERT(silk_string_to_int64("-123", 4, &i64) && i64 == -123);
+    SILK_ASSERT(silk_string_to_int64("+1234567890123", 14, &i64) && i64 == 1234567890123LL);
+    SILK_ASSERT(silk_string_to_int64("-9223372036854775808", 20, &i64) && i64 == INT64_MIN);
+    SILK_ASSERT(silk_string_to_int64("9223372036854775807", 19, &i64) && i64 == INT64_MAX);
+    SILK_ASSERT(!silk_string_to_int64("9223372036854775808", 19, &i64));
+    SILK_ASSERT(!silk_string_to_int64("12a", 3, &i64));
+    SILK_ASSERT(!silk_string_to_int64("-", 1, &i64));
+    SILK_ASSERT(silk_string_to_int64("42 is not parsed", 2, &i64) && i64 == 42);
+
+    uint64_t u64 = 0;
+    SILK_ASSERT(silk_string_to_uint64("18446744073709551615", 20, &u64) && u64 == UINT64_MAX);
+    SILK_ASSERT(!silk_string_to_uint64("18446744073709551616", 20, &u64));
+    SILK_ASSERT(!silk_string_to_uint64("-1", 2, &u64));
+
+    const char* texts[] = {"0", "-2.5", "0.1", "1e23", ".5", "5.", "1.7976931348623157e308", "5e-324", 
+                           "2.2250738585072011e-308", "123456789012345678901234567890", "1e400"};
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+    {
+        double value = 0.0;
+        SILK_ASSERT(silk_string_to_double(texts[i], strlen(texts[i]), &value));
+        SILK_ASSERT(value == strtod(texts[i], NULL));
+    }
+
+    double value = 0.0;
+    SILK_ASSERT(silk_string_to_double("-Infinity", 9, &value) && value < 0 && value * 0 != 0);
+    SILK_ASSERT(silk_string_to_double("nan", 3, &value) && value != value);
+    SILK_ASSERT(!silk_string_to_double("1e", 2, &value));
+    SILK_ASSERT(!silk_string_to_double(".", 1, &value));
+    SILK_ASSERT(!silk_string_to_double("1.2.3", 5, &value));
+
+    // round trip with silk_string_append_double
+    silk_string_t str = silk_string_new(NULL);
+    const double values[] = {0.1, 1.0 / 3, 1e21, 1.5e-7, 5e-324, 1.7976931348623157e308};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        silk_string_clear(str);
+        SILK_ASSERT(silk_string_append_double(str, values[i]));
+        SILK_ASSERT(silk_string_to_double(silk_string_get(str), silk_string_length(str), &value));
+        SILK_ASSERT(value == values[i]);
+    }
+    silk_string_delete(str);
+}
+
+void test_string_utf8()
+{
+    silk_string_t str = silk_string_new("\xE4\xBD\xA0\xE5\xA5\xBD, world");
+    SILK_ASSERT(silk_string_length(str) == 13);
+    SILK_ASSERT(silk_string_utf8_length(str) == 9);
+    SILK_ASSERT(silk_string_utf8_validate(str));
+
+    SILK_ASSERT(silk_string_append(str, (char)0xE4));
+    SILK_ASSERT(!silk_string_utf8_validate(str));
+
+    silk_string_clear(str);
+    SILK_ASSERT(silk_string_utf8_validate(str));
+    SILK_ASSERT(silk_string_utf8_length(str) == 0);
+    silk_string_delete(str);
+}
+
+void test_string_case()
+{
+    // letters next to the boundaries of ranges and non-ascii bytes
+    const char* mixed = "@AZ[`az{ Hello, World! \xC3\x80\xE1\xFA 0123456789 Content-Type";
+    const char* lower = "@az[`az{ hello, world! \xC3\x80\xE1\xFA 0123456789 content-type";
+    const char* upper = "@AZ[`AZ{ HELLO, WORLD! \xC3\x80\xE1\xFA 0123456789 CONTENT-TYPE";
+
+    // scalar and SSE2 paths
+    const uint32_t features[] = {0, UINT32_MAX};
+    for (size_t k = 0; k < sizeof(features) / sizeof(features[0]); k++)
+    {
+        uint32_t old = silk_cpu_set_features(features[k]);
+        silk_string_t str1 = silk_string_new(mixed);
+        silk_string_t str2 = silk_string_new(mixed);
+
+        silk_string_to_lower(str1);
+        SILK_ASSERT(strcmp(silk_string_get(str1), lower) == 0);
+        silk_string_to_upper(str2);
+        SILK_ASSERT(strcmp(silk_string_get(str2), upper) == 0);
+
+        SILK_ASSERT(silk_string_equal_nocase(str1, str2));
+        SILK_ASSERT(silk_string_compare_nocase(str1, str2) == 0);
+        SILK_ASSERT(!silk_string_equal(str1, str2));
+
+        // letters are compared as lowercase, so '[' is less than 'Z'
+        SILK_ASSERT(silk_string_set(str1, "abcdefghijklmnopqrstuvwxyZ"));
+        SILK_ASSERT(silk_string_set(str2, "ABCDEFGHIJKLMNOPQRSTUVWXY["));
+        SILK_ASSERT(!silk_string_equal_nocase(str1, str2));
+        SILK_ASSERT(silk_string_compare_nocase(str1, str2) > 0);
+        SILK_ASSERT(silk_string_compare_nocase(str2, str1) < 0);
+
+        SILK_ASSERT(silk_string_set(str2, "ABCDEFGHIJKLMNOPQRSTUVWXYZ!"));
+        SILK_ASSERT(!silk_string_equal_nocase(str1, str2));
+        SILK_ASSERT(silk_string_compare_nocase(str1, str2) < 0);
+
+        silk_string_clear(str1);
+        silk_string_clear(str2);
+        SILK_ASSERT(silk_string_equal_nocase(str1, str2));
+        SILK_ASSERT(silk_string_compare_nocase(str1, str2) == 0);
+
+        silk_string_delete(str1);
+        silk_string_delete(str2);
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_string_resize()
+{
+    silk_string_t str = silk_string_new("hello");
+    SILK_ASSERT(silk_string_resize(str, 3));
+    SILK_ASSERT(strcmp(silk_string_get(str), "hel") == 0);
+
+    SILK_ASSERT(silk_string_resize(str, 5));
+    SILK_ASSERT(silk_string_length(str) == 5);
+    silk_string_data(str)[3] = 'p';
+    silk_string_data(str)[4] = '!';
+    SILK_ASSERT(strcmp(silk_string_get(str), "help!") == 0);
+
+    SILK_ASSERT(silk_string_resize(str, 0));
+    SILK_ASSERT(strcmp(silk_string_get(str), "") == 0);
+    silk_string_delete(str);
+}
+
+void test_string_replace_all()
+{
+    // occurrences are not overlapped
+    silk_string_t str = silk_string_new("a-b--c---d");
+    SILK_ASSERT(silk_string_replace_all(str, "--", "+") == 2);
+    SILK_ASSERT(strcmp(silk_string_get(str), "a-b+c+-d") == 0);
+    SILK_ASSERT(silk_string_length(str) == 8);
+
+    SILK_ASSERT(silk_string_replace_all(str, "-", "<->") == 2);
+    SILK_ASSERT(strcmp(silk_string_get(str), "a<->b+c+<->d") == 0);
+
+    SILK_ASSERT(silk_string_replace_all(str, "<->", "") == 2);
+    SILK_ASSERT(strcmp(silk_string_get(str), "ab+c+d") == 0);
+
+    SILK_ASSERT(silk_string_replace_all(str, "xyz", "!") == 0);
+    SILK_ASSERT(strcmp(silk_string_get(str), "ab+c+d") == 0);
+
+    // the result is not searched again
+    SILK_ASSERT(silk_string_replace_all(str, "+", "++") == 2);
+    SILK_ASSERT(strcmp(silk_string_get(str), "ab++c++d") == 0);
+
+    uint32_t hash = silk_string_hash(str);
+    SILK_ASSERT(silk_string_replace_all(str, "ab++c++d", "") == 1);
+    SILK_ASSERT(silk_string_length(str) == 0);
+    SILK_ASSERT(silk_string_hash(str) != hash);
+    silk_string_delete(str);
+}
+
+void test_string_edit()
+{
+    silk_string_t str = silk_string_new("hello world, hello silk");
+    const silk_string_edit_t edits[] = {
+        {0, 5, "HELLO", 5},         // replace
+        {6, 0, "big ", 4},          // insert
+        {11, 1, NULL, 0},           // remove ','
+        {13, 5, "bye", 3},
+        {23, 0, "!", 1},            // append
+    };
+    SILK_ASSERT(silk_string_edit(str, edits, sizeof(edits) / sizeof(edits[0])));
+    SILK_ASSERT(strcmp(silk_string_get(str), "HELLO big world bye silk!") == 0);
+    SILK_ASSERT(silk_string_length(str) == 25);
+
+    SILK_ASSERT(silk_string_edit(str, NULL, 0));
+    SILK_ASSERT(strcmp(silk_string_get(str), "HELLO big world bye silk!") == 0);
+    silk_string_delete(str);
+}
+
 void test_string()
 {
     test_string_new();
     test_string_sub();
     test_string_copy();
+    test_string_equal();
+    test_string_hash();
     test_string_clear();
     test_string_set();
     test_string_insert();
     test_string_inserts();
     test_string_append();
     test_string_appends();
+    test_string_appendn();
+    test_string_appendf();
+    test_string_append_number();
+    test_string_to_number();
+    test_string_utf8();
+    test_string_case();
+    test_string_resize();
+    test_string_replace_all();
+    test_string_edit();
     test_string_remove();
     test_string_removes();
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <silk/log.h>
+#include <silk/cpu.h>
+#include <silk/utf8.h>
+
+#include <string.h>
+
+static const char* silk_test_utf8_valid[] = {
+    "",
+    "hello world",
+    "\xC2\x80",                         // U+0080
+    "\xDF\xBF",                         // U+07FF
+    "\xE0\xA0\x80",                     // U+0800
+    "\xED\x9F\xBF",                     // U+D7FF
+    "\xEE\x80\x80",                     // U+E000
+    "\xEF\xBF\xBF",                     // U+FFFF
+    "\xF0\x90\x80\x80",                 // U+10000
+    "\xF4\x8F\xBF\xBF",                 // U+10FFFF
+    "\xE4\xBD\xA0\xE5\xA5\xBD, \xE4\xB8\x96\xE7\x95\x8C",
+};
+
+static const char* silk_test_utf8_invalid[] = {
+    "\x80",                             // lone continuation
+    "\xBF\x80",
+    "\xC0\x80",                         // overlong
+    "\xC1\xBF",
+    "\xE0\x9F\xBF",
+    "\xF0\x8F\xBF\xBF",
+    "\xED\xA0\x80",                     // surrogate
+    "\xED\xBF\xBF",
+    "\xF4\x90\x80\x80",                 // above U+10FFFF
+    "\xF5\x80\x80\x80",
+    "\xFF",
+    "\xC2",                             // truncated
+    "\xE0\xA0",
+    "\xF0\x90\x80",
+    "\xC2\x41",
+    "\xE0\xA0\x41",
+    "\xC2\x80\x80",                     // too many continuations
+};
+
+/*******************************************************
+ * @brief embed a sequence at every position of a long
+ *        ascii text, to cross the SIMD block boundaries
+ *******************************************************/
+static bool test_utf8_validate_embedded(const char* seq, bool expected)
+{
+    char buffer[128];
+    size_t len = strlen(seq);
+    for (size_t pos = 0; pos + len <= sizeof(buffer); pos++)
+    {
+        memset(buffer, 'a', sizeof(buffer));
+        memcpy(buffer + pos, seq, len);
+        if (silk_utf8_validate(buffer, sizeof(buffer)) != expected)
+            return false;
+        if (silk_utf8_validate(buffer, pos + len) != expected)
+            return false;
+    }
+    return true;
+}
+
+void test_utf8_validate()
+{
+    // scalar, SSSE3 and AVX2 paths
+    const uint32_t features[] = {0, SILK_CPU_SSE2 | SILK_CPU_SSSE3, UINT32_MAX};
+    for (size_t k = 0; k < sizeof(features) / sizeof(features[0]); k++)
+    {
+        uint32_t old = silk_cpu_set_features(features[k]);
+        for (size_t i = 0; i < sizeof(silk_test_utf8_valid) / sizeof(silk_test_utf8_valid[0]); i++)
+        {
+            SILK_ASSERT(silk_utf8_validate(silk_test_utf8_valid[i], strlen(silk_test_utf8_valid[i])));
+            SILK_ASSERT(test_utf8_validate_embedded(silk_test_utf8_valid[i], true));
+        }
+
+        for (size_t i = 0; i < sizeof(silk_test_utf8_invalid) / sizeof(silk_test_utf8_invalid[0]); i++)
+        {
+            SILK_ASSERT(!silk_utf8_validate(silk_test_utf8_invalid[i], strlen(silk_test_utf8_invalid[i])));
+            SILK_ASSERT(test_utf8_validate_embedded(silk_test_utf8_invalid[i], false));
+        }
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_utf8_length()
+{
+    char buffer[1000];
+    for (size_t i = 0; i < sizeof(buffer) / 4; i++)
+    {
+        memcpy(buffer + i * 4, i % 2 ? "\xF0\x90\x80\x80" : "a\xE4\xBD\xA0", 4);
+    }
+
+    const uint32_t features[] = {0, SILK_CPU_SSE2, UINT32_MAX};
+    for (size_t k = 0; k < sizeof(features) / sizeof(features[0]); k++)
+    {
+        uint32_t old = silk_cpu_set_features(features[k]);
+        SILK_ASSERT(silk_utf8_length("", 0) == 0);
+        SILK_ASSERT(silk_utf8_length("hello", 5) == 5);
+        SILK_ASSERT(silk_utf8_length(buffer, sizeof(buffer)) == 375);
+        SILK_ASSERT(silk_utf8_length(buffer, 998) == 375);
+        silk_cpu_set_features(old);
+    }
+}
+
+void test_utf8()
+{
+    test_utf8_validate();
+    test_utf8_length();
+}
\ No newline at end of file
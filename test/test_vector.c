@@ -81,6 +81,21 @@ void test_vector_inserts()
     silk_vector_delete(vector);
 }
 
+void test_vector_reserve()
+{
+    // n elements fit exactly after reserving n
+    silk_vector_t vector = silk_vector_new(sizeof(int));
+    SILK_ASSERT(silk_vector_reserve(vector, N));
+    SILK_ASSERT(silk_vector_capacity(vector) == N);
+    void* data = silk_vector_data(vector);
+    for (int i = 0; i < N; i++)
+        SILK_ASSERT(silk_vector_push_back(vector, &i));
+    SILK_ASSERT(silk_vector_length(vector) == N);
+    SILK_ASSERT(silk_vector_capacity(vector) == N);
+    SILK_ASSERT(silk_vector_data(vector) == data);
+    silk_vector_delete(vector);
+}
+
 void test_vector()
 {
     // create
@@ -112,6 +127,13 @@ void test_vector()
         SILK_ASSERT(n == 233);
     }
 
+    // resize
+    SILK_ASSERT(silk_vector_resize(vector, N / 2));
+    SILK_ASSERT(silk_vector_length(vector) == N / 2);
+    SILK_ASSERT(silk_vector_resize(vector, N * 3));
+    SILK_ASSERT(silk_vector_length(vector) == N * 3);
+    SILK_ASSERT(silk_vector_capacity(vector) >= N * 3);
+
     // insert
     silk_vector_clear(vector);
     silk_vector_reserve(vector, 2*N);
@@ -193,4 +215,5 @@ void test_vector()
     test_vector_map();
     test_vector_reduce();
     test_vector_inserts();
+    test_vector_reserve();
 }
\ No newline at end of file
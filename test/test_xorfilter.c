@@ -0,0 +1,94 @@
+#include <silk/log.h>
+#include <silk/xorfilter.h>
+
+void test_xorfilter_contains()
+{
+    silk_vector_t keys = silk_vector_new(sizeof(uint64_t));
+    SILK_ASSERT(keys != NULL);
+
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        uint64_t key = i * 0x9e3779b97f4a7c15ull;
+        SILK_ASSERT(silk_vector_push_back(keys, &key));
+    }
+
+    silk_xorfilter_t filter = silk_xorfilter_new(keys);
+    SILK_ASSERT(filter != NULL);
+
+    // about 9 bits per key
+    SILK_ASSERT(silk_xorfilter_size(filter) * 8 < 100000 * 10);
+
+    // no false negatives
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        uint64_t key = i * 0x9e3779b97f4a7c15ull;
+        SILK_ASSERT(silk_xorfilter_contains(filter, &key, sizeof(key)));
+    }
+
+    // about 1/256 false positives
+    size_t positives = 0;
+    for (uint64_t i = 100000; i < 300000; i++)
+    {
+        uint64_t key = i * 0x9e3779b97f4a7c15ull;
+        positives += silk_xorfilter_contains(filter, &key, sizeof(key));
+    }
+    SILK_ASSERT(positives < 1000);
+
+    silk_xorfilter_delete(filter);
+    silk_vector_delete(keys);
+}
+
+void test_xorfilter_duplicates()
+{
+    silk_vector_t keys = silk_vector_new(sizeof(uint32_t));
+    SILK_ASSERT(keys != NULL);
+
+    // every key 3 times
+    for (uint32_t n = 0; n < 3; n++)
+    {
+        for (uint32_t i = 0; i < 5000; i++)
+            SILK_ASSERT(silk_vector_push_back(keys, &i));
+    }
+
+    silk_xorfilter_t filter = silk_xorfilter_new(keys);
+    SILK_ASSERT(filter != NULL);
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        SILK_ASSERT(silk_xorfilter_contains(filter, &i, sizeof(i)));
+    }
+    silk_xorfilter_delete(filter);
+    silk_vector_delete(keys);
+}
+
+void test_xorfilter_small()
+{
+    silk_vector_t keys = silk_vector_new(sizeof(uint32_t));
+    SILK_ASSERT(keys != NULL);
+
+    // empty set
+    silk_xorfilter_t filter = silk_xorfilter_new(keys);
+    SILK_ASSERT(filter != NULL);
+    silk_xorfilter_delete(filter);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        SILK_ASSERT(silk_vector_push_back(keys, &i));
+
+        filter = silk_xorfilter_new(keys);
+        SILK_ASSERT(filter != NULL);
+        for (uint32_t j = 0; j <= i; j++)
+        {
+            SILK_ASSERT(silk_xorfilter_contains(filter, &j, sizeof(j)));
+        }
+        silk_xorfilter_delete(filter);
+    }
+
+    silk_vector_delete(keys);
+}
+
+void test_xorfilter()
+{
+    test_xorfilter_contains();
+    test_xorfilter_duplicates();
+    test_xorfilter_small();
+}
\ No newline at end of file